@@ -0,0 +1,167 @@
+#include "Bench.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> g_allocCount{0};
+std::atomic<uint64_t> g_allocBytes{0};
+
+void *CountedAlloc(std::size_t size) {
+  g_allocCount.fetch_add(1, std::memory_order_relaxed);
+  g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+
+void *CountedAlignedAlloc(std::size_t size, std::align_val_t align) {
+  g_allocCount.fetch_add(1, std::memory_order_relaxed);
+  g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+  auto alignment = static_cast<std::size_t>(align);
+#if defined(_MSC_VER)
+  return _aligned_malloc(size ? size : 1, alignment);
+#else
+  std::size_t rounded = (std::max<std::size_t>(size, 1) + alignment - 1) /
+                        alignment * alignment;
+  return std::aligned_alloc(alignment, rounded);
+#endif
+}
+
+void AlignedFree(void *ptr) {
+#if defined(_MSC_VER)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+std::vector<std::pair<std::string, bench::GroupFn>> &Registry() {
+  static std::vector<std::pair<std::string, bench::GroupFn>> groups;
+  return groups;
+}
+
+} // namespace
+
+// ===== ALLOCATION COUNTING =====
+// The array, nothrow and sized forms forward to these by default.
+
+void *operator new(std::size_t size) {
+  if (void *ptr = CountedAlloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  if (void *ptr = CountedAlignedAlloc(size, align)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// GCC flags free() on memory from (replaced) operator new once inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  AlignedFree(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace bench {
+
+AllocationCount Allocations() {
+  return {g_allocCount.load(std::memory_order_relaxed),
+          g_allocBytes.load(std::memory_order_relaxed)};
+}
+
+// ===== RUNNER =====
+
+bool Runner::enabled(const std::string &name) const {
+  return m_options.filter.empty() ||
+         name.find(m_options.filter) != std::string::npos;
+}
+
+void Runner::measure(const std::string &name, size_t opsPerCall,
+                     const std::function<void()> &body) {
+  using Clock = std::chrono::steady_clock;
+  if (!enabled(name) || opsPerCall == 0) {
+    return;
+  }
+
+  int samples = std::max(1, m_options.samples);
+  double sampleNs = m_options.minTimeMs * 1e6 / samples;
+
+  // Warm up, then grow the call count until one sample is long enough
+  body();
+  size_t calls = 1;
+  for (;;) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      body();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                    .count();
+    if (ns >= sampleNs || calls >= (size_t{1} << 30)) {
+      break;
+    }
+    calls = ns > 0 ? std::max(calls * 2, static_cast<size_t>(
+                                             calls * sampleNs / ns * 1.1))
+                   : calls * 10;
+  }
+
+  std::vector<double> perOp(samples);
+  AllocationCount before = Allocations();
+  for (int s = 0; s < samples; ++s) {
+    auto start = Clock::now();
+    for (size_t i = 0; i < calls; ++i) {
+      body();
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start)
+                    .count();
+    perOp[s] = ns / static_cast<double>(calls * opsPerCall);
+  }
+  AllocationCount after = Allocations();
+
+  Result result;
+  result.name = name;
+  result.ops = static_cast<uint64_t>(calls) * opsPerCall * samples;
+  std::sort(perOp.begin(), perOp.end());
+  result.nsPerOp = perOp[perOp.size() / 2];
+  result.minNsPerOp = perOp.front();
+  result.allocsPerOp = static_cast<double>(after.count - before.count) /
+                       static_cast<double>(result.ops);
+  result.bytesPerOp = static_cast<double>(after.bytes - before.bytes) /
+                      static_cast<double>(result.ops);
+  m_results.push_back(result);
+}
+
+// ===== REGISTRY =====
+
+Registration::Registration(const char *group, GroupFn fn) {
+  Registry().emplace_back(group, fn);
+}
+
+std::vector<std::pair<std::string, GroupFn>> Groups() {
+  auto groups = Registry();
+  std::sort(groups.begin(), groups.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+  return groups;
+}
+
+} // namespace bench
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal benchmark harness for magic_hands_bench.
+// Each bench/*.cpp registers a group with a static bench::Registration;
+// groups call Runner::measure once per case. The executable replaces global
+// operator new, so every case also reports heap allocations per op.
+
+namespace bench {
+
+/// @brief Heap allocations since process start (this executable only)
+struct AllocationCount {
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+/// @brief Current allocation totals (all threads)
+AllocationCount Allocations();
+
+/// @brief Keep the optimizer from discarding a computed value
+template <typename T> inline void DoNotOptimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+/// @brief Timing and allocation results for one case
+struct Result {
+  std::string name;
+
+  /// Operations timed across all samples
+  uint64_t ops = 0;
+
+  /// Median nanoseconds per operation over the samples
+  double nsPerOp = 0.0;
+
+  /// Fastest sample, nanoseconds per operation
+  double minNsPerOp = 0.0;
+
+  double allocsPerOp = 0.0;
+  double bytesPerOp = 0.0;
+};
+
+/// @brief Runner settings
+struct Options {
+  /// Only run cases whose name contains this substring
+  std::string filter;
+
+  /// Target wall time per case, split across samples
+  double minTimeMs = 200.0;
+
+  int samples = 5;
+};
+
+/// @brief Times cases and collects results
+class Runner {
+public:
+  explicit Runner(Options options) : m_options(std::move(options)) {}
+
+  /// @brief Time a case
+  /// @param name Case name ("Group/Case/variant")
+  /// @param opsPerCall Operations performed by one call of body
+  /// @param body Runs opsPerCall operations; called repeatedly
+  void measure(const std::string &name, size_t opsPerCall,
+               const std::function<void()> &body);
+
+  /// @brief True if a case would run under the current filter
+  bool enabled(const std::string &name) const;
+
+  const std::vector<Result> &results() const { return m_results; }
+
+private:
+  Options m_options;
+  std::vector<Result> m_results;
+};
+
+/// @brief A group of cases (one per bench/*.cpp)
+using GroupFn = void (*)(Runner &runner);
+
+/// @brief Registers a group at static-initialization time
+struct Registration {
+  Registration(const char *group, GroupFn fn);
+};
+
+/// @brief Registered groups, sorted by name
+std::vector<std::pair<std::string, GroupFn>> Groups();
+
+} // namespace bench
@@ -0,0 +1,169 @@
+// Particle simulation hot path, headless: the per-frame update of large
+// emitters, against a reference of the previous array-of-structs layout,
+// and the cost of large bursts.
+
+#include "Bench.h"
+#include "core/ParallelFor.h"
+#include "graphics/ParticlePool.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kParticleCount = 100000;
+constexpr float kFrameDt = 1.0f / 60.0f;
+constexpr uint64_t kSeed = 20240101;
+
+/// Old ParticleSystem layout: one ~100 byte struct per slot, with an
+/// active flag checked by every update
+struct AosParticle {
+  float x, y;
+  float vx, vy;
+  float life;
+  float maxLife;
+  float size;
+  float startSize, endSize;
+  float r, g, b, a;
+  float startR, startG, startB, startA;
+  float endR, endG, endB, endA;
+  float rotation;
+  float rotationSpeed;
+  bool active;
+};
+
+float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+void UpdateAos(std::vector<AosParticle> &particles,
+               const EmitterConfig &config, float dt) {
+  for (AosParticle &p : particles) {
+    if (!p.active) {
+      continue;
+    }
+    p.vx += config.gravityX * dt;
+    p.vy += config.gravityY * dt;
+    p.x += p.vx * dt;
+    p.y += p.vy * dt;
+    p.life -= dt;
+    if (p.life <= 0) {
+      p.active = false;
+      continue;
+    }
+    float progress = 1.0f - (p.life / p.maxLife);
+    p.size = Lerp(p.startSize, p.endSize, progress);
+    if (config.colorInterpolation) {
+      p.r = Lerp(p.startR, p.endR, progress);
+      p.g = Lerp(p.startG, p.endG, progress);
+      p.b = Lerp(p.startB, p.endB, progress);
+      p.a = Lerp(p.startA, p.endA, progress);
+    }
+    p.rotation += p.rotationSpeed * dt;
+  }
+}
+
+EmitterConfig ScoreBurstConfig() {
+  EmitterConfig config;
+  config.spread = 360.0f;
+  config.gravityY = 200.0f;
+  config.startSize = 6.0f;
+  config.endSize = 1.0f;
+  config.endR = 1.0f;
+  config.endG = 0.5f;
+  config.endB = 0.0f;
+  return config;
+}
+
+void RunParticles(bench::Runner &runner) {
+  ParticleRng rng(kSeed);
+
+  // Same live particles for both layouts, living through the run. Pools
+  // are sized for bursts, so the old layout also walked dead slots; here
+  // every other slot is inactive.
+  EmitterConfig immortal = ScoreBurstConfig();
+  immortal.minLife = immortal.maxLife = 1.0e9f;
+
+  std::vector<AosParticle> aos(kParticleCount * 2);
+  for (size_t i = 0; i < aos.size(); ++i) {
+    AosParticle &p = aos[i];
+    p = {};
+    p.life = p.maxLife = immortal.maxLife;
+    p.startSize = immortal.startSize;
+    p.endSize = immortal.endSize;
+    p.startA = p.a = 1.0f;
+    p.active = i % 2 == 0;
+  }
+  runner.measure("Particles/aos_reference/100000_of_200000", kParticleCount,
+                 [&] { UpdateAos(aos, immortal, kFrameDt); });
+
+  ParticlePool pool(kParticleCount);
+  pool.emit(immortal, kParticleCount, rng);
+  runner.measure("Particles/update/100000", kParticleCount,
+                 [&] { pool.update(immortal, kFrameDt); });
+
+  // Steady state: 1-2 s lifetimes, refilled every frame
+  EmitterConfig config = ScoreBurstConfig();
+  ParticlePool steady(kParticleCount);
+  steady.emit(config, kParticleCount, rng);
+  runner.measure("Particles/update_steady/100000", kParticleCount, [&] {
+    steady.update(config, kFrameDt);
+    steady.emit(config, steady.capacity() - steady.size(), rng);
+  });
+
+  // The same particle count spread over many small effects
+  std::vector<ParticlePool> pools(100, ParticlePool(kParticleCount / 100));
+  for (ParticlePool &small : pools) {
+    small.emit(config, small.capacity(), rng);
+  }
+  runner.measure("Particles/update_steady/100x1000", kParticleCount, [&] {
+    for (ParticlePool &small : pools) {
+      small.update(config, kFrameDt);
+      small.emit(config, small.capacity() - small.size(), rng);
+    }
+  });
+
+  // As ParticleSystem::Update: every pool advanced in chunks across all
+  // hardware threads, then per-pool removal and refill
+  constexpr int kChunkSize = 4096;
+  std::vector<ParticlePool> scene(100, ParticlePool(kParticleCount / 100));
+  scene.front() = ParticlePool(kParticleCount); // One large effect
+  struct Chunk {
+    ParticlePool *pool;
+    int begin, end;
+  };
+  std::vector<Chunk> chunks;
+  for (ParticlePool &effect : scene) {
+    effect.emit(config, effect.capacity(), rng);
+  }
+  runner.measure("Particles/update_parallel/200000", 2 * kParticleCount, [&] {
+    chunks.clear();
+    for (ParticlePool &effect : scene) {
+      for (int begin = 0; begin < effect.size(); begin += kChunkSize) {
+        chunks.push_back(
+            {&effect, begin, std::min(begin + kChunkSize, effect.size())});
+      }
+    }
+    ParallelFor(chunks.size(), 0, 1, [&](int, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        chunks[i].pool->advance(config, kFrameDt, chunks[i].begin,
+                                chunks[i].end);
+      }
+    });
+    for (ParticlePool &effect : scene) {
+      effect.removeExpired();
+      effect.emit(config, effect.capacity() - effect.size(), rng);
+    }
+  });
+
+  // Score-event bursts into an empty pool; reported per particle
+  for (int count : {500, 5000, 50000}) {
+    ParticlePool burst(count);
+    runner.measure("Particles/burst/" + std::to_string(count), count, [&] {
+      burst.clear();
+      bench::DoNotOptimize(burst.emit(config, count, rng));
+    });
+  }
+}
+
+bench::Registration registration("particles", &RunParticles);
+
+} // namespace
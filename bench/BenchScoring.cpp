@@ -0,0 +1,198 @@
+// Cribbage and joker scoring hot path: hand evaluation, base scoring,
+// joker application and joker/condition parsing.
+
+#include "Bench.h"
+#include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/CompiledRuleSet.h"
+#include "gameplay/cribbage/HandEvaluator.h"
+#include "gameplay/cribbage/ScoreTable.h"
+#include "gameplay/cribbage/ScoringEngine.h"
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include "gameplay/joker/Joker.h"
+#include "gameplay/joker/JokerEffectSystem.h"
+#include "gameplay/joker/JokerProgram.h"
+#include "gameplay/joker/conditions/Condition.h"
+#include <array>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace gameplay;
+
+namespace {
+
+constexpr size_t kHandCount = 1024;
+constexpr uint64_t kCorpusSeed = 20240101;
+
+/// Fixed joker corpus (copies of shipped definitions, so content edits do
+/// not move the numbers): plain, per-count, condition-gated and tiered
+const std::array<const char *, 5> kJokerJSON = {
+    R"({"id": "big_hand", "name": "Big Hand", "rarity": "common",
+        "triggers": ["on_score"], "conditions": [],
+        "effects": [{"type": "add_chips", "value": 20,
+                     "per": "card_count"}]})",
+    R"({"id": "fifteen_fever", "name": "Fifteen Fever", "rarity": "common",
+        "triggers": ["on_score"], "conditions": ["count_15s > 0"],
+        "effects": [{"type": "add_multiplier", "value": 0.2,
+                     "per": "each_15"}],
+        "caps": {"per_hand": 2.0}})",
+    R"({"id": "ace_in_hole", "name": "Ace in the Hole",
+        "rarity": "uncommon", "triggers": ["on_score"],
+        "conditions": ["contains_rank:Ace"],
+        "effects": [{"type": "add_chips", "value": 80, "per": ""}]})",
+    R"({"id": "combo_king", "name": "Combo King", "rarity": "rare",
+        "triggers": ["on_score"], "conditions": ["unique_categories >= 3"],
+        "effects": [{"type": "add_chips", "value": 100, "per": ""}]})",
+    R"({"id": "even_stevens_tiered", "name": "Even Stevens",
+        "rarity": "common", "stackable": true, "triggers": ["on_score"],
+        "conditions": [],
+        "tiers": [
+          {"level": 1, "effects": [{"type": "add_chips", "value": 15,
+                                    "per": "each_even"}]},
+          {"level": 2, "effects": [{"type": "add_chips", "value": 25,
+                                    "per": "each_even"}]},
+          {"level": 3, "effects": [{"type": "add_chips", "value": 35,
+                                    "per": "each_even"},
+                                   {"type": "add_multiplier", "value": 1,
+                                    "per": "each_even"}]}]})",
+};
+
+/// One string per condition form the parser understands
+const std::vector<std::string> kConditions = {
+    "contains_rank:7",      "contains_rank:Ace",  "contains_suit:H",
+    "count_15s > 0",        "count_pairs >= 2",   "count_runs > 0",
+    "flush_count == 5",     "unique_categories >= 3",
+    "has_nobs",             "hand_total_21"};
+
+struct Corpus {
+  std::vector<std::vector<Card>> hands;
+  std::vector<Card> cuts;
+  std::vector<HandEvaluator::HandResult> evaluated;
+};
+
+Corpus BuildCorpus() {
+  Corpus corpus;
+  Deck deck(kCorpusSeed);
+  for (size_t i = 0; i < kHandCount; ++i) {
+    deck.reset();
+    deck.shuffle();
+    corpus.hands.push_back(deck.drawMultiple(4));
+    corpus.cuts.push_back(deck.draw());
+    corpus.evaluated.push_back(
+        HandEvaluator::Evaluate(corpus.hands.back(), corpus.cuts.back()));
+  }
+  return corpus;
+}
+
+void RunScoring(bench::Runner &runner) {
+  EffectFactory::registerBuiltInEffects();
+  const Corpus corpus = BuildCorpus();
+
+  runner.measure("HandEvaluator::Evaluate", kHandCount, [&] {
+    for (size_t i = 0; i < kHandCount; ++i) {
+      bench::DoNotOptimize(
+          HandEvaluator::Evaluate(corpus.hands[i], corpus.cuts[i]));
+    }
+  });
+
+  runner.measure("ScoreTable::Lookup", kHandCount, [&] {
+    for (size_t i = 0; i < kHandCount; ++i) {
+      bench::DoNotOptimize(
+          ScoreTable::Lookup(corpus.hands[i], corpus.cuts[i]));
+    }
+  });
+
+  // Base scoring with no rules, rules given as strings, and pre-compiled
+  const std::vector<std::string> noRules;
+  const std::vector<std::string> ruleNames = {"flush_disabled",
+                                              "warp_mirror"};
+  const CompiledRuleSet compiled(ruleNames);
+
+  runner.measure("ScoringEngine::CalculateScore/no_rules", kHandCount, [&] {
+    for (size_t i = 0; i < kHandCount; ++i) {
+      bench::DoNotOptimize(ScoringEngine::CalculateScore(
+          corpus.hands[i], corpus.cuts[i], 1.0f, 0.5f, noRules));
+    }
+  });
+
+  runner.measure("ScoringEngine::CalculateScore/string_rules", kHandCount,
+                 [&] {
+                   for (size_t i = 0; i < kHandCount; ++i) {
+                     bench::DoNotOptimize(ScoringEngine::CalculateScore(
+                         corpus.hands[i], corpus.cuts[i], 1.0f, 0.5f,
+                         ruleNames));
+                   }
+                 });
+
+  runner.measure("ScoringEngine::CalculateScore/compiled_rules", kHandCount,
+                 [&] {
+                   for (size_t i = 0; i < kHandCount; ++i) {
+                     bench::DoNotOptimize(ScoringEngine::CalculateScore(
+                         corpus.hands[i], corpus.cuts[i], 1.0f, 0.5f,
+                         compiled));
+                   }
+                 });
+
+  runner.measure("ScoringEngine::CalculateScore/hand_result", kHandCount,
+                 [&] {
+                   for (size_t i = 0; i < kHandCount; ++i) {
+                     bench::DoNotOptimize(ScoringEngine::CalculateScore(
+                         corpus.evaluated[i], 1.0f, 0.5f, noRules));
+                   }
+                 });
+
+  // Joker application: interpreted (parses conditions per hand) and
+  // compiled, with 1-5 jokers at stack 2
+  std::vector<Joker> jokers;
+  std::vector<CompiledJoker> compiledJokers;
+  for (const char *json : kJokerJSON) {
+    jokers.push_back(Joker::FromJSONString(json));
+    compiledJokers.push_back(CompiledJoker::Compile(jokers.back()));
+  }
+
+  uint32_t onScore = CompiledJoker::TriggerMask("on_score");
+  const std::string trigger = "on_score";
+  for (size_t n = 1; n <= jokers.size(); ++n) {
+    std::vector<std::pair<Joker, int>> stacked;
+    std::vector<std::pair<const CompiledJoker *, int>> program;
+    for (size_t j = 0; j < n; ++j) {
+      stacked.emplace_back(jokers[j], 2);
+      program.emplace_back(&compiledJokers[j], 2);
+    }
+
+    std::string suffix = "/" + std::to_string(n) + "_jokers";
+    runner.measure("JokerEffectSystem::ApplyJokersWithStacks" + suffix,
+                   kHandCount, [&] {
+                     for (const auto &hand : corpus.evaluated) {
+                       bench::DoNotOptimize(
+                           JokerEffectSystem::ApplyJokersWithStacks(
+                               stacked, hand, trigger));
+                     }
+                   });
+
+    runner.measure("JokerEffectSystem::ApplyCompiled" + suffix, kHandCount,
+                   [&] {
+                     for (const auto &hand : corpus.evaluated) {
+                       bench::DoNotOptimize(JokerEffectSystem::ApplyCompiled(
+                           program, HandFacts::From(hand), onScore));
+                     }
+                   });
+  }
+
+  // Parsing (load time, but also hit per hand by the interpreted path)
+  runner.measure("Condition::parse", kConditions.size(), [&] {
+    for (const auto &condition : kConditions) {
+      bench::DoNotOptimize(Condition::parse(condition));
+    }
+  });
+
+  runner.measure("Joker::FromJSONString", kJokerJSON.size(), [&] {
+    for (const char *json : kJokerJSON) {
+      bench::DoNotOptimize(Joker::FromJSONString(json));
+    }
+  });
+}
+
+bench::Registration registration("scoring", &RunScoring);
+
+} // namespace
@@ -0,0 +1,170 @@
+// Spatial index hot path: moving objects (update every frame, or a full
+// rebuild) and the area, radius and nearest queries gameplay scripts run
+// against them. The backends are also compared at rising object density.
+
+#include "Bench.h"
+#include "core/SpatialIndex.h"
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr float kWorldSize = 4096.0f;
+constexpr float kObjectSize = 8.0f;
+constexpr int kMaxObjects = 10;
+constexpr int kMaxLevels = 8;
+constexpr float kCellSize = 32.0f;
+constexpr size_t kDensityCount = 10000;
+constexpr size_t kQueryCount = 256;
+constexpr uint64_t kSeed = 20240101;
+
+/// Objects drifting around the world, bouncing off its edges. Positions
+/// are also kept as arrays for SpatialHashGrid::rebuild.
+struct Swarm {
+  float worldSize;
+  std::vector<Rect> bounds;
+  std::vector<float> x;
+  std::vector<float> y;
+  std::vector<float> vx;
+  std::vector<float> vy;
+
+  Swarm(size_t count, float worldSize_) : worldSize(worldSize_) {
+    std::mt19937 rng(kSeed);
+    std::uniform_real_distribution<float> pos(0.0f, worldSize - kObjectSize);
+    std::uniform_real_distribution<float> vel(-4.0f, 4.0f);
+    for (size_t i = 0; i < count; ++i) {
+      bounds.emplace_back(pos(rng), pos(rng), kObjectSize, kObjectSize);
+      x.push_back(bounds.back().x);
+      y.push_back(bounds.back().y);
+      vx.push_back(vel(rng));
+      vy.push_back(vel(rng));
+    }
+  }
+
+  void step() {
+    for (size_t i = 0; i < bounds.size(); ++i) {
+      Rect &b = bounds[i];
+      b.x += vx[i];
+      b.y += vy[i];
+      if (b.x < 0.0f || b.x > worldSize - kObjectSize) {
+        vx[i] = -vx[i];
+        b.x += 2.0f * vx[i];
+      }
+      if (b.y < 0.0f || b.y > worldSize - kObjectSize) {
+        vy[i] = -vy[i];
+        b.y += 2.0f * vy[i];
+      }
+      x[i] = b.x;
+      y[i] = b.y;
+    }
+  }
+};
+
+template <typename Index> Index MakeIndex(const Rect &world) {
+  if constexpr (std::is_same_v<Index, SpatialHashGrid>) {
+    return Index(world, kCellSize);
+  } else {
+    return Index(world, kMaxObjects, kMaxLevels);
+  }
+}
+
+template <typename Index>
+void RunIndex(bench::Runner &runner, const std::string &name, size_t count,
+              float worldSize, const std::string &suffix) {
+  const Rect world(0.0f, 0.0f, worldSize, worldSize);
+
+  Swarm swarm(count, worldSize);
+  Index tree = MakeIndex<Index>(world);
+  for (size_t i = 0; i < count; ++i) {
+    tree.insert(static_cast<int>(i), swarm.bounds[i]);
+  }
+
+  std::mt19937 rng(kSeed + 1);
+  std::uniform_real_distribution<float> pos(0.0f, worldSize);
+  std::vector<std::pair<float, float>> centers(kQueryCount);
+  for (auto &center : centers) {
+    center = {pos(rng), pos(rng)};
+  }
+
+  // One frame of movement: every object moves, then is re-indexed
+  runner.measure(name + "/update" + suffix, count, [&] {
+    swarm.step();
+    for (size_t i = 0; i < count; ++i) {
+      tree.update(static_cast<int>(i), swarm.bounds[i]);
+    }
+  });
+
+  std::vector<int> ids(count);
+  for (size_t i = 0; i < count; ++i) {
+    ids[i] = static_cast<int>(i);
+  }
+  runner.measure(name + "/updateBatch" + suffix, count, [&] {
+    swarm.step();
+    tree.updateBatch(ids, swarm.bounds);
+  });
+
+  std::vector<int> results;
+  runner.measure(name + "/query_128" + suffix, kQueryCount, [&] {
+    for (const auto &[x, y] : centers) {
+      tree.query(Rect(x - 64.0f, y - 64.0f, 128.0f, 128.0f), results);
+      bench::DoNotOptimize(results.data());
+    }
+  });
+
+  runner.measure(name + "/queryRadius_64" + suffix, kQueryCount, [&] {
+    for (const auto &[x, y] : centers) {
+      tree.queryRadius(x, y, 64.0f, results);
+      bench::DoNotOptimize(results.data());
+    }
+  });
+
+  runner.measure(name + "/queryNearest_128" + suffix, kQueryCount, [&] {
+    for (const auto &[x, y] : centers) {
+      bench::DoNotOptimize(tree.queryNearest(x, y, 128.0f));
+    }
+  });
+
+  // Re-index everything from scratch (trees have no bulk path)
+  const std::vector<float> sizes(count, kObjectSize);
+  runner.measure(name + "/rebuild" + suffix, count, [&] {
+    swarm.step();
+    if constexpr (std::is_same_v<Index, SpatialHashGrid>) {
+      tree.rebuild(count, swarm.x.data(), swarm.y.data(), sizes.data(),
+                   sizes.data());
+    } else {
+      tree.clear();
+      for (size_t i = 0; i < count; ++i) {
+        tree.insert(static_cast<int>(i), swarm.bounds[i]);
+      }
+    }
+  });
+}
+
+void RunSpatial(bench::Runner &runner) {
+  for (size_t count : {size_t{10000}, size_t{100000}}) {
+    const std::string suffix = "/" + std::to_string(count);
+    RunIndex<Quadtree>(runner, "Quadtree", count, kWorldSize, suffix);
+    RunIndex<PooledQuadtree>(runner, "PooledQuadtree", count, kWorldSize,
+                             suffix);
+    RunIndex<SpatialHashGrid>(runner, "SpatialHashGrid", count, kWorldSize,
+                              suffix);
+  }
+
+  // Same object count packed into smaller worlds: about 0.6, 10 and 150
+  // objects per 128x128 query area
+  for (float worldSize : {16384.0f, 4096.0f, 1024.0f}) {
+    const std::string suffix = "/" + std::to_string(kDensityCount) +
+                               "/world_" +
+                               std::to_string(static_cast<int>(worldSize));
+    RunIndex<PooledQuadtree>(runner, "PooledQuadtree", kDensityCount,
+                             worldSize, suffix);
+    RunIndex<SpatialHashGrid>(runner, "SpatialHashGrid", kDensityCount,
+                              worldSize, suffix);
+  }
+}
+
+bench::Registration registration("spatial", &RunSpatial);
+
+} // namespace
@@ -0,0 +1,138 @@
+// Sprite vertex generation and upload, headless: SpriteBatch writing into a
+// stub of the GPU transfer buffer, against staging in a vector and copying.
+
+#include "Bench.h"
+#include "graphics/SpriteBatch.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kSpriteCount = 10000;
+constexpr int kCapacity = kSpriteCount * SpriteBatch::kVerticesPerSprite;
+constexpr uint64_t kSeed = 20240101;
+
+/// Stands in for the GPU device's transfer buffer. Cycling moves on to the
+/// next of a few copies, as the driver does while earlier frames are still
+/// in flight.
+class StubTransferBuffer : public SpriteBatch::UploadBuffer {
+public:
+  static constexpr int kFramesInFlight = 3;
+
+  explicit StubTransferBuffer(int capacity) {
+    for (auto &memory : m_Memory) {
+      memory.resize(static_cast<size_t>(capacity));
+    }
+  }
+
+  Vertex *map(bool cycle) override {
+    if (cycle) {
+      m_Current = (m_Current + 1) % kFramesInFlight;
+    }
+    return m_Memory[m_Current].data();
+  }
+  void unmap() override {}
+
+private:
+  std::vector<Vertex> m_Memory[kFramesInFlight];
+  int m_Current = 0;
+};
+
+/// Plain heap memory, for the staged reference
+class StagingBuffer : public SpriteBatch::UploadBuffer {
+public:
+  explicit StagingBuffer(int capacity) : m_Memory(capacity) {}
+  Vertex *map(bool) override { return m_Memory.data(); }
+  void unmap() override {}
+
+private:
+  std::vector<Vertex> m_Memory;
+};
+
+/// A Y-sorted world: a few textures, some rotated sprites
+std::vector<SpriteCommand> MakeCommands(int count, bool screenSpace) {
+  std::mt19937 rng(kSeed);
+  std::uniform_real_distribution<float> position(0.0f, 2000.0f);
+  std::vector<SpriteCommand> commands(static_cast<size_t>(count));
+  for (SpriteCommand &cmd : commands) {
+    cmd.textureId = 1 + static_cast<int>(rng() % 4);
+    cmd.x = position(rng);
+    cmd.y = position(rng);
+    cmd.w = cmd.h = 32.0f;
+    cmd.sx = cmd.sy = 0.0f;
+    cmd.sw = cmd.sh = 1.0f;
+    cmd.rotation = rng() % 4 == 0 ? 0.5f : 0.0f;
+    cmd.flipX = rng() % 2 == 0;
+    cmd.flipY = false;
+    cmd.screenSpace = screenSpace;
+    cmd.tint = Color(1.0f, 1.0f, 1.0f, 1.0f);
+    cmd.zIndex = 0;
+    cmd.sortY = cmd.y + cmd.h;
+  }
+  return commands;
+}
+
+SpriteBatch::View MakeView() {
+  SpriteBatch::View view;
+  view.cameraX = 300.0f;
+  view.cameraY = 200.0f;
+  view.zoom = 2.0f;
+  view.viewportWidth = 640.0f;
+  view.viewportHeight = 360.0f;
+  view.windowWidth = 1280.0f;
+  view.windowHeight = 720.0f;
+  return view;
+}
+
+void Generate(SpriteBatch &batch, const std::vector<SpriteCommand> &commands,
+              const SpriteBatch::View &view) {
+  batch.beginSegment(static_cast<int>(commands.size()), view);
+  for (const SpriteCommand &cmd : commands) {
+    batch.add(cmd);
+  }
+  batch.endSegment();
+}
+
+void RunSprites(bench::Runner &runner) {
+  const SpriteBatch::View view = MakeView();
+  const std::vector<SpriteCommand> world = MakeCommands(kSpriteCount, false);
+
+  // Previous path: build the frame's vertices in memory, then copy them
+  // into the mapped transfer buffer
+  StagingBuffer staging(kCapacity);
+  StubTransferBuffer stagedDevice(kCapacity);
+  SpriteBatch staged(staging, kCapacity);
+  runner.measure("Sprites/staged_copy/10000", kSpriteCount, [&] {
+    staged.beginFrame();
+    Generate(staged, world, view);
+    Vertex *mapped = stagedDevice.map(true);
+    std::memcpy(mapped, staging.map(false),
+                staged.segmentSize() * sizeof(Vertex));
+    stagedDevice.unmap();
+    bench::DoNotOptimize(mapped[0]);
+  });
+
+  StubTransferBuffer device(kCapacity);
+  SpriteBatch direct(device, kCapacity);
+  runner.measure("Sprites/direct/10000", kSpriteCount, [&] {
+    direct.beginFrame();
+    Generate(direct, world, view);
+    bench::DoNotOptimize(direct.batches());
+  });
+
+  // A full frame: world at Flush, then UI appended at EndFrame
+  const std::vector<SpriteCommand> scene =
+      MakeCommands(kSpriteCount * 9 / 10, false);
+  const std::vector<SpriteCommand> ui = MakeCommands(kSpriteCount / 10, true);
+  runner.measure("Sprites/direct_frame/9000+1000", kSpriteCount, [&] {
+    direct.beginFrame();
+    Generate(direct, scene, view);
+    Generate(direct, ui, view);
+    bench::DoNotOptimize(direct.batches());
+  });
+}
+
+bench::Registration registration("sprites", &RunSprites);
+
+} // namespace
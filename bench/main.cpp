@@ -0,0 +1,96 @@
+// Microbenchmarks for engine and gameplay hot paths.
+//
+// Usage:
+//   magic_hands_bench [--filter=SUBSTR] [--min-time=MS] [--samples=N]
+//                     [--json=FILE] [--list]
+
+#include "Bench.h"
+#include "core/Logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+namespace {
+
+void PrintUsage() {
+  std::printf(
+      "Usage: magic_hands_bench [options]\n"
+      "  --filter=SUBSTR   Only run cases whose name contains SUBSTR\n"
+      "  --min-time=MS     Target time per case (default 200)\n"
+      "  --samples=N       Timed samples per case (default 5)\n"
+      "  --json=FILE       Write results as JSON\n"
+      "  --list            List benchmark groups and exit\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  bench::Options options;
+  std::string jsonFile;
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--filter=", 9) == 0) {
+      options.filter = argv[i] + 9;
+    } else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+      options.minTimeMs = atof(argv[i] + 11);
+    } else if (strncmp(argv[i], "--samples=", 10) == 0) {
+      options.samples = atoi(argv[i] + 10);
+    } else if (strncmp(argv[i], "--json=", 7) == 0) {
+      jsonFile = argv[i] + 7;
+    } else if (strcmp(argv[i], "--list") == 0) {
+      list = true;
+    } else {
+      PrintUsage();
+      return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  Logger::Init(LogLevel::Warn);
+
+  auto groups = bench::Groups();
+  if (list) {
+    for (const auto &[name, fn] : groups) {
+      std::printf("%s\n", name.c_str());
+    }
+    return 0;
+  }
+
+  bench::Runner runner(options);
+  std::printf("%-56s %12s %10s %10s\n", "benchmark", "ns/op", "allocs/op",
+              "bytes/op");
+  size_t printed = 0;
+  for (const auto &[name, fn] : groups) {
+    fn(runner);
+    for (; printed < runner.results().size(); ++printed) {
+      const bench::Result &r = runner.results()[printed];
+      std::printf("%-56s %12.1f %10.2f %10.1f\n", r.name.c_str(), r.nsPerOp,
+                  r.allocsPerOp, r.bytesPerOp);
+    }
+  }
+
+  if (!jsonFile.empty()) {
+    nlohmann::json cases = nlohmann::json::array();
+    for (const bench::Result &r : runner.results()) {
+      cases.push_back({{"name", r.name},
+                       {"ops", r.ops},
+                       {"nsPerOp", r.nsPerOp},
+                       {"minNsPerOp", r.minNsPerOp},
+                       {"allocsPerOp", r.allocsPerOp},
+                       {"bytesPerOp", r.bytesPerOp}});
+    }
+    nlohmann::json out = {{"minTimeMs", options.minTimeMs},
+                          {"samples", options.samples},
+                          {"benchmarks", cases}};
+    std::ofstream file(jsonFile);
+    if (!file) {
+      LOG_ERROR("Cannot write %s", jsonFile.c_str());
+      return 1;
+    }
+    file << out.dump(2);
+  }
+  return 0;
+}
@@ -177,6 +177,21 @@ AutoPlayStrategies.Optimal = {
             return AutoPlayStrategies.Random:selectCardsForCrib(hand)
         end
         
+        -- Native expected-value solver: scores each of the 15 discards
+        -- against every possible cut with the active boss rules
+        if #hand == 6 and cribbage.bestDiscard then
+            local engineCards = {}
+            for _, c in ipairs(hand) do
+                table.insert(engineCards, type(c) == "userdata" and c or Card.new(c.rank, c.suit))
+            end
+            
+            local ok, BossManager = pcall(require, "criblage/BossManager")
+            local bossRules = (ok and BossManager and BossManager:getEffects()) or {}
+            
+            local results = cribbage.bestDiscard(engineCards, { bossRules = bossRules })
+            return { results[1].discard[1], results[1].discard[2] }
+        end
+        
         -- Try all 15 combinations of 2 cards to discard from 6
         -- C(6,2) = 15 combinations - very fast
         local bestScore = -999
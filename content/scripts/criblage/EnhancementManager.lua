@@ -5,7 +5,8 @@ EnhancementManager = {
     augments = {}, -- List of {id="string", count=int}
     warps = {},    -- List of {id="string"}
 
-    basePath = "content/data/enhancements/"
+    basePath = "content/data/enhancements/",
+    handles = {} -- augment id -> C++ JokerRegistry handle
 }
 
 function EnhancementManager:init()
@@ -47,20 +48,27 @@ function EnhancementManager:resolveAugments(handResult, engineCards)
 
     if #self.augments == 0 then return effects end
 
-    -- Build list of paths and counts (planets are stackable)
-    local paths = {}
+    -- Build list of registry handles and counts (planets are stackable)
+    local ids = {}
     local stackCounts = {}
 
     for _, aug in ipairs(self.augments) do
-        table.insert(paths, self.basePath .. aug.id .. ".json")
-        table.insert(stackCounts, aug.count)
+        local handle = self.handles[aug.id]
+        if handle == nil then
+            handle = joker.intern(self.basePath .. aug.id .. ".json") or false
+            self.handles[aug.id] = handle
+        end
+        if handle then
+            table.insert(ids, handle)
+            table.insert(stackCounts, aug.count)
+        end
     end
 
     -- Using the binding to evaluate effects with stack counts
     -- We pass "on_score" as trigger
-    if #paths > 0 and engineCards then
-        -- Note: joker.applyEffects returns { addedChips, addedTempMult, addedPermMult, ignoresCaps }
-        local result = joker.applyEffects(paths, engineCards, "on_score", stackCounts)
+    if #ids > 0 and engineCards then
+        -- Note: joker.applyEffectsById returns { addedChips, addedTempMult, addedPermMult, ignoresCaps }
+        local result = joker.applyEffectsById(ids, engineCards, "on_score", stackCounts)
 
         if result then
             effects.chips = result.addedChips
@@ -2,7 +2,8 @@
 
 JokerManager = {
     slots = {},
-    maxSlots = 5
+    maxSlots = 5,
+    handles = {} -- jokerId -> C++ JokerRegistry handle (stable across reloads)
 }
 
 function JokerManager:init()
@@ -129,17 +130,32 @@ function JokerManager:applyEffects(hand, trigger)
 
     if #self.slots == 0 then return result end
 
-    -- Build paths and stack counts for tier system
-    local jokerPaths = {}
+    -- Build registry handles and stack counts for tier system
+    local jokerIds = {}
     local stackCounts = {}
 
     for _, jokerObj in ipairs(self.slots) do
-        table.insert(jokerPaths, "content/data/jokers/" .. jokerObj.id .. ".json")
-        table.insert(stackCounts, jokerObj.stack)
+        local handle = self:getHandle(jokerObj.id)
+        if handle then
+            table.insert(jokerIds, handle)
+            table.insert(stackCounts, jokerObj.stack)
+        end
     end
 
     -- Pass stack counts to C++ for tier-based effect resolution
-    return joker.applyEffects(jokerPaths, hand, trigger, stackCounts)
+    return joker.applyEffectsById(jokerIds, hand, trigger, stackCounts)
+end
+
+-- Resolve (and cache) the registry handle for a joker id.
+-- The JSON is parsed once by C++; scoring never touches the file again.
+function JokerManager:getHandle(jokerId)
+    local handle = self.handles[jokerId]
+    if handle == nil then
+        -- Cache failures as false so a bad id is not retried every score
+        handle = joker.intern("content/data/jokers/" .. jokerId .. ".json") or false
+        self.handles[jokerId] = handle
+    end
+    return handle or nil
 end
 
 function JokerManager:getPaths()
@@ -0,0 +1,145 @@
+#include "core/ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// One worker's remaining range, packed as (begin << 32) | end
+/// Padded to a cache line so owners and thieves do not false-share.
+struct alignas(64) WorkRange {
+  std::atomic<uint64_t> packed{0};
+};
+
+constexpr uint64_t Pack(uint64_t begin, uint64_t end) {
+  return (begin << 32) | end;
+}
+constexpr uint64_t Begin(uint64_t packed) { return packed >> 32; }
+constexpr uint64_t End(uint64_t packed) { return packed & 0xffffffffULL; }
+
+/// Owner side: take up to grain indices off the front
+bool PopFront(WorkRange &range, size_t grain, size_t &begin, size_t &end) {
+  uint64_t state = range.packed.load(std::memory_order_relaxed);
+  while (Begin(state) < End(state)) {
+    uint64_t next = std::min<uint64_t>(Begin(state) + grain, End(state));
+    if (range.packed.compare_exchange_weak(state, Pack(next, End(state)),
+                                           std::memory_order_acq_rel)) {
+      begin = Begin(state);
+      end = next;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Thief side: take the back half of the largest other range
+bool Steal(std::vector<WorkRange> &ranges, int self, size_t &begin,
+           size_t &end) {
+  int workers = static_cast<int>(ranges.size());
+  for (;;) {
+    int victim = -1;
+    uint64_t victimState = 0;
+    uint64_t largest = 0;
+    for (int offset = 1; offset < workers; ++offset) {
+      int i = (self + offset) % workers;
+      uint64_t state = ranges[i].packed.load(std::memory_order_relaxed);
+      uint64_t remaining =
+          End(state) > Begin(state) ? End(state) - Begin(state) : 0;
+      if (remaining > largest) {
+        largest = remaining;
+        victim = i;
+        victimState = state;
+      }
+    }
+    if (victim < 0) {
+      return false; // Nothing left anywhere; work is never added
+    }
+
+    uint64_t take = std::max<uint64_t>(largest / 2, 1);
+    uint64_t split = End(victimState) - take;
+    if (ranges[victim].packed.compare_exchange_strong(
+            victimState, Pack(Begin(victimState), split),
+            std::memory_order_acq_rel)) {
+      begin = split;
+      end = End(victimState);
+      return true;
+    }
+    // Lost a race with the owner or another thief: rescan
+  }
+}
+
+} // namespace
+
+int ParallelFor(size_t count, int threads, size_t grain,
+                const ParallelForBody &body) {
+  if (count > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument("ParallelFor count must fit in 32 bits");
+  }
+  if (threads <= 0) {
+    threads = static_cast<int>(
+        std::max(1u, std::thread::hardware_concurrency()));
+  }
+  grain = std::max<size_t>(grain, 1);
+  // No more workers than chunks
+  size_t chunks = (count + grain - 1) / grain;
+  threads = static_cast<int>(
+      std::max<size_t>(1, std::min<size_t>(threads, chunks)));
+
+  std::vector<WorkRange> ranges(threads);
+  for (int i = 0; i < threads; ++i) {
+    uint64_t begin = count * i / threads;
+    uint64_t end = count * (i + 1) / threads;
+    ranges[i].packed.store(Pack(begin, end), std::memory_order_relaxed);
+  }
+
+  // First exception thrown by body; rethrown on the calling thread
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  std::atomic<bool> aborted{false};
+
+  auto worker = [&](int self) {
+    size_t begin = 0;
+    size_t end = 0;
+    try {
+      while (!aborted.load(std::memory_order_relaxed)) {
+        if (PopFront(ranges[self], grain, begin, end)) {
+          body(self, begin, end);
+          continue;
+        }
+        if (!Steal(ranges, self, begin, end)) {
+          return;
+        }
+        // Stolen work becomes our own range so others can steal from it too
+        ranges[self].packed.store(Pack(begin, end),
+                                  std::memory_order_release);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      aborted.store(true, std::memory_order_relaxed);
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (int i = 1; i < threads; ++i) {
+    pool.emplace_back(worker, i);
+  }
+  worker(0);
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return threads;
+}
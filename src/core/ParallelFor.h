@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+/// @brief Body of a ParallelFor: processes indices [begin, end) on a worker
+/// @param worker Worker index in [0, threads), stable for the whole call
+using ParallelForBody =
+    std::function<void(int worker, size_t begin, size_t end)>;
+
+/// @brief Run body over [0, count) on a work-stealing set of threads
+///
+/// The index space is split evenly into one range per worker. Each worker
+/// pops grain-sized chunks off the front of its own range; a worker that
+/// runs dry steals the back half of the largest remaining range. Ranges are
+/// packed (begin, end) pairs in a single atomic, so neither popping nor
+/// stealing takes a lock.
+///
+/// Which worker runs which index is not deterministic: callers that need
+/// reproducible output should derive everything from the index and merge
+/// per-worker results associatively.
+///
+/// @param count Number of indices (must be < 2^32)
+/// @param threads Worker count (<= 0 = std::thread::hardware_concurrency)
+/// @param grain Indices per chunk (>= 1)
+/// @param body Called once per chunk; the calling thread is worker 0. If it
+/// throws, remaining work is abandoned and the first exception is rethrown.
+/// @throws std::invalid_argument if count does not fit in 32 bits
+/// @return Number of workers used
+int ParallelFor(size_t count, int threads, size_t grain,
+                const ParallelForBody &body);
@@ -1,7 +1,9 @@
 #include "core/SpatialIndex.h"
 #include "core/Logger.h"
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <stdexcept>
 
 // =============================================================================
 // Constructor / Destructor
@@ -9,9 +11,10 @@
 
 Quadtree::Quadtree(Rect bounds, int maxObjects, int maxLevels)
     : m_Root(std::make_unique<QuadtreeNode>(bounds, 0)),
-      m_MaxObjects(maxObjects), m_MaxLevels(maxLevels) {
+      m_CollapseQueue(std::max(maxLevels, 0) + 1), m_MaxObjects(maxObjects),
+      m_MaxLevels(maxLevels) {
   // Pre-allocate space for expected object count
-  m_ObjectBounds.reserve(1024);
+  m_Objects.reserve(1024);
 }
 
 Quadtree::~Quadtree() {
@@ -23,11 +26,15 @@ Quadtree::~Quadtree() {
 // =============================================================================
 
 void Quadtree::insert(int id, Rect bounds) {
-  // Update or insert into bounds cache
-  m_ObjectBounds[id] = bounds;
+  auto [it, inserted] =
+      m_Objects.try_emplace(id, ObjectRecord{bounds, nullptr});
+  if (!inserted) {
+    moveObject(id, it->second, bounds);
+    return;
+  }
 
   // Insert into tree starting at root
-  insertIntoNode(m_Root.get(), id, bounds);
+  insertIntoNode(m_Root.get(), id, it->second);
 }
 
 void Quadtree::insertPoint(int id, float x, float y) {
@@ -39,17 +46,13 @@ void Quadtree::insertPoint(int id, float x, float y) {
 // =============================================================================
 
 void Quadtree::remove(int id) {
-  // Look up bounds from cache
-  auto it = m_ObjectBounds.find(id);
-  if (it == m_ObjectBounds.end()) {
+  auto it = m_Objects.find(id);
+  if (it == m_Objects.end()) {
     return; // Object doesn't exist, no-op
   }
 
-  Rect bounds = it->second;
-  m_ObjectBounds.erase(it);
-
-  // Remove from tree
-  removeFromNode(m_Root.get(), id, bounds);
+  removeFromNode(it->second.node, id);
+  m_Objects.erase(it);
 }
 
 // =============================================================================
@@ -57,23 +60,26 @@ void Quadtree::remove(int id) {
 // =============================================================================
 
 void Quadtree::update(int id, Rect newBounds) {
-  // Look up old bounds
-  auto it = m_ObjectBounds.find(id);
-  if (it == m_ObjectBounds.end()) {
+  auto it = m_Objects.find(id);
+  if (it == m_Objects.end()) {
     // Object doesn't exist, just insert
     insert(id, newBounds);
     return;
   }
+  moveObject(id, it->second, newBounds);
+}
 
-  Rect oldBounds = it->second;
+void Quadtree::updateBatch(const std::vector<int> &ids,
+                           const std::vector<Rect> &bounds) {
+  if (ids.size() != bounds.size()) {
+    throw std::invalid_argument("Quadtree::updateBatch: ids and bounds "
+                                "differ in size");
+  }
 
-  // Optimization: If bounds are very close, might still be in same node
-  // For simplicity, we'll just remove and re-insert
-  // A more advanced implementation would check if getQuadrant returns the same
-  // result
-  m_ObjectBounds[id] = newBounds;
-  removeFromNode(m_Root.get(), id, oldBounds);
-  insertIntoNode(m_Root.get(), id, newBounds);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    update(ids[i], bounds[i]);
+  }
+  collapseEmpty();
 }
 
 // =============================================================================
@@ -81,6 +87,7 @@ void Quadtree::update(int id, Rect newBounds) {
 // =============================================================================
 
 void Quadtree::query(Rect area, std::vector<int> &results) {
+  collapseEmpty();
   results.clear();
   queryNode(m_Root.get(), area, results);
 }
@@ -96,11 +103,11 @@ void Quadtree::queryRadius(float x, float y, float radius,
   results.erase(
       std::remove_if(results.begin(), results.end(),
                      [&](int id) {
-                       auto it = m_ObjectBounds.find(id);
-                       if (it == m_ObjectBounds.end())
+                       auto it = m_Objects.find(id);
+                       if (it == m_Objects.end())
                          return true;
 
-                       const Rect &bounds = it->second;
+                       const Rect &bounds = it->second.bounds;
                        // Check distance to closest point on rect
                        float closestX =
                            std::max(bounds.x, std::min(x, bounds.x + bounds.w));
@@ -126,11 +133,11 @@ int Quadtree::queryNearest(float x, float y, float maxRadius) {
   float nearestDistSq = maxRadius * maxRadius;
 
   for (int id : candidates) {
-    auto it = m_ObjectBounds.find(id);
-    if (it == m_ObjectBounds.end())
+    auto it = m_Objects.find(id);
+    if (it == m_Objects.end())
       continue;
 
-    const Rect &bounds = it->second;
+    const Rect &bounds = it->second.bounds;
     // Distance to closest point on object
     float closestX = std::max(bounds.x, std::min(x, bounds.x + bounds.w));
     float closestY = std::max(bounds.y, std::min(y, bounds.y + bounds.h));
@@ -152,7 +159,11 @@ int Quadtree::queryNearest(float x, float y, float maxRadius) {
 // =============================================================================
 
 void Quadtree::clear() {
-  m_ObjectBounds.clear();
+  m_Objects.clear();
+  for (auto &level : m_CollapseQueue) {
+    level.clear();
+  }
+  m_CollapsePending = false;
   clearNode(m_Root.get());
 }
 
@@ -160,7 +171,7 @@ Quadtree::Stats Quadtree::getStats() const {
   Stats stats{};
   stats.objectsPerLevel.fill(0);
   collectStats(m_Root.get(), stats);
-  stats.totalObjects = static_cast<int>(m_ObjectBounds.size());
+  stats.totalObjects = static_cast<int>(m_Objects.size());
   return stats;
 }
 
@@ -168,19 +179,20 @@ Quadtree::Stats Quadtree::getStats() const {
 // Private: Insert Implementation
 // =============================================================================
 
-void Quadtree::insertIntoNode(QuadtreeNode *node, int id, const Rect &bounds) {
-  // If this node has children, try to insert into a child
-  if (node->children[0] != nullptr) {
-    int quadrant = getQuadrant(node, bounds);
-    if (quadrant != -1) {
-      insertIntoNode(node->children[quadrant].get(), id, bounds);
-      return;
+void Quadtree::insertIntoNode(QuadtreeNode *node, int id,
+                              ObjectRecord &record) {
+  // Descend while the object fits entirely in a child
+  while (node->children[0] != nullptr) {
+    int quadrant = getQuadrant(node, record.bounds);
+    if (quadrant == -1) {
+      break; // Object crosses boundaries, store in this node
     }
-    // Object crosses boundaries, store in this node
+    node = node->children[quadrant].get();
   }
 
   // Store in this node
   node->objectIds.push_back(id);
+  record.node = node;
 
   // Check if we need to subdivide
   if (node->objectIds.size() > static_cast<size_t>(m_MaxObjects) &&
@@ -190,22 +202,91 @@ void Quadtree::insertIntoNode(QuadtreeNode *node, int id, const Rect &bounds) {
 }
 
 // =============================================================================
-// Private: Remove Implementation
+// Private: Remove / Move Implementation
 // =============================================================================
 
-void Quadtree::removeFromNode(QuadtreeNode *node, int id, const Rect &bounds) {
-  // Try to remove from children first
+void Quadtree::removeFromNode(QuadtreeNode *node, int id) {
+  auto &ids = node->objectIds;
+  ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+
+  // An emptied leaf may leave its parent with four empty children; an
+  // emptied inner node may have had only empty children all along (every
+  // object it held when it split straddled the center)
+  if (!ids.empty()) {
+    return;
+  }
   if (node->children[0] != nullptr) {
-    int quadrant = getQuadrant(node, bounds);
-    if (quadrant != -1) {
-      removeFromNode(node->children[quadrant].get(), id, bounds);
-      return;
+    m_CollapseQueue[node->level].push_back(node);
+    m_CollapsePending = true;
+  } else if (node->parent) {
+    m_CollapseQueue[node->parent->level].push_back(node->parent);
+    m_CollapsePending = true;
+  }
+}
+
+void Quadtree::moveObject(int id, ObjectRecord &record,
+                          const Rect &newBounds) {
+  record.bounds = newBounds;
+
+  // Find the shallowest ancestor that no longer routes the object toward
+  // its node; insertion from there lands where a fresh insert would
+  QuadtreeNode *node = record.node;
+  QuadtreeNode *target = node;
+  for (QuadtreeNode *child = node; child->parent; child = child->parent) {
+    QuadtreeNode *parent = child->parent;
+    int quadrant = getQuadrant(parent, newBounds);
+    if (quadrant == -1 || parent->children[quadrant].get() != child) {
+      target = parent;
     }
   }
 
-  // Remove from this node
-  auto &ids = node->objectIds;
-  ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+  // Still in the right node and not small enough for a child: nothing moves
+  if (target == node && (node->children[0] == nullptr ||
+                         getQuadrant(node, newBounds) == -1)) {
+    return;
+  }
+
+  removeFromNode(node, id);
+  insertIntoNode(target, id, record);
+}
+
+void Quadtree::collapseEmpty() {
+  if (!m_CollapsePending) {
+    return;
+  }
+  m_CollapsePending = false;
+
+  // Deepest first: a node is only freed when its parent is processed, after
+  // every candidate below it
+  for (int level = static_cast<int>(m_CollapseQueue.size()) - 1; level >= 0;
+       --level) {
+    auto &candidates = m_CollapseQueue[level];
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+
+    for (QuadtreeNode *node : candidates) {
+      if (node->children[0] == nullptr) {
+        continue;
+      }
+      bool empty = true;
+      for (const auto &child : node->children) {
+        empty = empty && child->objectIds.empty() &&
+                child->children[0] == nullptr;
+      }
+      if (!empty) {
+        continue;
+      }
+
+      for (auto &child : node->children) {
+        child.reset();
+      }
+      if (node->objectIds.empty() && node->parent) {
+        m_CollapseQueue[level - 1].push_back(node->parent);
+      }
+    }
+    candidates.clear();
+  }
 }
 
 // =============================================================================
@@ -222,8 +303,8 @@ void Quadtree::queryNode(QuadtreeNode *node, const Rect &area,
   // Add all objects in this node
   for (int id : node->objectIds) {
     // Optional: Filter by actual bounds intersection
-    auto it = m_ObjectBounds.find(id);
-    if (it != m_ObjectBounds.end() && it->second.intersects(area)) {
+    auto it = m_Objects.find(id);
+    if (it != m_Objects.end() && it->second.bounds.intersects(area)) {
       results.push_back(id);
     }
   }
@@ -248,28 +329,29 @@ void Quadtree::subdivide(QuadtreeNode *node) {
   int childLevel = node->level + 1;
 
   // Create 4 children: NW, NE, SW, SE
-  node->children[0] =
-      std::make_unique<QuadtreeNode>(Rect(x, y, halfW, halfH), childLevel);
+  node->children[0] = std::make_unique<QuadtreeNode>(
+      Rect(x, y, halfW, halfH), childLevel, node);
   node->children[1] = std::make_unique<QuadtreeNode>(
-      Rect(x + halfW, y, halfW, halfH), childLevel);
+      Rect(x + halfW, y, halfW, halfH), childLevel, node);
   node->children[2] = std::make_unique<QuadtreeNode>(
-      Rect(x, y + halfH, halfW, halfH), childLevel);
+      Rect(x, y + halfH, halfW, halfH), childLevel, node);
   node->children[3] = std::make_unique<QuadtreeNode>(
-      Rect(x + halfW, y + halfH, halfW, halfH), childLevel);
+      Rect(x + halfW, y + halfH, halfW, halfH), childLevel, node);
 
   // Redistribute objects to children
   std::vector<int> remaining;
   for (int id : node->objectIds) {
-    auto it = m_ObjectBounds.find(id);
-    if (it == m_ObjectBounds.end())
+    auto it = m_Objects.find(id);
+    if (it == m_Objects.end())
       continue;
 
-    const Rect &bounds = it->second;
-    int quadrant = getQuadrant(node, bounds);
+    ObjectRecord &record = it->second;
+    int quadrant = getQuadrant(node, record.bounds);
 
     if (quadrant != -1) {
       // Object fits in a child
       node->children[quadrant]->objectIds.push_back(id);
+      record.node = node->children[quadrant].get();
     } else {
       // Object crosses boundaries, keep in parent
       remaining.push_back(id);
@@ -343,3 +425,818 @@ void Quadtree::collectStats(QuadtreeNode *node, Stats &stats) const {
     }
   }
 }
+
+// =============================================================================
+// PooledQuadtree: Constructor
+// =============================================================================
+
+PooledQuadtree::PooledQuadtree(Rect bounds, int maxObjects, int maxLevels)
+    : m_CollapseQueue(std::max(maxLevels, 0) + 1), m_MaxObjects(maxObjects),
+      m_MaxLevels(maxLevels) {
+  Node root;
+  root.bounds = bounds;
+  m_Nodes.push_back(root);
+  m_Objects.reserve(1024);
+}
+
+// =============================================================================
+// PooledQuadtree: Object Management
+// =============================================================================
+
+void PooledQuadtree::insert(int id, Rect bounds) {
+  auto [it, inserted] = m_Objects.try_emplace(id, ObjectRecord{bounds, 0});
+  if (!inserted) {
+    moveObject(id, it->second, bounds);
+    return;
+  }
+  place(id, it->second, 0);
+}
+
+void PooledQuadtree::insertPoint(int id, float x, float y) {
+  insert(id, Rect(x, y, 0, 0));
+}
+
+void PooledQuadtree::remove(int id) {
+  auto it = m_Objects.find(id);
+  if (it == m_Objects.end()) {
+    return;
+  }
+  unplace(id, it->second);
+  m_Objects.erase(it);
+}
+
+void PooledQuadtree::update(int id, Rect newBounds) {
+  auto it = m_Objects.find(id);
+  if (it == m_Objects.end()) {
+    insert(id, newBounds);
+    return;
+  }
+  moveObject(id, it->second, newBounds);
+}
+
+void PooledQuadtree::updateBatch(const std::vector<int> &ids,
+                                 const std::vector<Rect> &bounds) {
+  if (ids.size() != bounds.size()) {
+    throw std::invalid_argument("PooledQuadtree::updateBatch: ids and "
+                                "bounds differ in size");
+  }
+
+  for (size_t i = 0; i < ids.size(); ++i) {
+    update(ids[i], bounds[i]);
+  }
+  collapseEmpty();
+}
+
+// =============================================================================
+// PooledQuadtree: Queries
+// =============================================================================
+
+template <typename Visit>
+void PooledQuadtree::forEachCandidate(const Rect &area, Visit visit) {
+  collapseEmpty();
+
+  // Pre-order, children NW..SE, like Quadtree::queryNode
+  m_Stack.clear();
+  m_Stack.push_back(0);
+  while (!m_Stack.empty()) {
+    const Node &node = m_Nodes[m_Stack.back()];
+    m_Stack.pop_back();
+    if (!node.bounds.intersects(area)) {
+      continue;
+    }
+
+    const Entry *entries = m_Slab.data() + node.offset;
+    for (uint32_t i = 0; i < node.count; ++i) {
+      if (entries[i].bounds.intersects(area)) {
+        visit(entries[i]);
+      }
+    }
+
+    if (node.firstChild != kNoChildren) {
+      for (int i = 3; i >= 0; --i) {
+        m_Stack.push_back(node.firstChild + i);
+      }
+    }
+  }
+}
+void PooledQuadtree::query(Rect area, std::vector<int> &results) {
+  results.clear();
+  forEachCandidate(area, [&](const Entry &entry) {
+    results.push_back(entry.id);
+  });
+}
+
+void PooledQuadtree::queryRadius(float x, float y, float radius,
+                                 std::vector<int> &results) {
+  results.clear();
+  float radiusSq = radius * radius;
+  Rect area(x - radius, y - radius, radius * 2, radius * 2);
+  forEachCandidate(area, [&](const Entry &entry) {
+    const Rect &bounds = entry.bounds;
+    float dx = x - std::max(bounds.x, std::min(x, bounds.x + bounds.w));
+    float dy = y - std::max(bounds.y, std::min(y, bounds.y + bounds.h));
+    if (dx * dx + dy * dy <= radiusSq) {
+      results.push_back(entry.id);
+    }
+  });
+}
+
+int PooledQuadtree::queryNearest(float x, float y, float maxRadius) {
+  int nearestId = -1;
+  float nearestDistSq = maxRadius * maxRadius;
+  Rect area(x - maxRadius, y - maxRadius, maxRadius * 2, maxRadius * 2);
+  forEachCandidate(area, [&](const Entry &entry) {
+    const Rect &bounds = entry.bounds;
+    float dx = x - std::max(bounds.x, std::min(x, bounds.x + bounds.w));
+    float dy = y - std::max(bounds.y, std::min(y, bounds.y + bounds.h));
+    float distSq = dx * dx + dy * dy;
+    if (distSq < nearestDistSq) {
+      nearestDistSq = distSq;
+      nearestId = entry.id;
+    }
+  });
+  return nearestId;
+}
+
+// =============================================================================
+// PooledQuadtree: Utilities
+// =============================================================================
+
+void PooledQuadtree::clear() {
+  m_Objects.clear();
+  for (auto &level : m_CollapseQueue) {
+    level.clear();
+  }
+  m_CollapsePending = false;
+  m_Nodes.resize(1);
+  m_Nodes[0].firstChild = kNoChildren;
+  m_Nodes[0].offset = m_Nodes[0].count = m_Nodes[0].capacity = 0;
+  m_FreeGroups.clear();
+  m_Slab.clear();
+  for (auto &spans : m_FreeSpans) {
+    spans.clear();
+  }
+}
+
+PooledQuadtree::Stats PooledQuadtree::getStats() const {
+  Stats stats{};
+  stats.objectsPerLevel.fill(0);
+
+  std::vector<int32_t> stack = {0};
+  while (!stack.empty()) {
+    const Node &node = m_Nodes[stack.back()];
+    stack.pop_back();
+
+    stats.nodeCount++;
+    stats.maxDepth = std::max(stats.maxDepth, node.level);
+    if (node.level < 10) {
+      stats.objectsPerLevel[node.level] += static_cast<int>(node.count);
+    }
+    if (node.firstChild != kNoChildren) {
+      for (int i = 0; i < 4; ++i) {
+        stack.push_back(node.firstChild + i);
+      }
+    }
+  }
+
+  stats.totalObjects = static_cast<int>(m_Objects.size());
+  return stats;
+}
+
+// =============================================================================
+// PooledQuadtree: Internals
+// =============================================================================
+
+int32_t PooledQuadtree::findNode(const Rect &bounds, int32_t start) const {
+  int32_t index = start;
+  for (;;) {
+    const Node &node = m_Nodes[index];
+    if (node.firstChild == kNoChildren) {
+      return index;
+    }
+    int quadrant = getQuadrant(node, bounds);
+    if (quadrant == -1) {
+      return index; // Crosses boundaries, stays here
+    }
+    index = node.firstChild + quadrant;
+  }
+}
+
+void PooledQuadtree::place(int id, ObjectRecord &record, int32_t start) {
+  int32_t index = findNode(record.bounds, start);
+  append(index, {record.bounds, id});
+  record.node = index;
+
+  const Node &node = m_Nodes[index];
+  if (node.count > static_cast<uint32_t>(m_MaxObjects) &&
+      node.level < m_MaxLevels && node.firstChild == kNoChildren) {
+    subdivide(index);
+  }
+}
+
+void PooledQuadtree::unplace(int id, const ObjectRecord &record) {
+  Node &node = m_Nodes[record.node];
+
+  // Shift the tail down to keep insertion order (matches Quadtree)
+  Entry *entries = m_Slab.data() + node.offset;
+  for (uint32_t i = 0; i < node.count; ++i) {
+    if (entries[i].id == id) {
+      std::copy(entries + i + 1, entries + node.count, entries + i);
+      --node.count;
+      break;
+    }
+  }
+
+  // Emptied leaf: queue its parent; emptied inner node: queue itself, its
+  // children may all be empty (see Quadtree::removeFromNode)
+  if (node.count != 0) {
+    return;
+  }
+  if (node.firstChild != kNoChildren) {
+    m_CollapseQueue[node.level].push_back(record.node);
+    m_CollapsePending = true;
+  } else if (node.parent != kNoParent) {
+    m_CollapseQueue[m_Nodes[node.parent].level].push_back(node.parent);
+    m_CollapsePending = true;
+  }
+}
+
+void PooledQuadtree::moveObject(int id, ObjectRecord &record,
+                                const Rect &newBounds) {
+  // Shallowest ancestor that no longer routes the object to its node (see
+  // Quadtree::moveObject)
+  int32_t target = record.node;
+  for (int32_t child = record.node; m_Nodes[child].parent != kNoParent;
+       child = m_Nodes[child].parent) {
+    const Node &parent = m_Nodes[m_Nodes[child].parent];
+    int quadrant = getQuadrant(parent, newBounds);
+    if (quadrant == -1 || parent.firstChild + quadrant != child) {
+      target = m_Nodes[child].parent;
+    }
+  }
+
+  const Node &node = m_Nodes[record.node];
+  if (target == record.node && (node.firstChild == kNoChildren ||
+                                getQuadrant(node, newBounds) == -1)) {
+    // Stays put: rewrite its entry in place
+    Entry *entries = m_Slab.data() + node.offset;
+    for (uint32_t i = 0; i < node.count; ++i) {
+      if (entries[i].id == id) {
+        entries[i].bounds = newBounds;
+        break;
+      }
+    }
+    record.bounds = newBounds;
+    return;
+  }
+
+  unplace(id, record);
+  record.bounds = newBounds;
+  place(id, record, target);
+}
+
+void PooledQuadtree::collapseEmpty() {
+  if (!m_CollapsePending) {
+    return;
+  }
+  m_CollapsePending = false;
+
+  // Deepest first, as in Quadtree::collapseEmpty
+  for (int level = static_cast<int>(m_CollapseQueue.size()) - 1; level >= 0;
+       --level) {
+    auto &candidates = m_CollapseQueue[level];
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                     candidates.end());
+
+    for (int32_t index : candidates) {
+      int32_t first = m_Nodes[index].firstChild;
+      if (first == kNoChildren) {
+        continue;
+      }
+      bool empty = true;
+      for (int i = 0; i < 4; ++i) {
+        const Node &child = m_Nodes[first + i];
+        empty = empty && child.count == 0 && child.firstChild == kNoChildren;
+      }
+      if (!empty) {
+        continue;
+      }
+
+      for (int i = 0; i < 4; ++i) {
+        Node &child = m_Nodes[first + i];
+        if (child.capacity) {
+          freeSpan(child.offset, child.capacity);
+        }
+        child = Node{};
+      }
+      m_FreeGroups.push_back(first);
+
+      Node &node = m_Nodes[index];
+      node.firstChild = kNoChildren;
+      if (node.count == 0 && node.parent != kNoParent) {
+        m_CollapseQueue[level - 1].push_back(node.parent);
+      }
+    }
+    candidates.clear();
+  }
+}
+
+void PooledQuadtree::append(int32_t index, const Entry &entry) {
+  Node &node = m_Nodes[index];
+  if (node.count == node.capacity) {
+    uint32_t capacity = node.capacity ? node.capacity * 2 : kMinSpan;
+    uint32_t offset = allocateSpan(capacity);
+    std::copy(m_Slab.begin() + node.offset,
+              m_Slab.begin() + node.offset + node.count,
+              m_Slab.begin() + offset);
+    if (node.capacity) {
+      freeSpan(node.offset, node.capacity);
+    }
+    node.offset = offset;
+    node.capacity = capacity;
+  }
+  m_Slab[node.offset + node.count++] = entry;
+}
+
+void PooledQuadtree::subdivide(int32_t index) {
+  int32_t first;
+  if (!m_FreeGroups.empty()) {
+    first = m_FreeGroups.back();
+    m_FreeGroups.pop_back();
+  } else {
+    first = static_cast<int32_t>(m_Nodes.size());
+    m_Nodes.resize(m_Nodes.size() + 4);
+  }
+
+  // m_Nodes may have grown; take references afterwards
+  Node &parent = m_Nodes[index];
+  float halfW = parent.bounds.w / 2.0f;
+  float halfH = parent.bounds.h / 2.0f;
+  float x = parent.bounds.x;
+  float y = parent.bounds.y;
+  const Rect quadrants[4] = {Rect(x, y, halfW, halfH),
+                             Rect(x + halfW, y, halfW, halfH),
+                             Rect(x, y + halfH, halfW, halfH),
+                             Rect(x + halfW, y + halfH, halfW, halfH)};
+  for (int i = 0; i < 4; ++i) {
+    Node &child = m_Nodes[first + i];
+    child = Node{};
+    child.bounds = quadrants[i];
+    child.parent = index;
+    child.level = parent.level + 1;
+  }
+  parent.firstChild = first;
+
+  // Move objects that fit a child; the rest stay, in order
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < m_Nodes[index].count; ++i) {
+    Entry entry = m_Slab[m_Nodes[index].offset + i];
+    int quadrant = getQuadrant(m_Nodes[index], entry.bounds);
+    if (quadrant != -1) {
+      append(first + quadrant, entry); // May grow m_Slab
+      m_Objects[entry.id].node = first + quadrant;
+    } else {
+      m_Slab[m_Nodes[index].offset + kept++] = entry;
+    }
+  }
+  m_Nodes[index].count = kept;
+}
+
+int PooledQuadtree::getQuadrant(const Node &node, const Rect &bounds) const {
+  float midX = node.bounds.x + node.bounds.w / 2.0f;
+  float midY = node.bounds.y + node.bounds.h / 2.0f;
+
+  bool inLeft = (bounds.x + bounds.w < midX);
+  bool inRight = (bounds.x >= midX);
+  bool inTop = (bounds.y + bounds.h < midY);
+  bool inBottom = (bounds.y >= midY);
+
+  if (inTop && inLeft)
+    return 0; // NW
+  if (inTop && inRight)
+    return 1; // NE
+  if (inBottom && inLeft)
+    return 2; // SW
+  if (inBottom && inRight)
+    return 3; // SE
+
+  return -1; // Crosses boundaries
+}
+
+uint32_t PooledQuadtree::allocateSpan(uint32_t capacity) {
+  auto &free = m_FreeSpans[std::countr_zero(capacity / kMinSpan)];
+  if (!free.empty()) {
+    uint32_t offset = free.back();
+    free.pop_back();
+    return offset;
+  }
+  uint32_t offset = static_cast<uint32_t>(m_Slab.size());
+  m_Slab.resize(m_Slab.size() + capacity);
+  return offset;
+}
+
+void PooledQuadtree::freeSpan(uint32_t offset, uint32_t capacity) {
+  m_FreeSpans[std::countr_zero(capacity / kMinSpan)].push_back(offset);
+}
+
+// =============================================================================
+// SpatialHashGrid: Constructor
+// =============================================================================
+
+SpatialHashGrid::SpatialHashGrid(Rect bounds, float cellSize)
+    : m_Bounds(bounds), m_CellSize(cellSize), m_InvCellSize(1.0f / cellSize) {
+  if (!(cellSize > 0.0f) || !std::isfinite(cellSize)) {
+    throw std::invalid_argument("SpatialHashGrid: cellSize must be positive");
+  }
+  double size = cellSize;
+  double columns = std::max(1.0, std::ceil(bounds.w / size));
+  double rows = std::max(1.0, std::ceil(bounds.h / size));
+  if (!(columns * rows <= static_cast<double>(kMaxCells))) {
+    throw std::invalid_argument("SpatialHashGrid: too many cells");
+  }
+  m_Columns = static_cast<int32_t>(columns);
+  m_Rows = static_cast<int32_t>(rows);
+  m_Cells.resize(static_cast<size_t>(m_Columns) * m_Rows);
+  m_Objects.reserve(1024);
+}
+
+// =============================================================================
+// SpatialHashGrid: Object Management
+// =============================================================================
+
+void SpatialHashGrid::insert(int id, Rect bounds) { update(id, bounds); }
+
+void SpatialHashGrid::insertPoint(int id, float x, float y) {
+  update(id, Rect(x, y, 0, 0));
+}
+
+void SpatialHashGrid::remove(int id) {
+  syncObjects();
+  auto it = m_Objects.find(id);
+  if (it == m_Objects.end()) {
+    return;
+  }
+  unlink(id, cellRange(it->second));
+  m_Objects.erase(it);
+  --m_Count;
+}
+
+void SpatialHashGrid::update(int id, Rect newBounds) {
+  syncObjects();
+  CellRange cells = cellRange(newBounds);
+  auto [it, inserted] = m_Objects.try_emplace(id, newBounds);
+  if (inserted) {
+    link(id, newBounds, cells);
+    ++m_Count;
+    return;
+  }
+
+  CellRange oldCells = cellRange(it->second);
+  it->second = newBounds;
+  if (!(oldCells == cells)) {
+    unlink(id, oldCells);
+    link(id, newBounds, cells);
+    return;
+  }
+
+  // Same cells: rewrite the entries in place
+  for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+    for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+      Entry *entry = m_Slab.data() + cellAt(column, row).offset;
+      while (entry->id != id) {
+        ++entry;
+      }
+      entry->bounds = newBounds;
+    }
+  }
+}
+
+void SpatialHashGrid::updateBatch(const std::vector<int> &ids,
+                                  const std::vector<Rect> &bounds) {
+  if (ids.size() != bounds.size()) {
+    throw std::invalid_argument(
+        "SpatialHashGrid::updateBatch: ids and bounds differ in size");
+  }
+  for (size_t i = 0; i < ids.size(); ++i) {
+    update(ids[i], bounds[i]);
+  }
+}
+
+void SpatialHashGrid::rebuild(size_t count, const float *xs, const float *ys,
+                              const float *ws, const float *hs,
+                              const int *ids) {
+  auto boundsAt = [&](size_t i) {
+    return Rect(xs[i], ys[i], ws ? ws[i] : 0.0f, hs ? hs[i] : 0.0f);
+  };
+
+  // A repeated ID keeps only its last bounds, as repeated inserts would
+  size_t kept = ids ? markDuplicates(count, ids) : count;
+  auto dropped = [&](size_t i) { return kept != count && m_Dropped[i]; };
+
+  // Count entries per cell
+  for (Cell &cell : m_Cells) {
+    cell.count = 0;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (dropped(i)) {
+      continue;
+    }
+    CellRange cells = cellRange(boundsAt(i));
+    for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+      for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+        ++cellAt(column, row).count;
+      }
+    }
+  }
+
+  // Lay the spans out in cell order, sized by power of two so later
+  // inserts and moves can reuse them
+  uint32_t offset = 0;
+  for (Cell &cell : m_Cells) {
+    cell.offset = offset;
+    cell.capacity =
+        cell.count ? std::max(kMinSpan, std::bit_ceil(cell.count)) : 0;
+    offset += cell.capacity;
+    cell.count = 0;
+  }
+  m_Slab.resize(offset);
+  for (auto &spans : m_FreeSpans) {
+    spans.clear();
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    if (dropped(i)) {
+      continue;
+    }
+    Rect bounds = boundsAt(i);
+    int id = ids ? ids[i] : static_cast<int>(i);
+    CellRange cells = cellRange(bounds);
+    for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+      for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+        Cell &cell = cellAt(column, row);
+        m_Slab[cell.offset + cell.count++] = {bounds, id};
+      }
+    }
+  }
+
+  m_Objects.clear();
+  m_ObjectsStale = true;
+  m_Count = static_cast<int>(kept);
+}
+
+size_t SpatialHashGrid::markDuplicates(size_t count, const int *ids) {
+  // Sort (id, index) pairs; every pair but the last of a run is dropped
+  m_IdOrder.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    m_IdOrder[i] = {ids[i], static_cast<uint32_t>(i)};
+  }
+  std::sort(m_IdOrder.begin(), m_IdOrder.end());
+
+  size_t kept = count;
+  for (size_t i = 1; i < count; ++i) {
+    if (m_IdOrder[i - 1].first != m_IdOrder[i].first) {
+      continue;
+    }
+    if (kept == count) {
+      m_Dropped.assign(count, 0); // First duplicate
+    }
+    m_Dropped[m_IdOrder[i - 1].second] = 1;
+    --kept;
+  }
+  return kept;
+}
+
+// =============================================================================
+// SpatialHashGrid: Queries
+// =============================================================================
+
+template <typename Visit>
+void SpatialHashGrid::forEachIntersecting(const Rect &area,
+                                          Visit visit) const {
+  // An object in several cells is reported from the first cell it shares
+  // with the area: the area's first column (row), or else the object's own.
+  // An entry starts in this column iff its cellColumn() is >= column, which
+  // is the unfloored, unclamped comparison below.
+  CellRange cells = cellRange(area);
+  for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+    bool firstRow = row == cells.y0;
+    float rowStart = static_cast<float>(row);
+    for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+      bool firstColumn = column == cells.x0;
+      float columnStart = static_cast<float>(column);
+      const Cell &cell = cellAt(column, row);
+      const Entry *entries = m_Slab.data() + cell.offset;
+      for (uint32_t i = 0; i < cell.count; ++i) {
+        const Entry &entry = entries[i];
+        if (entry.bounds.intersects(area) &&
+            (firstColumn || (entry.bounds.x - m_Bounds.x) * m_InvCellSize >=
+                                columnStart) &&
+            (firstRow ||
+             (entry.bounds.y - m_Bounds.y) * m_InvCellSize >= rowStart)) {
+          visit(entry);
+        }
+      }
+    }
+  }
+}
+
+void SpatialHashGrid::query(Rect area, std::vector<int> &results) const {
+  results.clear();
+  forEachIntersecting(area,
+                      [&](const Entry &entry) { results.push_back(entry.id); });
+}
+
+void SpatialHashGrid::queryRadius(float x, float y, float radius,
+                                  std::vector<int> &results) const {
+  results.clear();
+  float radiusSq = radius * radius;
+  Rect area(x - radius, y - radius, radius * 2, radius * 2);
+  forEachIntersecting(area, [&](const Entry &entry) {
+    const Rect &bounds = entry.bounds;
+    float dx = x - std::max(bounds.x, std::min(x, bounds.x + bounds.w));
+    float dy = y - std::max(bounds.y, std::min(y, bounds.y + bounds.h));
+    if (dx * dx + dy * dy <= radiusSq) {
+      results.push_back(entry.id);
+    }
+  });
+}
+
+int SpatialHashGrid::queryNearest(float x, float y, float maxRadius) const {
+  int nearestId = -1;
+  float nearestDistSq = maxRadius * maxRadius;
+  auto visitCell = [&](int32_t column, int32_t row) {
+    const Cell &cell = cellAt(column, row);
+    const Entry *entries = m_Slab.data() + cell.offset;
+    for (uint32_t i = 0; i < cell.count; ++i) {
+      const Rect &bounds = entries[i].bounds;
+      float dx = x - std::max(bounds.x, std::min(x, bounds.x + bounds.w));
+      float dy = y - std::max(bounds.y, std::min(y, bounds.y + bounds.h));
+      float distSq = dx * dx + dy * dy;
+      if (distSq < nearestDistSq) {
+        nearestDistSq = distSq;
+        nearestId = entries[i].id;
+      }
+    }
+  };
+
+  // Square rings of cells around the point's cell. Entries in ring r are
+  // at least r - 1 cells away (clamped objects only sit farther out), so
+  // stop once that gap reaches the best distance.
+  int32_t column = cellColumn(x);
+  int32_t row = cellRow(y);
+  int32_t rings = std::max(std::max(column, m_Columns - 1 - column),
+                           std::max(row, m_Rows - 1 - row));
+  for (int32_t ring = 0; ring <= rings; ++ring) {
+    float gap = static_cast<float>(ring - 1) * m_CellSize;
+    if (ring > 1 && gap * gap >= nearestDistSq) {
+      break;
+    }
+    int32_t x0 = column - ring, x1 = column + ring;
+    int32_t y0 = row - ring, y1 = row + ring;
+    for (int32_t c = std::max(x0, 0); c <= std::min(x1, m_Columns - 1); ++c) {
+      if (y0 >= 0) {
+        visitCell(c, y0);
+      }
+      if (ring > 0 && y1 < m_Rows) {
+        visitCell(c, y1);
+      }
+    }
+    for (int32_t r = std::max(y0 + 1, 0); r <= std::min(y1 - 1, m_Rows - 1);
+         ++r) {
+      if (x0 >= 0) {
+        visitCell(x0, r);
+      }
+      if (ring > 0 && x1 < m_Columns) {
+        visitCell(x1, r);
+      }
+    }
+  }
+  return nearestId;
+}
+
+// =============================================================================
+// SpatialHashGrid: Utilities
+// =============================================================================
+
+void SpatialHashGrid::clear() {
+  std::fill(m_Cells.begin(), m_Cells.end(), Cell{});
+  m_Slab.clear();
+  for (auto &spans : m_FreeSpans) {
+    spans.clear();
+  }
+  m_Objects.clear();
+  m_ObjectsStale = false;
+  m_Count = 0;
+}
+
+SpatialHashGrid::Stats SpatialHashGrid::getStats() const {
+  Stats stats{};
+  stats.cellCount = static_cast<int>(m_Cells.size());
+  stats.totalObjects = m_Count;
+  for (const Cell &cell : m_Cells) {
+    if (cell.count > 0) {
+      ++stats.occupiedCells;
+      stats.maxPerCell =
+          std::max(stats.maxPerCell, static_cast<int>(cell.count));
+    }
+  }
+  return stats;
+}
+
+// =============================================================================
+// SpatialHashGrid: Internals
+// =============================================================================
+
+int32_t SpatialHashGrid::cellColumn(float x) const {
+  float column = std::floor((x - m_Bounds.x) * m_InvCellSize);
+  if (!(column > 0.0f)) { // Also NaN
+    return 0;
+  }
+  return column < static_cast<float>(m_Columns - 1)
+             ? static_cast<int32_t>(column)
+             : m_Columns - 1;
+}
+
+int32_t SpatialHashGrid::cellRow(float y) const {
+  float row = std::floor((y - m_Bounds.y) * m_InvCellSize);
+  if (!(row > 0.0f)) {
+    return 0;
+  }
+  return row < static_cast<float>(m_Rows - 1) ? static_cast<int32_t>(row)
+                                              : m_Rows - 1;
+}
+
+SpatialHashGrid::CellRange
+SpatialHashGrid::cellRange(const Rect &bounds) const {
+  return {cellColumn(bounds.x), cellRow(bounds.y),
+          cellColumn(bounds.x + bounds.w), cellRow(bounds.y + bounds.h)};
+}
+
+void SpatialHashGrid::link(int id, const Rect &bounds,
+                           const CellRange &cells) {
+  for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+    for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+      Cell &cell = cellAt(column, row);
+      if (cell.count == cell.capacity) {
+        uint32_t capacity = cell.capacity ? cell.capacity * 2 : kMinSpan;
+        uint32_t offset = allocateSpan(capacity);
+        std::copy(m_Slab.begin() + cell.offset,
+                  m_Slab.begin() + cell.offset + cell.count,
+                  m_Slab.begin() + offset);
+        if (cell.capacity) {
+          freeSpan(cell.offset, cell.capacity);
+        }
+        cell.offset = offset;
+        cell.capacity = capacity;
+      }
+      m_Slab[cell.offset + cell.count++] = {bounds, id};
+    }
+  }
+}
+
+void SpatialHashGrid::unlink(int id, const CellRange &cells) {
+  for (int32_t row = cells.y0; row <= cells.y1; ++row) {
+    for (int32_t column = cells.x0; column <= cells.x1; ++column) {
+      // Order within a cell does not matter: swap with the last entry
+      Cell &cell = cellAt(column, row);
+      Entry *entries = m_Slab.data() + cell.offset;
+      for (uint32_t i = 0; i < cell.count; ++i) {
+        if (entries[i].id == id) {
+          entries[i] = entries[--cell.count];
+          break;
+        }
+      }
+    }
+  }
+}
+
+void SpatialHashGrid::syncObjects() {
+  if (!m_ObjectsStale) {
+    return;
+  }
+  m_Objects.reserve(m_Count);
+  for (const Cell &cell : m_Cells) {
+    const Entry *entries = m_Slab.data() + cell.offset;
+    for (uint32_t i = 0; i < cell.count; ++i) {
+      m_Objects.try_emplace(entries[i].id, entries[i].bounds);
+    }
+  }
+  m_ObjectsStale = false;
+}
+
+uint32_t SpatialHashGrid::allocateSpan(uint32_t capacity) {
+  auto &free = m_FreeSpans[std::countr_zero(capacity / kMinSpan)];
+  if (!free.empty()) {
+    uint32_t offset = free.back();
+    free.pop_back();
+    return offset;
+  }
+  uint32_t offset = static_cast<uint32_t>(m_Slab.size());
+  m_Slab.resize(m_Slab.size() + capacity);
+  return offset;
+}
+
+void SpatialHashGrid::freeSpan(uint32_t offset, uint32_t capacity) {
+  m_FreeSpans[std::countr_zero(capacity / kMinSpan)].push_back(offset);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <unordered_map>
@@ -80,7 +81,7 @@ public:
 
   /**
    * Insert an object into the tree.
-   * If an object with this ID already exists, its bounds are updated.
+   * If an object with this ID already exists, it is moved (see update).
    *
    * @param id Unique object identifier
    * @param bounds Object's axis-aligned bounding box
@@ -99,7 +100,7 @@ public:
 
   /**
    * Remove an object from the tree.
-   * Looks up bounds internally via m_ObjectBounds.
+   * Finds its node through the id -> node back-reference.
    * No-op if the object doesn't exist.
    *
    * @param id Object identifier to remove
@@ -107,14 +108,26 @@ public:
   void remove(int id);
 
   /**
-   * Update an object's position/size.
-   * Optimized to avoid removal if still in same node.
+   * Update an object's position/size (inserts it if missing).
+   * Objects that still belong in their node are updated in place; others
+   * move up only as far as needed. Subtrees left empty are collapsed
+   * lazily (before the next query or at the end of updateBatch).
    *
    * @param id Object identifier to update
    * @param newBounds New bounding box
    */
   void update(int id, Rect newBounds);
 
+  /**
+   * Update many objects at once (e.g., every mover, once per frame).
+   *
+   * @param ids Object identifiers
+   * @param bounds New bounds, one per id
+   * @throws std::invalid_argument if the sizes differ
+   */
+  void updateBatch(const std::vector<int> &ids,
+                   const std::vector<Rect> &bounds);
+
   // --- Queries ---
 
   /**
@@ -156,7 +169,7 @@ public:
   /**
    * Get current object count.
    */
-  int size() const { return static_cast<int>(m_ObjectBounds.size()); }
+  int size() const { return static_cast<int>(m_Objects.size()); }
 
   /**
    * Get statistics about tree structure.
@@ -174,23 +187,38 @@ private:
     std::array<std::unique_ptr<QuadtreeNode>, 4>
         children; // NW, NE, SW, SE (nullptr if not subdivided)
     int level;    // Depth in tree (root = 0)
+    QuadtreeNode *parent; // nullptr for the root
+
+    QuadtreeNode(Rect bounds_, int level_, QuadtreeNode *parent_ = nullptr)
+        : bounds(bounds_), children{nullptr, nullptr, nullptr, nullptr},
+          level(level_), parent(parent_) {}
+  };
 
-    QuadtreeNode(Rect bounds_, int level_)
-        : bounds(bounds_), level(level_),
-          children{nullptr, nullptr, nullptr, nullptr} {}
+  /**
+   * Per-object bounds and the node holding it.
+   */
+  struct ObjectRecord {
+    Rect bounds;
+    QuadtreeNode *node;
   };
 
   // Tree structure
   std::unique_ptr<QuadtreeNode> m_Root;
-  std::unordered_map<int, Rect> m_ObjectBounds; // ID -> bounds cache
+  std::unordered_map<int, ObjectRecord> m_Objects; // ID -> bounds, node
+
+  // Nodes whose children may all be empty, by level (collapsed lazily)
+  std::vector<std::vector<QuadtreeNode *>> m_CollapseQueue;
+  bool m_CollapsePending = false;
 
   // Configuration
   int m_MaxObjects; // Max objects before split
   int m_MaxLevels;  // Max depth
 
   // Internal methods
-  void insertIntoNode(QuadtreeNode *node, int id, const Rect &bounds);
-  void removeFromNode(QuadtreeNode *node, int id, const Rect &bounds);
+  void insertIntoNode(QuadtreeNode *node, int id, ObjectRecord &record);
+  void removeFromNode(QuadtreeNode *node, int id);
+  void moveObject(int id, ObjectRecord &record, const Rect &newBounds);
+  void collapseEmpty();
   void queryNode(QuadtreeNode *node, const Rect &area,
                  std::vector<int> &results);
   void subdivide(QuadtreeNode *node);
@@ -198,3 +226,344 @@ private:
   void clearNode(QuadtreeNode *node);
   void collectStats(QuadtreeNode *node, Stats &stats) const;
 };
+
+/**
+ * Quadtree with the same API and placement rules as Quadtree, laid out for
+ * cache-friendly queries.
+ *
+ * Nodes live in one contiguous array and refer to their children by index
+ * (four siblings are allocated together). Each node's objects are a span
+ * in a shared slab of {bounds, id} entries, so queries test bounds without
+ * a hash lookup per object. Spans grow by powers of two and freed spans are
+ * reused by size class.
+ *
+ * Thread Safety: NOT thread-safe. All operations must be called from the same
+ * thread (typically the main game thread).
+ */
+class PooledQuadtree {
+public:
+  using Stats = Quadtree::Stats;
+
+  /**
+   * Construct a quadtree covering the specified world area.
+   *
+   * @param bounds World space covered by root node
+   * @param maxObjects Max objects per node before subdivision (default: 10)
+   * @param maxLevels Max tree depth, root = 0 (default: 5)
+   */
+  PooledQuadtree(Rect bounds, int maxObjects = 10, int maxLevels = 5);
+
+  // --- Object Management ---
+
+  /**
+   * Insert an object into the tree.
+   * If an object with this ID already exists, it is moved (see update).
+   *
+   * @param id Unique object identifier
+   * @param bounds Object's axis-aligned bounding box
+   */
+  void insert(int id, Rect bounds);
+
+  /**
+   * Insert a point object (zero-size Rect at the point).
+   */
+  void insertPoint(int id, float x, float y);
+
+  /**
+   * Remove an object from the tree. No-op if the object doesn't exist.
+   */
+  void remove(int id);
+
+  /**
+   * Update an object's position/size (inserts it if missing); in place
+   * while it stays in its node, like Quadtree::update.
+   */
+  void update(int id, Rect newBounds);
+
+  /**
+   * Update many objects at once (see Quadtree::updateBatch).
+   *
+   * @throws std::invalid_argument if the sizes differ
+   */
+  void updateBatch(const std::vector<int> &ids,
+                   const std::vector<Rect> &bounds);
+
+  // --- Queries ---
+  // Same results, in the same order, as the matching Quadtree queries.
+
+  /**
+   * Find all objects intersecting a rectangular area.
+   *
+   * @param area Query rectangle
+   * @param results Output vector (cleared before filling)
+   */
+  void query(Rect area, std::vector<int> &results);
+
+  /**
+   * Find all objects within radius of a point.
+   */
+  void queryRadius(float x, float y, float radius, std::vector<int> &results);
+
+  /**
+   * Find the single nearest object to a point (within maxRadius).
+   *
+   * @return Object ID, or -1 if none found
+   */
+  int queryNearest(float x, float y, float maxRadius = 1000.0f);
+
+  // --- Utilities ---
+
+  /**
+   * Remove all objects and child nodes (keeps the root and pool memory).
+   */
+  void clear();
+
+  int size() const { return static_cast<int>(m_Objects.size()); }
+
+  Stats getStats() const;
+
+private:
+  static constexpr int32_t kNoChildren = -1;
+  static constexpr int32_t kNoParent = -1;
+  static constexpr uint32_t kMinSpan = 4; // Smallest span capacity
+  static constexpr int kSpanClasses = 28; // kMinSpan << 0 .. << 27
+
+  struct Entry {
+    Rect bounds;
+    int id;
+  };
+
+  struct Node {
+    Rect bounds;                      // Spatial region this node covers
+    int32_t firstChild = kNoChildren; // NW, NE, SW, SE at firstChild + 0..3
+    int32_t parent = kNoParent;
+    int32_t level = 0;                // Depth in tree (root = 0)
+    uint32_t offset = 0;              // Objects: m_Slab[offset, offset + count)
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+  };
+
+  struct ObjectRecord {
+    Rect bounds;
+    int32_t node; // Index of the node holding the object
+  };
+
+  std::vector<Node> m_Nodes;                       // [0] = root
+  std::vector<int32_t> m_FreeGroups;               // Unused groups of 4
+  std::vector<Entry> m_Slab;                       // Object spans
+  std::array<std::vector<uint32_t>, kSpanClasses> m_FreeSpans;
+  std::unordered_map<int, ObjectRecord> m_Objects; // ID -> bounds, node
+  std::vector<int32_t> m_Stack;                    // Query scratch
+
+  // Nodes whose children may all be empty, by level (collapsed lazily)
+  std::vector<std::vector<int32_t>> m_CollapseQueue;
+  bool m_CollapsePending = false;
+
+  int m_MaxObjects;
+  int m_MaxLevels;
+
+  int32_t findNode(const Rect &bounds, int32_t start) const;
+  void place(int id, ObjectRecord &record, int32_t start); // Tree only
+  void unplace(int id, const ObjectRecord &record);        // Tree only
+  void moveObject(int id, ObjectRecord &record, const Rect &newBounds);
+  void collapseEmpty();
+  void append(int32_t node, const Entry &entry);
+  void subdivide(int32_t node);
+  int getQuadrant(const Node &node, const Rect &bounds) const;
+  uint32_t allocateSpan(uint32_t capacity);
+  void freeSpan(uint32_t offset, uint32_t capacity);
+
+  // Visit entries of nodes intersecting area in Quadtree order
+  template <typename Visit>
+  void forEachCandidate(const Rect &area, Visit visit);
+};
+
+/**
+ * Uniform grid spatial index for scenes of similar-sized, densely packed
+ * objects (cards, particles, pickups), where it beats a quadtree.
+ *
+ * The world bounds are split into square cells; each object is linked into
+ * every cell its bounds overlap (usually one). Cells are addressed directly
+ * from the position since the world is bounded, and objects outside it are
+ * clamped into the edge cells, so queries stay exact anywhere. Each cell's
+ * {bounds, id} entries are a span in a shared slab, managed like
+ * PooledQuadtree's; rebuild() lays the spans out in cell order.
+ *
+ * Queries return the same sets as Quadtree, but in cell order, and
+ * queryNearest may break distance ties differently.
+ *
+ * Thread Safety: NOT thread-safe. All operations must be called from the same
+ * thread (typically the main game thread).
+ */
+class SpatialHashGrid {
+public:
+  /**
+   * Statistics about the grid occupancy.
+   */
+  struct Stats {
+    int cellCount;     // Cells in the grid
+    int occupiedCells; // Cells holding at least one entry
+    int maxPerCell;    // Most entries in a single cell
+    int totalObjects;  // Total objects stored
+  };
+
+  static constexpr int64_t kMaxCells = int64_t{1} << 24;
+
+  /**
+   * Construct a grid covering the specified world area.
+   *
+   * @param bounds World space covered by the cells
+   * @param cellSize Cell edge length; about the size of a typical object
+   * @throws std::invalid_argument if cellSize is not positive or the grid
+   *         would exceed kMaxCells cells
+   */
+  SpatialHashGrid(Rect bounds, float cellSize);
+
+  // --- Object Management ---
+
+  /**
+   * Insert an object into the grid.
+   * If an object with this ID already exists, it is moved (see update).
+   */
+  void insert(int id, Rect bounds);
+
+  /**
+   * Insert a point object (zero-size Rect at the point).
+   */
+  void insertPoint(int id, float x, float y);
+
+  /**
+   * Remove an object from the grid. No-op if the object doesn't exist.
+   */
+  void remove(int id);
+
+  /**
+   * Update an object's position/size (inserts it if missing). In place
+   * while it stays in the same cells.
+   */
+  void update(int id, Rect newBounds);
+
+  /**
+   * Update many objects at once.
+   *
+   * @throws std::invalid_argument if the sizes differ
+   */
+  void updateBatch(const std::vector<int> &ids,
+                   const std::vector<Rect> &bounds);
+
+  /**
+   * Replace the contents with count objects given as parallel arrays, in
+   * two linear passes (a counting sort by cell) and without per-object
+   * allocation. The ID lookup used by insert/remove/update is rebuilt
+   * lazily, on the first such call.
+   *
+   * @param count Number of objects
+   * @param xs, ys Top-left corners (the position for points)
+   * @param ws, hs Sizes, or nullptr for points
+   * @param ids Object IDs, or nullptr for 0..count-1. An ID given more
+   *        than once is stored once, with its last bounds (as if each
+   *        object were inserted in turn).
+   */
+  void rebuild(size_t count, const float *xs, const float *ys,
+               const float *ws = nullptr, const float *hs = nullptr,
+               const int *ids = nullptr);
+
+  // --- Queries ---
+
+  /**
+   * Find all objects intersecting a rectangular area.
+   *
+   * @param area Query rectangle
+   * @param results Output vector (cleared before filling)
+   */
+  void query(Rect area, std::vector<int> &results) const;
+
+  /**
+   * Find all objects within radius of a point.
+   */
+  void queryRadius(float x, float y, float radius,
+                   std::vector<int> &results) const;
+
+  /**
+   * Find the single nearest object to a point (within maxRadius),
+   * searching rings of cells outward from the point.
+   *
+   * @return Object ID, or -1 if none found
+   */
+  int queryNearest(float x, float y, float maxRadius = 1000.0f) const;
+
+  // --- Utilities ---
+
+  /**
+   * Remove all objects (keeps the cells and entry pool memory).
+   */
+  void clear();
+
+  int size() const { return m_Count; }
+
+  float getCellSize() const { return m_CellSize; }
+
+  Stats getStats() const;
+
+private:
+  static constexpr uint32_t kMinSpan = 4; // Smallest span capacity
+  static constexpr int kSpanClasses = 28; // kMinSpan << 0 .. << 27
+
+  struct Entry {
+    Rect bounds;
+    int id;
+  };
+
+  struct Cell {
+    uint32_t offset = 0; // Entries: m_Slab[offset, offset + count)
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+  };
+
+  struct CellRange {
+    int32_t x0, y0, x1, y1; // Inclusive
+
+    bool operator==(const CellRange &other) const {
+      return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 &&
+             y1 == other.y1;
+    }
+  };
+
+  Rect m_Bounds;
+  float m_CellSize;
+  float m_InvCellSize;
+  int32_t m_Columns;
+  int32_t m_Rows;
+
+  std::vector<Cell> m_Cells; // Row-major
+  std::vector<Entry> m_Slab; // Cell spans
+  std::array<std::vector<uint32_t>, kSpanClasses> m_FreeSpans;
+
+  std::unordered_map<int, Rect> m_Objects; // ID -> bounds
+  bool m_ObjectsStale = false; // m_Objects not yet rebuilt after rebuild()
+  int m_Count = 0;
+
+  // rebuild() scratch for finding repeated IDs
+  std::vector<std::pair<int, uint32_t>> m_IdOrder; // (id, index)
+  std::vector<uint8_t> m_Dropped; // Per index; valid only with duplicates
+
+  int32_t cellColumn(float x) const;
+  int32_t cellRow(float y) const;
+  CellRange cellRange(const Rect &bounds) const;
+  Cell &cellAt(int32_t column, int32_t row) {
+    return m_Cells[row * m_Columns + column];
+  }
+  const Cell &cellAt(int32_t column, int32_t row) const {
+    return m_Cells[row * m_Columns + column];
+  }
+  void link(int id, const Rect &bounds, const CellRange &cells);
+  void unlink(int id, const CellRange &cells);
+  void syncObjects();
+  size_t markDuplicates(size_t count, const int *ids); // Returns kept
+  uint32_t allocateSpan(uint32_t capacity);
+  void freeSpan(uint32_t offset, uint32_t capacity);
+
+  // Visit entries of cells overlapping area that intersect it, once each
+  template <typename Visit> void forEachIntersecting(const Rect &area,
+                                                     Visit visit) const;
+};
@@ -0,0 +1,75 @@
+#include "core/WorkerPool.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <exception>
+
+WorkerPool::WorkerPool(int threads) {
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+  }
+  threads = std::max(threads, 1);
+
+  m_threads.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    m_threads.emplace_back([this] { run(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    m_jobs.clear();
+  }
+  m_wake.notify_all();
+  for (std::thread &thread : m_threads) {
+    thread.join();
+  }
+}
+
+void WorkerPool::submit(Job job) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(std::move(job));
+  }
+  m_wake.notify_one();
+}
+
+void WorkerPool::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_idle.wait(lock, [this] { return m_jobs.empty() && m_running == 0; });
+}
+
+void WorkerPool::run() {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+      if (m_stopping) {
+        return;
+      }
+      job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+      ++m_running;
+    }
+
+    try {
+      job();
+    } catch (const std::exception &e) {
+      LOG_ERROR("WorkerPool: job failed: %s", e.what());
+    } catch (...) {
+      LOG_ERROR("WorkerPool: job failed with unknown exception");
+    }
+
+    bool idle;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      --m_running;
+      idle = m_jobs.empty() && m_running == 0;
+    }
+    if (idle) {
+      m_idle.notify_all();
+    }
+  }
+}
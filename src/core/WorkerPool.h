@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief Fixed set of background threads running queued jobs in FIFO order
+///
+/// For fire-and-forget work whose results are handed back through shared
+/// state (e.g. async path requests). For splitting one loop across cores
+/// use ParallelFor instead.
+class WorkerPool {
+public:
+  using Job = std::function<void()>;
+
+  /// @param threads Worker count (<= 0 = hardware threads minus one, for
+  /// the main thread; at least 1)
+  explicit WorkerPool(int threads = 0);
+
+  /// @brief Stops the workers; jobs that have not started are dropped
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /// @brief Queue a job. Exceptions thrown by a job are logged and dropped.
+  void submit(Job job);
+
+  /// @brief Block until the queue is empty and no job is running
+  void wait();
+
+  int size() const { return static_cast<int>(m_threads.size()); }
+
+private:
+  void run();
+
+  std::vector<std::thread> m_threads;
+  std::deque<Job> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_wake; // Job queued or stopping
+  std::condition_variable m_idle; // Queue drained and nothing running
+  int m_running = 0;
+  bool m_stopping = false;
+};
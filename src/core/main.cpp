@@ -12,6 +12,7 @@ extern "C" {
 #include "core/JsonUtils.h"
 #include "core/Logger.h"
 #include "events/EventSystem.h"
+#include "gameplay/joker/JokerRegistry.h"
 #include "graphics/Animation.h"
 #include "graphics/FontRenderer.h"
 #include "graphics/ParticleSystem.h"
@@ -27,6 +28,9 @@ extern "C" {
 #include "graphics/DebugDraw.h"
 #include "scripting/LuaBindings.h"
 
+// Async pathfinding completions (PathfindingBindings.cpp)
+extern void DispatchPathfindingResults();
+
 // ... after renderer init ...
 // DebugDraw::Init(&g_Renderer);
 
@@ -101,6 +105,9 @@ int main(int argc, char *argv[]) {
   // Register all Graphics, UI, and Animation bindings
   LuaBindings::Register(L);
 
+  // Parse joker definitions once; scoring works on registry handles
+  gameplay::JokerRegistry::getInstance().loadDirectory("content/data/jokers");
+
   // Register Physics & Input & Audio & Font
   Engine::Instance().Physics().RegisterLua(L);
   InputSystem::RegisterLua(L);
@@ -175,7 +182,11 @@ int main(int argc, char *argv[]) {
         lua_pop(L, 1);
       }
 
-      // 2. Reload all Lua scripts
+      // 2. Re-parse joker definitions (handles stay valid)
+      LOG_INFO("Reloading jokers...");
+      gameplay::JokerRegistry::getInstance().reload();
+
+      // 3. Reload all Lua scripts
       LOG_INFO("Reloading scripts...");
 
       // Clear package.loaded to force require() to reload all modules
@@ -229,6 +240,9 @@ int main(int argc, char *argv[]) {
     // Update Engine (Audio, Input, etc)
     Engine::Instance().Update(dt);
 
+    // Fire pathfinding_complete events before Lua update
+    DispatchPathfindingResults();
+
     // Rendering
     // Skip rendering if window is minimized/occluded to prevent GPU blocking
     if (!WindowManager::getInstance().isMinimized()) {
@@ -1,14 +1,17 @@
 #include "Card.h"
 #include <sstream>
+#include <stdexcept>
 
 namespace gameplay {
 
-Card::Card(Rank rank, Suit suit) : rank_(rank), suit_(suit) {}
-
-int Card::getValue() const {
-  // Cribbage scoring: Face cards (J, Q, K) = 10, others = rank value
-  int rankValue = static_cast<int>(rank_);
-  return (rankValue >= 11) ? 10 : rankValue;
+Card Card::fromByte(uint8_t packed) {
+  int rank = packed & 0x0F;
+  int suit = packed >> 4;
+  if (rank < 1 || rank > 13 || suit > 3) {
+    throw std::invalid_argument("Invalid packed card byte: " +
+                                std::to_string(packed));
+  }
+  return Card(static_cast<Rank>(rank), static_cast<Suit>(suit));
 }
 
 std::string Card::toString() const {
@@ -27,13 +27,16 @@ public:
   enum class Suit : uint8_t { Hearts = 0, Diamonds = 1, Clubs = 2, Spades = 3 };
 
   Card() = default;
-  Card(Rank rank, Suit suit);
+  Card(Rank rank, Suit suit) : rank_(rank), suit_(suit) {}
 
   Rank getRank() const { return rank_; }
   Suit getSuit() const { return suit_; }
 
   /// @brief Get card value for Cribbage scoring (Face cards = 10, Ace = 1)
-  int getValue() const;
+  int getValue() const {
+    int rankValue = static_cast<int>(rank_);
+    return (rankValue >= 11) ? 10 : rankValue;
+  }
 
   /// @brief Get rank as integer (1-13)
   int getRankValue() const { return static_cast<int>(rank_); }
@@ -41,6 +44,15 @@ public:
   /// @brief Get suit as integer (0-3)
   int getSuitValue() const { return static_cast<int>(suit_); }
 
+  /// @brief Pack into one byte: rank (1-13) in the low nibble, suit << 4
+  uint8_t toByte() const {
+    return static_cast<uint8_t>(getRankValue() | (getSuitValue() << 4));
+  }
+
+  /// @brief Unpack a byte produced by toByte()
+  /// @throws std::invalid_argument if rank or suit is out of range
+  static Card fromByte(uint8_t packed);
+
   /// @brief Get string representation (e.g., "A♠", "K♥")
   std::string toString() const;
 
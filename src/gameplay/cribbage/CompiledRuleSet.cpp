@@ -0,0 +1,58 @@
+#include "CompiledRuleSet.h"
+#include "effects/BlazeEffect.h"
+#include "effects/InversionEffect.h"
+#include "effects/MirrorEffect.h"
+#include "effects/WildfireEffect.h"
+
+namespace gameplay {
+
+namespace {
+
+/// Effects are stateless, so a temporary of the concrete type is enough
+/// (and lets the compiler devirtualize apply)
+template <typename Effect>
+void ApplyWarp(ScoringEngine::ScoreResult &result,
+               const HandEvaluator::HandCounts &counts,
+               std::span<const Card> cards) {
+  Effect().apply(result, counts, cards);
+}
+
+} // namespace
+
+CompiledRuleSet::CompiledRuleSet(std::span<const std::string> rules) {
+  for (const auto &rule : rules) {
+    RuleType ruleType = RuleRegistry::fromString(rule);
+    if (ruleType == RuleType::Unknown || has(ruleType)) {
+      continue;
+    }
+    m_flags.set(static_cast<size_t>(ruleType));
+
+    WarpFn warp = WarpFor(ruleType);
+    if (warp && m_warpCount < kMaxWarps) {
+      m_warps[m_warpCount++] = warp;
+    }
+  }
+
+  if (has(RuleType::OnlyPairsRuns)) {
+    m_flags.set(static_cast<size_t>(RuleType::FifteensDisabled));
+    m_flags.set(static_cast<size_t>(RuleType::FlushDisabled));
+    m_flags.set(static_cast<size_t>(RuleType::NobsDisabled));
+  }
+}
+
+CompiledRuleSet::WarpFn CompiledRuleSet::WarpFor(RuleType rule) {
+  switch (rule) {
+  case RuleType::WarpBlaze:
+    return &ApplyWarp<BlazeEffect>;
+  case RuleType::WarpMirror:
+    return &ApplyWarp<MirrorEffect>;
+  case RuleType::WarpInversion:
+    return &ApplyWarp<InversionEffect>;
+  case RuleType::WarpWildfire:
+    return &ApplyWarp<WildfireEffect>;
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace gameplay
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "HandEvaluator.h"
+#include "RuleType.h"
+#include "ScoringEngine.h"
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace gameplay {
+
+/// @brief Boss rules and warps parsed once for scoring many hands
+/// Build one per blind (or per batch) and hand it to
+/// ScoringEngine::CalculateScore. Rule flags are a bitset and warps are
+/// plain function pointers, so scoring a hand does no string lookups,
+/// hashing or allocation. Warps run in the order they first appear in the
+/// rule list; duplicates and unknown rules are ignored.
+class CompiledRuleSet {
+public:
+  /// @brief Stateless warp: modifies the score after base chips are summed
+  using WarpFn = void (*)(ScoringEngine::ScoreResult &result,
+                          const HandEvaluator::HandCounts &counts,
+                          std::span<const Card> cards);
+
+  static constexpr size_t kRuleCount = static_cast<size_t>(RuleType::Unknown);
+  static constexpr size_t kMaxWarps = 4;
+
+  /// @brief No rules (plain cribbage scoring)
+  CompiledRuleSet() = default;
+
+  /// @brief Parse boss rules and warps
+  /// @param rules Rule names (e.g. "flush_disabled", "warp_blaze")
+  explicit CompiledRuleSet(std::span<const std::string> rules);
+
+  /// @brief Check whether a rule is active
+  /// "only_pairs_runs" also reports fifteens, flush and nobs as disabled.
+  bool has(RuleType rule) const {
+    return rule != RuleType::Unknown &&
+           m_flags.test(static_cast<size_t>(rule));
+  }
+
+  /// @brief Active warps, in application order
+  std::span<const WarpFn> warps() const {
+    return std::span<const WarpFn>(m_warps.data(), m_warpCount);
+  }
+
+  /// @brief True when no rule or warp is active
+  bool empty() const { return m_flags.none(); }
+
+  /// @brief Stateless warp function for a rule
+  /// @return nullptr if the rule is not a warp
+  static WarpFn WarpFor(RuleType rule);
+
+private:
+  std::bitset<kRuleCount> m_flags;
+  std::array<WarpFn, kMaxWarps> m_warps{};
+  uint8_t m_warpCount = 0;
+};
+
+} // namespace gameplay
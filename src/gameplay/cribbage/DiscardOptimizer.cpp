@@ -0,0 +1,101 @@
+#include "DiscardOptimizer.h"
+#include "CompiledRuleSet.h"
+#include "ScoringEngine.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace gameplay {
+
+std::array<DiscardOptimizer::DiscardStats, DiscardOptimizer::kDiscardCount>
+DiscardOptimizer::Evaluate(std::span<const Card> hand,
+                           const Options &options) {
+  if (hand.size() != 6) {
+    throw std::invalid_argument("DiscardOptimizer requires exactly 6 cards");
+  }
+
+  std::vector<Card> defaultPool;
+  std::span<const Card> cuts = options.cutPool;
+  if (cuts.empty()) {
+    defaultPool = BuildCutPool(hand);
+    cuts = defaultPool;
+  }
+
+  // 15 discards x up to 46 cuts share one set of rules
+  CompiledRuleSet rules(options.bossRules);
+
+  std::array<DiscardStats, kDiscardCount> results;
+  int slot = 0;
+
+  for (int i = 0; i < 5; ++i) {
+    for (int j = i + 1; j < 6; ++j) {
+      // Kept 4-card hand (excluding discards i and j)
+      std::array<Card, 4> keep;
+      int keepCount = 0;
+      for (int k = 0; k < 6; ++k) {
+        if (k != i && k != j) {
+          keep[keepCount++] = hand[k];
+        }
+      }
+
+      DiscardStats &stats = results[slot++];
+      stats.discard = {i, j};
+
+      if (cuts.empty()) {
+        continue;
+      }
+
+      long long total = 0;
+      int minScore = std::numeric_limits<int>::max();
+      int maxScore = std::numeric_limits<int>::min();
+
+      for (const Card &cut : cuts) {
+        int score = ScoringEngine::CalculateScore(keep, cut, options.tempMult,
+                                                  options.permMult, rules)
+                        .finalScore;
+        total += score;
+        minScore = std::min(minScore, score);
+        maxScore = std::max(maxScore, score);
+      }
+
+      stats.expected =
+          static_cast<double>(total) / static_cast<double>(cuts.size());
+      stats.minScore = minScore;
+      stats.maxScore = maxScore;
+    }
+  }
+
+  return results;
+}
+
+DiscardOptimizer::DiscardStats
+DiscardOptimizer::Best(std::span<const Card> hand, const Options &options) {
+  auto results = Evaluate(hand, options);
+  return *std::max_element(results.begin(), results.end(),
+                           [](const DiscardStats &a, const DiscardStats &b) {
+                             return a.expected < b.expected;
+                           });
+}
+
+std::vector<Card> DiscardOptimizer::BuildCutPool(std::span<const Card> hand) {
+  std::vector<Card> pool;
+  pool.reserve(52);
+
+  for (int suit = 0; suit < 4; ++suit) {
+    for (int rank = 1; rank <= 13; ++rank) {
+      pool.emplace_back(static_cast<Card::Rank>(rank),
+                        static_cast<Card::Suit>(suit));
+    }
+  }
+
+  for (const Card &card : hand) {
+    auto it = std::find(pool.begin(), pool.end(), card);
+    if (it != pool.end()) {
+      pool.erase(it);
+    }
+  }
+
+  return pool;
+}
+
+} // namespace gameplay
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "gameplay/card/Card.h"
+#include <array>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace gameplay {
+
+/// @brief Exhaustive expected-value crib discard solver
+/// For each of the 15 ways to discard 2 cards from a 6-card hand, scores the
+/// kept 4 cards against every possible cut (ScoreTable + ScoringEngine) with
+/// the active boss rules and warps.
+class DiscardOptimizer {
+public:
+  /// Number of ways to choose 2 discards from 6 cards
+  static constexpr int kDiscardCount = 15;
+
+  /// @brief Scoring context for the evaluation
+  struct Options {
+    /// Temporary multiplier passed to ScoringEngine
+    float tempMult = 0.0f;
+
+    /// Permanent multiplier passed to ScoringEngine
+    float permMult = 0.0f;
+
+    /// Active boss rules and warps (e.g., "flush_disabled", "warp_mirror")
+    std::vector<std::string> bossRules;
+
+    /// Possible cut cards. Empty = standard 52-card deck minus the hand.
+    std::vector<Card> cutPool;
+  };
+
+  /// @brief Final score statistics for one discard choice
+  struct DiscardStats {
+    /// Indices (0-5) of the two discarded cards
+    std::array<int, 2> discard = {0, 1};
+
+    /// Mean final score over all cuts
+    double expected = 0.0;
+
+    /// Lowest final score over all cuts
+    int minScore = 0;
+
+    /// Highest final score over all cuts
+    int maxScore = 0;
+  };
+
+  /// @brief Evaluate all 15 discards of a 6-card hand
+  /// @param hand Exactly 6 cards (throws std::invalid_argument otherwise)
+  /// @param options Scoring context
+  /// @return Stats per discard, in (i, j) enumeration order
+  static std::array<DiscardStats, kDiscardCount>
+  Evaluate(std::span<const Card> hand, const Options &options);
+
+  /// @brief Find the discard with the highest expected score
+  /// Ties keep the earliest discard in enumeration order.
+  static DiscardStats Best(std::span<const Card> hand,
+                           const Options &options);
+
+private:
+  /// @brief Standard deck minus the cards in hand (each removed once)
+  static std::vector<Card> BuildCutPool(std::span<const Card> hand);
+};
+
+} // namespace gameplay
@@ -0,0 +1,222 @@
+#include "FastHandEvaluator.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace gameplay {
+
+namespace {
+
+constexpr void AppendLexSubsets(std::array<uint8_t, 31> &out, int &count,
+                                uint8_t mask, int start) {
+  for (int i = start; i < FastHandEvaluator::kMaxCards; ++i) {
+    uint8_t next = static_cast<uint8_t>(mask | (1u << i));
+    out[count++] = next;
+    AppendLexSubsets(out, count, next, i + 1);
+  }
+}
+
+constexpr std::array<uint8_t, 31> BuildLexSubsets() {
+  std::array<uint8_t, 31> out{};
+  int count = 0;
+  AppendLexSubsets(out, count, 0, 0);
+  return out;
+}
+
+/// All non-empty subsets of 5 cards, in the order HandEvaluator's recursive
+/// fifteen search visits them (lexicographic by sorted index list)
+constexpr std::array<uint8_t, 31> kLexSubsets = BuildLexSubsets();
+
+/// Lexicographic compare of two equal-sized subsets by sorted index list:
+/// the subset owning the lowest differing bit comes first
+inline bool LexLessSameSize(uint8_t a, uint8_t b) {
+  uint8_t diff = a ^ b;
+  return (a & diff & static_cast<uint8_t>(-diff)) != 0;
+}
+
+} // namespace
+
+FastHandEvaluator::HandResult
+FastHandEvaluator::Evaluate(std::span<const Card> hand, const Card &cut) {
+  HandResult result;
+  Evaluate(hand, cut, result);
+  return result;
+}
+
+void FastHandEvaluator::Evaluate(std::span<const Card> hand, const Card &cut,
+                                 HandResult &result) {
+  if (hand.size() > kMaxCards - 1) {
+    throw std::invalid_argument(
+        "FastHandEvaluator supports at most 4 hand cards");
+  }
+  size_t handSize = hand.size();
+
+  result.fifteenCount = 0;
+  result.pairCount = 0;
+  result.runCount = 0;
+  result.runLength = 0;
+  result.flushCount = 0;
+  result.hasNobs = false;
+
+  // Combine hand + cut for evaluation
+  for (size_t i = 0; i < handSize; ++i) {
+    result.cards[i] = hand[i];
+  }
+  result.cards[handSize] = cut;
+  result.cardCount = static_cast<uint8_t>(handSize + 1);
+
+  findFifteens(result);
+  findPairs(result);
+  findRuns(result);
+
+  // Flush (4-card hands only, cut extends to 5)
+  if (handSize == 4) {
+    Card::Suit suit = hand[0].getSuit();
+    bool allSameSuit = hand[1].getSuit() == suit &&
+                       hand[2].getSuit() == suit && hand[3].getSuit() == suit;
+    if (allSameSuit) {
+      result.flushCount = (cut.getSuit() == suit) ? 5 : 4;
+    }
+  }
+
+  // Nobs (Jack in hand matching cut suit)
+  for (size_t i = 0; i < handSize; ++i) {
+    if (hand[i].getRank() == Card::Rank::Jack &&
+        hand[i].getSuit() == cut.getSuit()) {
+      result.hasNobs = true;
+      break;
+    }
+  }
+}
+
+// ===== FIFTEENS =====
+
+void FastHandEvaluator::findFifteens(HandResult &result) {
+  int n = result.cardCount;
+
+  // Subset sums: sum[mask] = sum[mask without lowest bit] + value(lowest bit)
+  std::array<uint8_t, 1 << kMaxCards> sums{};
+  for (unsigned mask = 1; mask < (1u << n); ++mask) {
+    int lowest = std::countr_zero(mask);
+    sums[mask] = static_cast<uint8_t>(sums[mask & (mask - 1)] +
+                                      result.cards[lowest].getValue());
+  }
+
+  for (uint8_t mask : kLexSubsets) {
+    if ((mask >> n) != 0)
+      continue;
+    if (sums[mask] == 15) {
+      result.fifteens[result.fifteenCount++] = mask;
+    }
+  }
+}
+
+// ===== PAIRS =====
+
+void FastHandEvaluator::findPairs(HandResult &result) {
+  int n = result.cardCount;
+  for (int i = 0; i < n; ++i) {
+    for (int j = i + 1; j < n; ++j) {
+      if (result.cards[i].getRank() == result.cards[j].getRank()) {
+        result.pairs[result.pairCount++] =
+            static_cast<uint8_t>((1u << i) | (1u << j));
+      }
+    }
+  }
+}
+
+// ===== RUNS =====
+
+void FastHandEvaluator::findRuns(HandResult &result) {
+  // Rank histogram as per-rank card masks (index 1-13)
+  std::array<uint8_t, 14> rankMasks{};
+  for (int i = 0; i < result.cardCount; ++i) {
+    rankMasks[result.cards[i].getRankValue()] |= static_cast<uint8_t>(1u << i);
+  }
+
+  // Longest sequence of consecutive present ranks. With at most 5 cards only
+  // one sequence can reach length 3, so the longest is the only one scored.
+  int bestStart = 0;
+  int bestLength = 0;
+  int length = 0;
+  for (int rank = 1; rank <= 13; ++rank) {
+    if (rankMasks[rank] != 0) {
+      ++length;
+      if (length > bestLength) {
+        bestLength = length;
+        bestStart = rank - length + 1;
+      }
+    } else {
+      length = 0;
+    }
+  }
+
+  if (bestLength < 3)
+    return;
+
+  // Each run picks one card per rank: cartesian product of the rank masks
+  std::array<uint8_t, kMaxRuns> runs{};
+  int runCount = 1;
+  for (int rank = bestStart; rank < bestStart + bestLength; ++rank) {
+    std::array<uint8_t, kMaxRuns> next{};
+    int nextCount = 0;
+    for (int r = 0; r < runCount; ++r) {
+      for (unsigned bits = rankMasks[rank]; bits != 0; bits &= bits - 1) {
+        next[nextCount++] =
+            static_cast<uint8_t>(runs[r] | (1u << std::countr_zero(bits)));
+      }
+    }
+    runs = next;
+    runCount = nextCount;
+  }
+
+  std::sort(runs.begin(), runs.begin() + runCount, LexLessSameSize);
+
+  result.runs = runs;
+  result.runCount = static_cast<uint8_t>(runCount);
+  result.runLength = static_cast<uint8_t>(bestLength);
+}
+
+// ===== ADAPTER =====
+
+HandEvaluator::HandResult FastHandEvaluator::HandResult::ToHandResult() const {
+  auto expand = [](uint8_t mask) {
+    std::vector<int> indices;
+    indices.reserve(std::popcount(mask));
+    for (unsigned bits = mask; bits != 0; bits &= bits - 1) {
+      indices.push_back(std::countr_zero(bits));
+    }
+    return indices;
+  };
+
+  HandEvaluator::HandResult out;
+  out.cards.assign(cards.begin(), cards.begin() + cardCount);
+
+  out.fifteens.reserve(fifteenCount);
+  for (int i = 0; i < fifteenCount; ++i) {
+    out.fifteens.push_back(expand(fifteens[i]));
+  }
+
+  out.pairs.reserve(pairCount);
+  for (int i = 0; i < pairCount; ++i) {
+    out.pairs.push_back(expand(pairs[i]));
+  }
+
+  out.runs.reserve(runCount);
+  for (int i = 0; i < runCount; ++i) {
+    std::vector<int> run = expand(runs[i]);
+    // HandEvaluator reports a run spanning every card in rank order
+    if (static_cast<int>(run.size()) == cardCount) {
+      std::sort(run.begin(), run.end(), [this](int a, int b) {
+        return cards[a].getRankValue() < cards[b].getRankValue();
+      });
+    }
+    out.runs.push_back(std::move(run));
+  }
+
+  out.flushCount = flushCount;
+  out.hasNobs = hasNobs;
+  return out;
+}
+
+} // namespace gameplay
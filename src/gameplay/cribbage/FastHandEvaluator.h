@@ -0,0 +1,97 @@
+#pragma once
+
+#include "HandEvaluator.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace gameplay {
+
+/// @brief Allocation-free cribbage hand evaluator
+/// Stores every scoring combination as a 5-bit subset mask (bit i = card i)
+/// in fixed-capacity inline arrays. Intended for hot paths (simulations,
+/// autoplay, previews); use ToHandResult() where the vector-based
+/// HandEvaluator::HandResult is required (Lua bindings, jokers).
+class FastHandEvaluator {
+public:
+  /// Maximum number of cards evaluated (4-card hand + cut)
+  static constexpr int kMaxCards = 5;
+
+  /// Number of non-empty subsets of kMaxCards cards
+  static constexpr int kMaxSubsets = (1 << kMaxCards) - 1;
+
+  /// Maximum pairs / runs in 5 cards (5 choose 2, 5 choose 3)
+  static constexpr int kMaxPairs = 10;
+  static constexpr int kMaxRuns = 10;
+
+  /// @brief Fixed-size result of hand evaluation
+  struct HandResult {
+    /// Subset masks of cards that make 15 (same order as HandEvaluator)
+    std::array<uint8_t, kMaxSubsets> fifteens{};
+    uint8_t fifteenCount = 0;
+
+    /// Subset masks of cards that form pairs
+    std::array<uint8_t, kMaxPairs> pairs{};
+    uint8_t pairCount = 0;
+
+    /// Subset masks of cards that form runs (all runs share one length)
+    std::array<uint8_t, kMaxRuns> runs{};
+    uint8_t runCount = 0;
+
+    /// Length of each run (0 if no runs)
+    uint8_t runLength = 0;
+
+    /// Number of cards in flush (0, 4, or 5)
+    uint8_t flushCount = 0;
+
+    /// True if hand contains Jack matching cut card's suit (Nobs)
+    bool hasNobs = false;
+
+    /// The cards involved in the evaluation (Hand + Cut, cut last)
+    std::array<Card, kMaxCards> cards{};
+    uint8_t cardCount = 0;
+
+    /// @brief Total cards participating in runs (runCount × runLength)
+    int CardsInRuns() const { return runCount * runLength; }
+
+    /// @brief Pattern counts for scoring
+    HandEvaluator::HandCounts Counts() const {
+      HandEvaluator::HandCounts counts;
+      counts.fifteens = fifteenCount;
+      counts.pairs = pairCount;
+      counts.runs = runCount;
+      counts.runLength = runLength;
+      counts.flushCount = flushCount;
+      counts.hasNobs = hasNobs;
+      return counts;
+    }
+
+    /// @brief Convert to the vector-based HandEvaluator result
+    /// Index lists and ordering match HandEvaluator::Evaluate exactly.
+    HandEvaluator::HandResult ToHandResult() const;
+  };
+
+  /// @brief Evaluate a hand with a cut card without heap allocation
+  /// @param hand Up to 4 hand cards
+  /// @param cut The cut card
+  /// @return All detected scoring patterns as subset masks
+  /// @throws std::invalid_argument if the hand has more than 4 cards
+  static HandResult Evaluate(std::span<const Card> hand, const Card &cut);
+
+  /// @brief Evaluate into an existing result (reuses caller storage)
+  /// @throws std::invalid_argument if the hand has more than 4 cards
+  static void Evaluate(std::span<const Card> hand, const Card &cut,
+                       HandResult &result);
+
+private:
+  /// @brief Find all subsets summing to 15 via subset-sum table
+  static void findFifteens(HandResult &result);
+
+  /// @brief Find all pairs in the cards
+  static void findPairs(HandResult &result);
+
+  /// @brief Find all runs using a rank histogram
+  static void findRuns(HandResult &result);
+};
+
+} // namespace gameplay
@@ -28,6 +28,18 @@ HandEvaluator::HandResult HandEvaluator::Evaluate(const std::vector<Card> &hand,
   return result;
 }
 
+HandEvaluator::HandCounts HandEvaluator::Count(const HandResult &result) {
+  HandCounts counts;
+  counts.fifteens = static_cast<uint8_t>(result.fifteens.size());
+  counts.pairs = static_cast<uint8_t>(result.pairs.size());
+  counts.runs = static_cast<uint8_t>(result.runs.size());
+  counts.runLength =
+      result.runs.empty() ? 0 : static_cast<uint8_t>(result.runs[0].size());
+  counts.flushCount = static_cast<uint8_t>(result.flushCount);
+  counts.hasNobs = result.hasNobs;
+  return counts;
+}
+
 // ===== FIFTEENS =====
 
 void HandEvaluator::findFifteens(const std::vector<Card> &cards,
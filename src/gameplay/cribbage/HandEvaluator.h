@@ -1,6 +1,8 @@
 #pragma once
 
 #include "gameplay/card/Card.h"
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace gameplay {
@@ -30,6 +32,33 @@ public:
     std::vector<Card> cards;
   };
 
+  /// @brief Pattern counts only (everything scoring needs, no card indices)
+  struct HandCounts {
+    /// Number of fifteen combinations
+    uint8_t fifteens = 0;
+
+    /// Number of pairs
+    uint8_t pairs = 0;
+
+    /// Number of runs (all runs in a hand share the same length)
+    uint8_t runs = 0;
+
+    /// Length of each run (0 if no runs)
+    uint8_t runLength = 0;
+
+    /// Number of cards in flush (0, 4, or 5)
+    uint8_t flushCount = 0;
+
+    /// True if hand contains Jack matching cut card's suit (Nobs)
+    bool hasNobs = false;
+
+    /// @brief Total cards participating in runs
+    int CardsInRuns() const { return runs * runLength; }
+  };
+
+  /// @brief Summarize a full evaluation into pattern counts
+  static HandCounts Count(const HandResult &result);
+
   /// @brief Evaluate a hand with a cut card
   /// @param hand The 4-card hand
   /// @param cut The cut card (5th card)
@@ -0,0 +1,114 @@
+#include "ScoreTable.h"
+#include "FastHandEvaluator.h"
+#include <algorithm>
+#include <iterator>
+
+namespace gameplay {
+
+namespace {
+
+constexpr std::array<std::array<int, 6>, 17> BuildBinomials() {
+  std::array<std::array<int, 6>, 17> c{};
+  for (int n = 0; n < 17; ++n) {
+    c[n][0] = 1;
+    for (int k = 1; k < 6; ++k) {
+      c[n][k] = (n == 0) ? 0 : c[n - 1][k - 1] + c[n - 1][k];
+    }
+  }
+  return c;
+}
+
+/// Binomial coefficients C(n, k) for n < 17, k < 6
+constexpr auto kBinomial = BuildBinomials();
+
+constexpr int IndexOf(const std::array<uint8_t, 5> &sorted) {
+  // Map the sorted multiset to a strictly increasing combination of 17
+  // (c_i = rank_i - 1 + i) and rank it with the combinatorial number system
+  int index = 0;
+  for (int i = 0; i < 5; ++i) {
+    index += kBinomial[sorted[i] - 1 + i][i + 1];
+  }
+  return index;
+}
+
+/// Pattern counts per rank multiset (see tools/generate_score_table.py)
+constexpr ScoreTable::Entry kTable[] = {
+#include "ScoreTableData.inc"
+};
+
+static_assert(std::size(kTable) == ScoreTable::kEntryCount,
+              "ScoreTableData.inc is out of date");
+static_assert(kBinomial[16][5] + kBinomial[16][4] == ScoreTable::kEntryCount,
+              "C(17, 5) entries expected");
+
+inline void SortRanks(std::array<uint8_t, 5> &r) {
+  // Optimal 5-element sorting network (9 compare-exchanges); min/max
+  // compile to conditional moves, where a branch would mispredict on
+  // random hands
+  auto cmpSwap = [&r](int i, int j) {
+    uint8_t lo = std::min(r[i], r[j]);
+    r[j] = std::max(r[i], r[j]);
+    r[i] = lo;
+  };
+  cmpSwap(0, 1);
+  cmpSwap(3, 4);
+  cmpSwap(2, 4);
+  cmpSwap(2, 3);
+  cmpSwap(0, 3);
+  cmpSwap(0, 2);
+  cmpSwap(1, 4);
+  cmpSwap(1, 3);
+  cmpSwap(1, 2);
+}
+
+} // namespace
+
+int ScoreTable::Index(const std::array<uint8_t, 5> &sortedRanks) {
+  return IndexOf(sortedRanks);
+}
+
+const ScoreTable::Entry &ScoreTable::At(int index) { return kTable[index]; }
+
+const ScoreTable::Entry &ScoreTable::LookupRanks(std::array<uint8_t, 5> ranks) {
+  SortRanks(ranks);
+  return kTable[IndexOf(ranks)];
+}
+
+HandEvaluator::HandCounts ScoreTable::Lookup(std::span<const Card> hand,
+                                             const Card &cut) {
+  if (hand.size() != 4) {
+    return FastHandEvaluator::Evaluate(hand, cut).Counts();
+  }
+
+  const Entry &entry =
+      LookupRanks({static_cast<uint8_t>(hand[0].getRankValue()),
+                   static_cast<uint8_t>(hand[1].getRankValue()),
+                   static_cast<uint8_t>(hand[2].getRankValue()),
+                   static_cast<uint8_t>(hand[3].getRankValue()),
+                   static_cast<uint8_t>(cut.getRankValue())});
+
+  HandEvaluator::HandCounts counts;
+  counts.fifteens = entry.fifteens;
+  counts.pairs = entry.pairs;
+  counts.runs = entry.runs;
+  counts.runLength = entry.runLength;
+
+  // Suit flags: flush (4-card hand flush, 5 with cut) and nobs
+  Card::Suit suit = hand[0].getSuit();
+  if (hand[1].getSuit() == suit && hand[2].getSuit() == suit &&
+      hand[3].getSuit() == suit) {
+    counts.flushCount = (cut.getSuit() == suit) ? 5 : 4;
+  }
+
+  Card::Suit cutSuit = cut.getSuit();
+  for (const Card &card : hand) {
+    if (card.getRank() == Card::Rank::Jack && card.getSuit() == cutSuit) {
+      counts.hasNobs = true;
+      break;
+    }
+  }
+
+  return counts;
+}
+
+} // namespace gameplay
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "HandEvaluator.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace gameplay {
+
+/// @brief Precomputed O(1) pattern counts for 5-card cribbage hands
+/// Fifteens, pairs and runs depend only on the multiset of ranks, so the
+/// table covers all C(17, 5) = 6188 sorted rank multisets and is generated
+/// ahead of time by tools/generate_score_table.py. Flush and nobs are
+/// reduced to suit flags at lookup time.
+class ScoreTable {
+public:
+  /// Number of 5-card rank multisets (13 ranks, repetition allowed)
+  static constexpr int kEntryCount = 6188;
+
+  /// @brief Rank-only pattern counts for one multiset
+  struct Entry {
+    uint8_t fifteens = 0;
+    uint8_t pairs = 0;
+    uint8_t runs = 0;
+    uint8_t runLength = 0;
+  };
+
+  /// @brief Look up pattern counts for a 4-card hand and cut
+  /// Shorter hands fall back to FastHandEvaluator.
+  /// @throws std::invalid_argument if the hand has more than 4 cards
+  /// @param hand The hand cards
+  /// @param cut The cut card
+  /// @return Pattern counts identical to HandEvaluator::Count(Evaluate(...))
+  static HandEvaluator::HandCounts Lookup(std::span<const Card> hand,
+                                          const Card &cut);
+
+  /// @brief Look up the rank-only entry for five ranks (1-13, any order)
+  static const Entry &LookupRanks(std::array<uint8_t, 5> ranks);
+
+  /// @brief Table index of five ranks sorted ascending (combinatorial rank)
+  static int Index(const std::array<uint8_t, 5> &sortedRanks);
+
+  /// @brief Direct access to a table entry by index (for verification)
+  static const Entry &At(int index);
+};
+
+} // namespace gameplay
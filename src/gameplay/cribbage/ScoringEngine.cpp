@@ -1,10 +1,12 @@
 #include "ScoringEngine.h"
+#include "CompiledRuleSet.h"
 #include "RuleType.h"
-#include "effects/EffectFactory.h"
+#include "ScoreTable.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <stdexcept>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 namespace gameplay {
@@ -13,34 +15,65 @@ ScoringEngine::ScoreResult
 ScoringEngine::CalculateScore(const HandEvaluator::HandResult &handResult,
                               float tempMult, float permMult,
                               const std::vector<std::string> &bossRules) {
-  ScoreResult result;
+  return CalculateScore(HandEvaluator::Count(handResult), handResult.cards,
+                        tempMult, permMult, bossRules);
+}
 
-  // Parse boss rules using enum registry (O(1) hash lookup per rule)
-  std::unordered_set<RuleType> activeRules;
-  for (const auto &rule : bossRules) {
-    RuleType ruleType = RuleRegistry::fromString(rule);
-    if (ruleType != RuleType::Unknown) {
-      activeRules.insert(ruleType);
-    }
-  }
+ScoringEngine::ScoreResult
+ScoringEngine::CalculateScore(std::span<const Card> hand, const Card &cut,
+                              float tempMult, float permMult,
+                              const std::vector<std::string> &bossRules) {
+  return CalculateScore(hand, cut, tempMult, permMult,
+                        CompiledRuleSet(bossRules));
+}
 
-  // Check for rule activations
-  bool fifteensDisabled = activeRules.count(RuleType::FifteensDisabled) > 0;
-  bool multDisabled = activeRules.count(RuleType::MultipliersDisabled) > 0;
-  bool flushDisabled = activeRules.count(RuleType::FlushDisabled) > 0;
-  bool nobsDisabled = activeRules.count(RuleType::NobsDisabled) > 0;
-  bool pairsDisabled = activeRules.count(RuleType::PairsDisabled) > 0;
-  bool runsDisabled = activeRules.count(RuleType::RunsDisabled) > 0;
-  bool onlyPairsRuns = activeRules.count(RuleType::OnlyPairsRuns) > 0;
-  
-  // Warp effects are now handled by strategy pattern (no boolean flags needed)
-
-  if (onlyPairsRuns) {
-    fifteensDisabled = true;
-    flushDisabled = true;
-    nobsDisabled = true;
+ScoringEngine::ScoreResult
+ScoringEngine::CalculateScore(const HandEvaluator::HandCounts &counts,
+                              std::span<const Card> cards, float tempMult,
+                              float permMult,
+                              const std::vector<std::string> &bossRules) {
+  return CalculateScore(counts, cards, tempMult, permMult,
+                        CompiledRuleSet(bossRules));
+}
+
+ScoringEngine::ScoreResult
+ScoringEngine::CalculateScore(std::span<const Card> hand, const Card &cut,
+                              float tempMult, float permMult,
+                              const CompiledRuleSet &rules) {
+  // The table and the fixed-size evaluator cover 4-card hands; larger
+  // hands take the general evaluator instead of being cut short
+  if (hand.size() > 4) {
+    HandEvaluator::HandResult handResult = HandEvaluator::Evaluate(
+        std::vector<Card>(hand.begin(), hand.end()), cut);
+    return CalculateScore(HandEvaluator::Count(handResult), handResult.cards,
+                          tempMult, permMult, rules);
   }
 
+  std::array<Card, 5> cards;
+  size_t count = hand.size();
+  std::copy_n(hand.begin(), count, cards.begin());
+  cards[count] = cut;
+
+  return CalculateScore(ScoreTable::Lookup(hand, cut),
+                        std::span<const Card>(cards.data(), count + 1),
+                        tempMult, permMult, rules);
+}
+
+ScoringEngine::ScoreResult
+ScoringEngine::CalculateScore(const HandEvaluator::HandCounts &counts,
+                              std::span<const Card> cards, float tempMult,
+                              float permMult, const CompiledRuleSet &rules) {
+  ScoreResult result;
+
+  // Rule flags were parsed once when the rule set was compiled
+  // ("only_pairs_runs" already implies the three disablers below)
+  bool fifteensDisabled = rules.has(RuleType::FifteensDisabled);
+  bool multDisabled = rules.has(RuleType::MultipliersDisabled);
+  bool flushDisabled = rules.has(RuleType::FlushDisabled);
+  bool nobsDisabled = rules.has(RuleType::NobsDisabled);
+  bool pairsDisabled = rules.has(RuleType::PairsDisabled);
+  bool runsDisabled = rules.has(RuleType::RunsDisabled);
+
   // Calculate chips per category
   // Base formula from GDD:
   // Fifteens: 10 × count
@@ -51,34 +84,32 @@ ScoringEngine::CalculateScore(const HandEvaluator::HandResult &handResult,
 
   // Fifteens: 10 chips per combination
   if (!fifteensDisabled) {
-    result.fifteenChips = static_cast<int>(handResult.fifteens.size()) * 10;
+    result.fifteenChips = counts.fifteens * 10;
   }
 
   // Pairs: 12 chips per pair (base value, Mirror effect may modify)
   // Note: Three-of-a-kind = 3 pairs, Four-of-a-kind = 6 pairs
   if (!pairsDisabled) {
-    result.pairChips = static_cast<int>(handResult.pairs.size()) * 12;
+    result.pairChips = counts.pairs * 12;
   }
 
   // Runs: 8 chips per card in run (base value, Mirror effect may modify)
   if (!runsDisabled) {
-    for (const auto &run : handResult.runs) {
-      result.runChips += static_cast<int>(run.size()) * 8;
-    }
+    result.runChips = counts.CardsInRuns() * 8;
   }
 
   // Flush: 20 for 4 cards, 30 for 5 cards
   if (!flushDisabled) {
-    if (handResult.flushCount == 4) {
+    if (counts.flushCount == 4) {
       result.flushChips = 20;
-    } else if (handResult.flushCount == 5) {
+    } else if (counts.flushCount == 5) {
       result.flushChips = 30;
     }
   }
 
   // Nobs: 15 chips
   if (!nobsDisabled) {
-    if (handResult.hasNobs) {
+    if (counts.hasNobs) {
       result.nobsChips = 15;
     }
   }
@@ -87,14 +118,9 @@ ScoringEngine::CalculateScore(const HandEvaluator::HandResult &handResult,
   result.baseChips = result.fifteenChips + result.pairChips + result.runChips +
                      result.flushChips + result.nobsChips;
 
-  // Apply warp effects via strategy pattern
-  // Effects are applied in order they appear in activeRules
-  auto &factory = EffectFactory::getInstance();
-  for (RuleType ruleType : activeRules) {
-    auto effect = factory.create(ruleType);
-    if (effect) {
-      effect->apply(result, handResult);
-    }
+  // Apply warp effects in the order they were listed
+  for (CompiledRuleSet::WarpFn warp : rules.warps()) {
+    warp(result, counts, cards);
   }
 
   // Apply multipliers with caps
@@ -114,6 +140,28 @@ ScoringEngine::CalculateScore(const HandEvaluator::HandResult &handResult,
   return result;
 }
 
+void ScoringEngine::ScoreBatch(std::span<const Card> cards, float tempMult,
+                               float permMult,
+                               const std::vector<std::string> &bossRules,
+                               std::span<ScoreResult> results) {
+  constexpr size_t kCardsPerHand = 5;
+  if (cards.size() % kCardsPerHand != 0) {
+    throw std::invalid_argument("ScoreBatch expects 5 cards per hand");
+  }
+
+  size_t handCount = cards.size() / kCardsPerHand;
+  if (results.size() < handCount) {
+    throw std::invalid_argument("ScoreBatch results span is too small");
+  }
+
+  CompiledRuleSet rules(bossRules);
+  for (size_t i = 0; i < handCount; ++i) {
+    auto hand = cards.subspan(i * kCardsPerHand, kCardsPerHand);
+    results[i] =
+        CalculateScore(hand.first(4), hand[4], tempMult, permMult, rules);
+  }
+}
+
 float ScoringEngine::applyDiminishingReturns(int triggerCount) {
   // Diminishing returns per GDD:
   // 1st: 100%
@@ -1,11 +1,14 @@
 #pragma once
 
 #include "HandEvaluator.h"
+#include <span>
 #include <string>
 #include <vector>
 
 namespace gameplay {
 
+class CompiledRuleSet;
+
 /// @brief Calculates scores from hand evaluation results with multipliers
 class ScoringEngine {
 public:
@@ -39,6 +42,70 @@ public:
                  float tempMult = 0.0f, float permMult = 0.0f,
                  const std::vector<std::string> &bossRules = {});
 
+  /// @brief Calculate score for a hand and cut via the precomputed ScoreTable
+  /// Skips HandEvaluator entirely (no combo lists are built) for hands of
+  /// up to 4 cards; larger hands fall back to HandEvaluator.
+  /// @param hand The hand, usually 4 cards
+  /// @param cut The cut card
+  /// @param tempMult Temporary multiplier (capped at 10x)
+  /// @param permMult Permanent multiplier (capped at 5x)
+  /// @return Complete score breakdown
+  static ScoreResult
+  CalculateScore(std::span<const Card> hand, const Card &cut,
+                 float tempMult = 0.0f, float permMult = 0.0f,
+                 const std::vector<std::string> &bossRules = {});
+
+  /// @brief Calculate score from pattern counts
+  /// @param counts Evaluated hand pattern counts
+  /// @param cards Cards involved in the evaluation (hand + cut)
+  /// @param tempMult Temporary multiplier (capped at 10x)
+  /// @param permMult Permanent multiplier (capped at 5x)
+  /// @return Complete score breakdown
+  static ScoreResult
+  CalculateScore(const HandEvaluator::HandCounts &counts,
+                 std::span<const Card> cards, float tempMult = 0.0f,
+                 float permMult = 0.0f,
+                 const std::vector<std::string> &bossRules = {});
+
+  /// @brief Calculate score for a hand and cut with pre-parsed rules
+  /// @param hand The hand, usually 4 cards (see above for larger hands)
+  /// @param cut The cut card
+  /// @param tempMult Temporary multiplier (capped at 10x)
+  /// @param permMult Permanent multiplier (capped at 5x)
+  /// @param rules Boss rules and warps, compiled once per blind
+  /// @return Complete score breakdown
+  static ScoreResult CalculateScore(std::span<const Card> hand,
+                                    const Card &cut, float tempMult,
+                                    float permMult,
+                                    const CompiledRuleSet &rules);
+
+  /// @brief Calculate score from pattern counts with pre-parsed rules
+  /// This is the hot path: no string parsing, hashing or allocation.
+  /// @param counts Evaluated hand pattern counts
+  /// @param cards Cards involved in the evaluation (hand + cut)
+  /// @param tempMult Temporary multiplier (capped at 10x)
+  /// @param permMult Permanent multiplier (capped at 5x)
+  /// @param rules Boss rules and warps, compiled once per blind
+  /// @return Complete score breakdown
+  static ScoreResult CalculateScore(const HandEvaluator::HandCounts &counts,
+                                    std::span<const Card> cards,
+                                    float tempMult, float permMult,
+                                    const CompiledRuleSet &rules);
+
+  /// @brief Score many hands that share rules and multipliers
+  /// Rules are parsed once for the whole batch.
+  /// @param cards Hands back to back, 5 cards each (4 hand cards, then cut)
+  /// @param tempMult Temporary multiplier (capped at 10x)
+  /// @param permMult Permanent multiplier (capped at 5x)
+  /// @param bossRules Active boss rules and warps
+  /// @param results Output, one entry per hand
+  /// @throws std::invalid_argument if cards is not a multiple of 5 or
+  /// results is too small
+  static void ScoreBatch(std::span<const Card> cards, float tempMult,
+                         float permMult,
+                         const std::vector<std::string> &bossRules,
+                         std::span<ScoreResult> results);
+
 private:
   /// @brief Apply diminishing returns for repeated category triggers
   /// @param triggerCount Number of times category triggered
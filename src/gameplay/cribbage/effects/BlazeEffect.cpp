@@ -3,7 +3,8 @@
 namespace gameplay {
 
 void BlazeEffect::apply(ScoringEngine::ScoreResult &result,
-                        const HandEvaluator::HandResult &handResult) const {
+                        const HandEvaluator::HandCounts &counts,
+                        std::span<const Card> cards) const {
   // Check categories in standard order and zero out all but first
   bool foundFirst = false;
 
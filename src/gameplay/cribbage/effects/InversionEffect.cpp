@@ -4,16 +4,16 @@
 
 namespace gameplay {
 
-void InversionEffect::apply(
-    ScoringEngine::ScoreResult &result,
-    const HandEvaluator::HandResult &handResult) const {
-  if (handResult.cards.empty()) {
+void InversionEffect::apply(ScoringEngine::ScoreResult &result,
+                            const HandEvaluator::HandCounts &counts,
+                            std::span<const Card> cards) const {
+  if (cards.empty()) {
     return;
   }
 
   // Count low cards (Ace through 5)
   int lowCardCount =
-      std::count_if(handResult.cards.begin(), handResult.cards.end(),
+      std::count_if(cards.begin(), cards.end(),
                     [](const Card &card) { return card.getRankValue() <= 5; });
 
   if (lowCardCount > 0) {
@@ -9,7 +9,8 @@ namespace gameplay {
 class InversionEffect : public WarpEffect {
 public:
   void apply(ScoringEngine::ScoreResult &result,
-             const HandEvaluator::HandResult &handResult) const override;
+             const HandEvaluator::HandCounts &counts,
+             std::span<const Card> cards) const override;
 
   std::string getName() const override { return "Inversion"; }
 
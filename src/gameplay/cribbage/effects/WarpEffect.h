@@ -4,6 +4,7 @@
 #include "../RuleType.h"
 #include "../ScoringEngine.h"
 #include <memory>
+#include <span>
 #include <string>
 
 namespace gameplay {
@@ -16,9 +17,11 @@ public:
 
   /// @brief Apply this effect to the score result
   /// @param result Score result to modify (passed by reference)
-  /// @param handResult Evaluated hand patterns (for card inspection)
+  /// @param counts Evaluated hand pattern counts
+  /// @param cards Cards involved in the evaluation (for card inspection)
   virtual void apply(ScoringEngine::ScoreResult &result,
-                     const HandEvaluator::HandResult &handResult) const = 0;
+                     const HandEvaluator::HandCounts &counts,
+                     std::span<const Card> cards) const = 0;
 
   /// @brief Get human-readable name of this effect
   virtual std::string getName() const = 0;
@@ -4,16 +4,16 @@
 
 namespace gameplay {
 
-void WildfireEffect::apply(
-    ScoringEngine::ScoreResult &result,
-    const HandEvaluator::HandResult &handResult) const {
-  if (handResult.cards.empty()) {
+void WildfireEffect::apply(ScoringEngine::ScoreResult &result,
+                           const HandEvaluator::HandCounts &counts,
+                           std::span<const Card> cards) const {
+  if (cards.empty()) {
     return;
   }
 
   // Count 5s in hand
   int fiveCount =
-      std::count_if(handResult.cards.begin(), handResult.cards.end(),
+      std::count_if(cards.begin(), cards.end(),
                     [](const Card &card) { return card.getRankValue() == 5; });
 
   if (fiveCount > 0) {
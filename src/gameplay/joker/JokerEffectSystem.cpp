@@ -1,9 +1,9 @@
 #include "JokerEffectSystem.h"
+#include "JokerProgram.h"
 #include "conditions/Condition.h"
 #include "counters/Counter.h"
 #include "effects/Effect.h"
 #include <algorithm>
-#include <sstream>
 
 namespace gameplay {
 
@@ -22,77 +22,101 @@ JokerEffectSystem::ApplyJokers(const std::vector<Joker> &jokers,
 JokerEffectSystem::EffectResult JokerEffectSystem::ApplyJokersWithStacks(
     const std::vector<std::pair<Joker, int>> &jokersWithStacks,
     const HandEvaluator::HandResult &handResult, const std::string &trigger) {
+  // One-off path: interpret the definitions directly. Compiling them here
+  // would cost more than it saves; callers that score repeatedly hold
+  // CompiledJokers (JokerRegistry does) and use ApplyCompiled.
+  EffectResult result;
+  for (const auto &[joker, stackCount] : jokersWithStacks) {
+    ApplyJoker(joker, stackCount, handResult, trigger, result);
+  }
+  return result;
+}
+
+JokerEffectSystem::EffectResult JokerEffectSystem::ApplyCompiled(
+    std::span<const std::pair<const CompiledJoker *, int>> jokersWithStacks,
+    const HandEvaluator::HandResult &handResult, const std::string &trigger) {
+  return ApplyCompiled(jokersWithStacks, HandFacts::From(handResult),
+                       CompiledJoker::TriggerMask(trigger));
+}
+
+JokerEffectSystem::EffectResult JokerEffectSystem::ApplyCompiled(
+    std::span<const std::pair<const CompiledJoker *, int>> jokersWithStacks,
+    const HandFacts &facts, uint32_t triggerMask) {
   EffectResult result;
 
   for (const auto &[joker, stackCount] : jokersWithStacks) {
-    // Check if this joker triggers on this event
-    bool shouldTrigger = false;
-    for (const auto &jokTrigger : joker.triggers) {
-      if (jokTrigger == trigger) {
-        shouldTrigger = true;
-        break;
-      }
+    if (joker->triggersOn(triggerMask)) {
+      joker->apply(facts, stackCount, result);
     }
+  }
 
-    if (!shouldTrigger) {
-      continue;
-    }
+  return result;
+}
 
-    // Evaluate all conditions
-    bool allConditionsMet = true;
-    for (const auto &condition : joker.conditions) {
-      if (!EvaluateCondition(condition, handResult)) {
-        allConditionsMet = false;
-        break;
-      }
+void JokerEffectSystem::ApplyJoker(const Joker &joker, int stackCount,
+                                   const HandEvaluator::HandResult &handResult,
+                                   const std::string &trigger,
+                                   EffectResult &result) {
+  // Check if this joker triggers on this event
+  bool shouldTrigger = false;
+  for (const auto &jokTrigger : joker.triggers) {
+    if (jokTrigger == trigger) {
+      shouldTrigger = true;
+      break;
     }
+  }
+
+  if (!shouldTrigger) {
+    return;
+  }
 
-    if (!allConditionsMet) {
-      continue;
+  // Evaluate all conditions
+  for (const auto &condition : joker.conditions) {
+    if (!EvaluateCondition(condition, handResult)) {
+      return;
     }
+  }
 
-    // Determine which effects to use: tiered or legacy
-    std::vector<JokerEffect> effectsToApply;
-    
-    if (!joker.tieredEffects.empty() && stackCount > 0) {
-      // Use tier system (GDD tiers: 1-5)
-      int tierLevel = std::min(stackCount, 5);
-      
-      // Get effects for this tier level
-      auto tierIt = joker.tieredEffects.find(tierLevel);
-      if (tierIt != joker.tieredEffects.end()) {
-        effectsToApply = tierIt->second;
-      } else {
-        // Fallback to tier 1 if specific tier not defined
-        auto tier1It = joker.tieredEffects.find(1);
-        if (tier1It != joker.tieredEffects.end()) {
-          effectsToApply = tier1It->second;
-        }
-      }
+  // Determine which effects to use: tiered or legacy
+  const std::vector<JokerEffect> *effectsToApply = nullptr;
+
+  if (!joker.tieredEffects.empty() && stackCount > 0) {
+    // Use tier system (GDD tiers: 1-5)
+    int tierLevel = std::min(stackCount, 5);
+
+    // Get effects for this tier level
+    auto tierIt = joker.tieredEffects.find(tierLevel);
+    if (tierIt != joker.tieredEffects.end()) {
+      effectsToApply = &tierIt->second;
     } else {
-      // Legacy system: multiply effects by stack count
-      effectsToApply = joker.effects;
+      // Fallback to tier 1 if specific tier not defined
+      auto tier1It = joker.tieredEffects.find(1);
+      if (tier1It != joker.tieredEffects.end()) {
+        effectsToApply = &tier1It->second;
+      }
     }
+  } else {
+    // Legacy system: multiply effects by stack count
+    effectsToApply = &joker.effects;
+  }
 
-    // Apply all effects
-    for (const auto &effect : effectsToApply) {
+  // Apply all effects
+  if (effectsToApply) {
+    // For legacy system (no tiers), multiply by stack count
+    int multiplier = joker.tieredEffects.empty() ? stackCount : 1;
+
+    for (const auto &effect : *effectsToApply) {
       EffectResult effectResult = ApplyEffect(effect, handResult);
-      
-      // For legacy system (no tiers), multiply by stack count
-      int multiplier = joker.tieredEffects.empty() ? stackCount : 1;
-      
       result.addedChips += effectResult.addedChips * multiplier;
       result.addedTempMult += effectResult.addedTempMult * multiplier;
       result.addedPermMult += effectResult.addedPermMult * multiplier;
     }
-
-    // Track if any joker ignores caps
-    if (joker.ignoresCaps) {
-      result.ignoresCaps = true;
-    }
   }
 
-  return result;
+  // Track if any joker ignores caps
+  if (joker.ignoresCaps) {
+    result.ignoresCaps = true;
+  }
 }
 
 bool JokerEffectSystem::EvaluateCondition(
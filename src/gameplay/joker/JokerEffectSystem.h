@@ -2,10 +2,15 @@
 
 #include "../cribbage/HandEvaluator.h"
 #include "Joker.h"
+#include <cstdint>
+#include <span>
 #include <vector>
 
 namespace gameplay {
 
+class CompiledJoker;
+struct HandFacts;
+
 /// @brief System for evaluating joker triggers and applying effects
 class JokerEffectSystem {
 public:
@@ -34,6 +39,7 @@ public:
                                   const std::string &trigger);
   
   /// @brief Apply all active jokers with stack counts
+  /// Interprets the definitions; for repeated scoring use ApplyCompiled.
   /// @param jokersWithStacks List of jokers paired with their stack counts
   /// @param handResult Evaluated hand data
   /// @param trigger Trigger name (e.g., "on_score")
@@ -43,7 +49,32 @@ public:
       const HandEvaluator::HandResult &handResult,
       const std::string &trigger);
 
+  /// @brief Apply pre-compiled jokers (see JokerProgram.h)
+  /// The hot path: no parsing, virtual dispatch or allocation.
+  /// @param jokersWithStacks Non-null compiled jokers with stack counts
+  /// @param handResult Evaluated hand data
+  /// @param trigger Trigger name (e.g., "on_score")
+  /// @return Aggregate effect result
+  static EffectResult ApplyCompiled(
+      std::span<const std::pair<const CompiledJoker *, int>> jokersWithStacks,
+      const HandEvaluator::HandResult &handResult,
+      const std::string &trigger);
+
+  /// @brief Apply pre-compiled jokers against pre-gathered hand facts
+  /// @param jokersWithStacks Non-null compiled jokers with stack counts
+  /// @param facts Facts for the scored hand (HandFacts::From)
+  /// @param triggerMask CompiledJoker::TriggerMask() of the trigger
+  /// @return Aggregate effect result
+  static EffectResult ApplyCompiled(
+      std::span<const std::pair<const CompiledJoker *, int>> jokersWithStacks,
+      const HandFacts &facts, uint32_t triggerMask);
+
 private:
+  /// @brief Accumulate one joker's contribution into result
+  static void ApplyJoker(const Joker &joker, int stackCount,
+                         const HandEvaluator::HandResult &handResult,
+                         const std::string &trigger, EffectResult &result);
+
   /// @brief Evaluate a single condition string
   /// @param condition Condition to evaluate (e.g., "count_15s > 0")
   /// @param handResult Hand data to check against
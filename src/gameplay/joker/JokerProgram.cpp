@@ -0,0 +1,266 @@
+#include "JokerProgram.h"
+#include "conditions/Condition.h"
+#include "conditions/CountComparisonCondition.h"
+#include "core/Logger.h"
+#include "counters/Counter.h"
+#include "effects/Effect.h"
+#include <algorithm>
+#include <limits>
+
+namespace gameplay {
+
+namespace {
+
+/// Trigger names with a reserved bit in CompiledJoker::TriggerMask
+constexpr std::string_view kTriggerNames[] = {"on_score", "on_discard",
+                                              "on_shop", "on_held"};
+
+inline int RankCount(const HandFacts &facts, int rank) {
+  return (rank >= 1 && rank <= 13) ? facts.rankCounts[rank] : 0;
+}
+
+inline int SuitCount(const HandFacts &facts, int suit) {
+  return (suit >= 0 && suit < 4) ? facts.suitCounts[suit] : 0;
+}
+
+int CountOf(CountType type, const HandFacts &facts) {
+  switch (type) {
+  case CountType::Fifteens:
+    return facts.fifteens;
+  case CountType::Pairs:
+    return facts.pairs;
+  case CountType::Runs:
+    return facts.runs;
+  case CountType::FlushCount:
+    return facts.flushCount;
+  case CountType::UniqueCategories:
+    return (facts.fifteens > 0) + (facts.pairs > 0) + (facts.runs > 0) +
+           (facts.flushCount >= 4) + facts.hasNobs;
+  }
+  return 0;
+}
+
+bool Compare(int actual, ComparisonOp op, int expected) {
+  switch (op) {
+  case ComparisonOp::Greater:
+    return actual > expected;
+  case ComparisonOp::GreaterEqual:
+    return actual >= expected;
+  case ComparisonOp::Less:
+    return actual < expected;
+  case ComparisonOp::LessEqual:
+    return actual <= expected;
+  case ComparisonOp::Equal:
+    return actual == expected;
+  case ComparisonOp::NotEqual:
+    return actual != expected;
+  }
+  return false;
+}
+
+bool Evaluate(const ConditionOp &op, const HandFacts &facts) {
+  switch (op.kind) {
+  case ConditionOp::Kind::Always:
+    return true;
+  case ConditionOp::Kind::ContainsRank:
+    return RankCount(facts, op.value) > 0;
+  case ConditionOp::Kind::ContainsSuit:
+    return SuitCount(facts, op.value) > 0;
+  case ConditionOp::Kind::HasNobs:
+    return facts.hasNobs;
+  case ConditionOp::Kind::HandTotal21:
+    return facts.valueSum == 21;
+  case ConditionOp::Kind::Compare:
+    return Compare(CountOf(op.count, facts), op.cmp, op.value);
+  }
+  return false;
+}
+
+int Count(const CounterOp &op, const HandFacts &facts) {
+  switch (op.kind) {
+  case CounterOp::Kind::Constant:
+    return 1;
+  case CounterOp::Kind::Fifteens:
+    return facts.fifteens;
+  case CounterOp::Kind::Pairs:
+    return facts.pairs;
+  case CounterOp::Kind::Runs:
+    return facts.runs;
+  case CounterOp::Kind::CardsInRuns:
+    return facts.cardsInRuns;
+  case CounterOp::Kind::CardCount:
+    return facts.cardCount;
+  case CounterOp::Kind::Even:
+    return facts.evenCount;
+  case CounterOp::Kind::Odd:
+    return facts.oddCount;
+  case CounterOp::Kind::Face:
+    return facts.faceCount;
+  case CounterOp::Kind::Rank:
+    return RankCount(facts, op.value);
+  case CounterOp::Kind::Suit:
+    return SuitCount(facts, op.value);
+  }
+  return 1;
+}
+
+inline uint8_t Clamp8(size_t n) {
+  return static_cast<uint8_t>(
+      std::min<size_t>(n, std::numeric_limits<uint8_t>::max()));
+}
+
+} // namespace
+
+// ===== HAND FACTS =====
+
+HandFacts HandFacts::From(const HandEvaluator::HandResult &hand) {
+  HandFacts facts;
+  facts.fifteens = Clamp8(hand.fifteens.size());
+  facts.pairs = Clamp8(hand.pairs.size());
+  facts.runs = Clamp8(hand.runs.size());
+  facts.flushCount = Clamp8(hand.flushCount);
+  facts.hasNobs = hand.hasNobs;
+  facts.cardCount = Clamp8(hand.cards.size());
+
+  size_t inRuns = 0;
+  for (const auto &run : hand.runs) {
+    inRuns += run.size();
+  }
+  facts.cardsInRuns = Clamp8(inRuns);
+
+  facts.addCards(hand.cards);
+  return facts;
+}
+
+HandFacts HandFacts::From(const HandEvaluator::HandCounts &counts,
+                          std::span<const Card> cards) {
+  HandFacts facts;
+  facts.fifteens = counts.fifteens;
+  facts.pairs = counts.pairs;
+  facts.runs = counts.runs;
+  facts.cardsInRuns = Clamp8(counts.CardsInRuns());
+  facts.flushCount = counts.flushCount;
+  facts.hasNobs = counts.hasNobs;
+  facts.cardCount = Clamp8(cards.size());
+
+  facts.addCards(cards);
+  return facts;
+}
+
+void HandFacts::addCards(std::span<const Card> cards) {
+  for (const Card &card : cards) {
+    int rank = card.getRankValue();
+    evenCount += (rank % 2 == 0);
+    oddCount += (rank % 2 != 0);
+    faceCount += (rank >= 11);
+    rankCounts[rank]++;
+    suitCounts[card.getSuitValue()]++;
+    valueSum += card.getValue();
+  }
+}
+
+// ===== COMPILATION =====
+
+uint32_t CompiledJoker::TriggerMask(std::string_view trigger) {
+  for (size_t i = 0; i < std::size(kTriggerNames); ++i) {
+    if (kTriggerNames[i] == trigger) {
+      return 1u << i;
+    }
+  }
+  return 0;
+}
+
+CompiledJoker CompiledJoker::Compile(const Joker &joker) {
+  CompiledJoker compiled;
+  compiled.m_ignoresCaps = joker.ignoresCaps;
+  compiled.m_tiered = !joker.tieredEffects.empty();
+
+  for (const auto &trigger : joker.triggers) {
+    uint32_t bit = TriggerMask(trigger);
+    if (bit == 0) {
+      LOG_WARN("Joker '%s': unknown trigger '%s' (ignored)", joker.id.c_str(),
+               trigger.c_str());
+    }
+    compiled.m_triggerMask |= bit;
+  }
+
+  for (const auto &condition : joker.conditions) {
+    compiled.m_conditions.push_back(Condition::parse(condition)->compile());
+  }
+
+  auto appendEffects = [&compiled](const std::vector<JokerEffect> &effects) {
+    Range range;
+    range.begin = static_cast<uint16_t>(compiled.m_effects.size());
+    range.count = static_cast<uint16_t>(effects.size());
+    for (const auto &effect : effects) {
+      EffectOp op = Effect::create(effect.type, effect.value)->compile();
+      op.counter = Counter::parse(effect.per)->compile();
+      compiled.m_effects.push_back(op);
+    }
+    return range;
+  };
+
+  compiled.m_effectRanges[0] = appendEffects(joker.effects);
+
+  // Resolve tiers now: a missing tier falls back to tier 1 (or nothing)
+  for (const auto &[level, effects] : joker.tieredEffects) {
+    if (level >= 1 && level <= kTierCount) {
+      compiled.m_effectRanges[level] = appendEffects(effects);
+    }
+  }
+  auto tier1 = joker.tieredEffects.find(1);
+  for (int level = 2; level <= kTierCount; ++level) {
+    if (tier1 != joker.tieredEffects.end() &&
+        joker.tieredEffects.find(level) == joker.tieredEffects.end()) {
+      compiled.m_effectRanges[level] = compiled.m_effectRanges[1];
+    }
+  }
+
+  return compiled;
+}
+
+// ===== EVALUATION =====
+
+void CompiledJoker::apply(const HandFacts &facts, int stackCount,
+                          JokerEffectSystem::EffectResult &result) const {
+  for (const auto &condition : m_conditions) {
+    if (!Evaluate(condition, facts)) {
+      return;
+    }
+  }
+
+  // Tiered jokers pick a tier by stack count; legacy ones scale by it
+  Range range = m_effectRanges[0];
+  int multiplier = stackCount;
+  if (m_tiered) {
+    multiplier = 1;
+    if (stackCount > 0) {
+      range = m_effectRanges[std::min(stackCount, kTierCount)];
+    }
+  }
+
+  for (uint16_t i = range.begin; i < range.begin + range.count; ++i) {
+    const EffectOp &effect = m_effects[i];
+    int count = Count(effect.counter, facts);
+
+    switch (effect.kind) {
+    case EffectOp::Kind::None:
+      break;
+    case EffectOp::Kind::AddChips:
+      result.addedChips += static_cast<int>(effect.value * count) * multiplier;
+      break;
+    case EffectOp::Kind::AddTempMult:
+      result.addedTempMult += effect.value * count * multiplier;
+      break;
+    case EffectOp::Kind::AddPermMult:
+      result.addedPermMult += effect.value * count * multiplier;
+      break;
+    }
+  }
+
+  if (m_ignoresCaps) {
+    result.ignoresCaps = true;
+  }
+}
+
+} // namespace gameplay
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "JokerEffectSystem.h"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace gameplay {
+
+enum class CountType;
+enum class ComparisonOp;
+
+/// @brief Per-hand facts every compiled condition and counter reads from
+/// Built once per scoring call so each instruction is a table lookup.
+struct HandFacts {
+  uint8_t fifteens = 0;
+  uint8_t pairs = 0;
+  uint8_t runs = 0;
+  uint8_t cardsInRuns = 0;
+  uint8_t flushCount = 0;
+  bool hasNobs = false;
+  uint8_t cardCount = 0;
+  uint8_t evenCount = 0;
+  uint8_t oddCount = 0;
+  uint8_t faceCount = 0;
+  int valueSum = 0;
+
+  /// Cards per rank (index 1-13; 0 unused)
+  std::array<uint8_t, 14> rankCounts{};
+
+  /// Cards per suit (Card::Suit order)
+  std::array<uint8_t, 4> suitCounts{};
+
+  /// @brief Gather facts from an evaluated hand
+  static HandFacts From(const HandEvaluator::HandResult &hand);
+
+  /// @brief Gather facts from pattern counts (e.g. a ScoreTable lookup)
+  /// @param counts Pattern counts for the hand
+  /// @param cards Cards involved in the evaluation (hand + cut)
+  static HandFacts From(const HandEvaluator::HandCounts &counts,
+                        std::span<const Card> cards);
+
+private:
+  /// @brief Accumulate per-card tallies (parity, faces, ranks, suits)
+  void addCards(std::span<const Card> cards);
+};
+
+/// @brief Compiled form of a Condition (see conditions/)
+struct ConditionOp {
+  enum class Kind : uint8_t {
+    Always,
+    ContainsRank,
+    ContainsSuit,
+    HasNobs,
+    HandTotal21,
+    Compare,
+  };
+
+  Kind kind = Kind::Always;
+  CountType count{};
+  ComparisonOp cmp{};
+
+  /// Rank, suit or comparison threshold depending on kind
+  int value = 0;
+};
+
+/// @brief Compiled form of a Counter (see counters/)
+struct CounterOp {
+  enum class Kind : uint8_t {
+    Constant,
+    Fifteens,
+    Pairs,
+    Runs,
+    CardsInRuns,
+    CardCount,
+    Even,
+    Odd,
+    Face,
+    Rank,
+    Suit,
+  };
+
+  Kind kind = Kind::Constant;
+
+  /// Rank or suit for Rank/Suit kinds
+  int value = 0;
+};
+
+/// @brief Compiled form of an Effect plus its "per" counter (see effects/)
+struct EffectOp {
+  enum class Kind : uint8_t { None, AddChips, AddTempMult, AddPermMult };
+
+  Kind kind = Kind::None;
+  CounterOp counter;
+  float value = 0.0f;
+};
+
+/// @brief A Joker flattened into POD instructions
+/// Compile() runs the string parsers (Condition::parse, Counter::parse,
+/// Effect::create) once; apply() is a switch over the resulting ops with no
+/// virtual calls, string work or allocation.
+class CompiledJoker {
+public:
+  /// Tiers supported by the stack system (GDD: 1-5)
+  static constexpr int kTierCount = 5;
+
+  /// @brief Compile a parsed joker definition
+  static CompiledJoker Compile(const Joker &joker);
+
+  /// @brief Bit for a trigger name ("on_score", ...), 0 if unknown
+  static uint32_t TriggerMask(std::string_view trigger);
+
+  /// @brief Whether this joker fires for the given TriggerMask() bit
+  bool triggersOn(uint32_t triggerMask) const {
+    return (m_triggerMask & triggerMask) != 0;
+  }
+
+  /// @brief Accumulate this joker's contribution (trigger already checked)
+  /// @param facts Facts for the scored hand
+  /// @param stackCount Number of stacked copies (selects tier or multiplier)
+  /// @param result Result to add into
+  void apply(const HandFacts &facts, int stackCount,
+             JokerEffectSystem::EffectResult &result) const;
+
+private:
+  struct Range {
+    uint16_t begin = 0;
+    uint16_t count = 0;
+  };
+
+  uint32_t m_triggerMask = 0;
+  bool m_ignoresCaps = false;
+  bool m_tiered = false;
+
+  std::vector<ConditionOp> m_conditions;
+
+  /// Legacy and tier effect lists stored back to back
+  std::vector<EffectOp> m_effects;
+
+  /// [0] = legacy effects, [t] = effects for tier t (tier 1 fallback baked in)
+  std::array<Range, kTierCount + 1> m_effectRanges{};
+};
+
+} // namespace gameplay
@@ -0,0 +1,115 @@
+#include "JokerRegistry.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace gameplay {
+
+namespace {
+
+/// Canonical registry key so "a/b.json" and "a//b.json" share a handle
+std::string NormalizePath(const std::string &path) {
+  return fs::path(path).lexically_normal().generic_string();
+}
+
+} // namespace
+
+JokerRegistry &JokerRegistry::getInstance() {
+  static JokerRegistry instance;
+  return instance;
+}
+
+int JokerRegistry::loadDirectory(const std::string &directory) {
+  std::error_code ec;
+  if (!fs::is_directory(directory, ec)) {
+    LOG_WARN("JokerRegistry: directory not found: %s", directory.c_str());
+    return 0;
+  }
+
+  // Sort so handle assignment does not depend on directory order
+  std::vector<std::string> files;
+  for (const auto &entry : fs::directory_iterator(directory, ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".json") {
+      files.push_back(entry.path().generic_string());
+    }
+  }
+  std::sort(files.begin(), files.end());
+
+  int loaded = 0;
+  for (const auto &file : files) {
+    try {
+      intern(file);
+      ++loaded;
+    } catch (const std::exception &e) {
+      LOG_WARN("JokerRegistry: skipping %s (%s)", file.c_str(), e.what());
+    }
+  }
+  return loaded;
+}
+
+int JokerRegistry::intern(const std::string &jsonPath) {
+  std::string key = NormalizePath(jsonPath);
+
+  auto it = m_byPath.find(key);
+  if (it != m_byPath.end()) {
+    return it->second;
+  }
+
+  // Throws on I/O or parse failure; nothing is registered in that case
+  Joker joker = Joker::FromJSON(key);
+
+  CompiledJoker compiled = CompiledJoker::Compile(joker);
+
+  int handle = static_cast<int>(m_entries.size());
+  m_byId.emplace(joker.id, handle);
+  m_entries.push_back({key, std::move(joker), std::move(compiled)});
+  m_byPath.emplace(std::move(key), handle);
+  return handle;
+}
+
+int JokerRegistry::find(const std::string &jsonPath) const {
+  auto it = m_byPath.find(NormalizePath(jsonPath));
+  return it != m_byPath.end() ? it->second : kInvalidHandle;
+}
+
+int JokerRegistry::findById(const std::string &id) const {
+  auto it = m_byId.find(id);
+  return it != m_byId.end() ? it->second : kInvalidHandle;
+}
+
+int JokerRegistry::reload() {
+  int reloaded = 0;
+  for (auto &entry : m_entries) {
+    try {
+      Joker joker = Joker::FromJSON(entry.path);
+      entry.compiled = CompiledJoker::Compile(joker);
+      entry.joker = std::move(joker);
+      ++reloaded;
+    } catch (const std::exception &e) {
+      LOG_WARN("JokerRegistry: keeping previous %s (%s)", entry.path.c_str(),
+               e.what());
+    }
+  }
+
+  rebuildIdIndex();
+  return reloaded;
+}
+
+void JokerRegistry::clear() {
+  m_entries.clear();
+  m_byPath.clear();
+  m_byId.clear();
+}
+
+void JokerRegistry::rebuildIdIndex() {
+  // First handle wins, matching intern()'s emplace semantics
+  m_byId.clear();
+  for (int i = 0; i < static_cast<int>(m_entries.size()); ++i) {
+    m_byId.emplace(m_entries[i].joker.id, i);
+  }
+}
+
+} // namespace gameplay
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Joker.h"
+#include "JokerProgram.h"
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+namespace gameplay {
+
+/// @brief Process-wide cache of parsed joker definitions
+/// Joker JSON is read and parsed once, then referenced by a small integer
+/// handle so scoring never touches the filesystem. Each joker is also
+/// compiled once into a CompiledJoker for allocation-free scoring. Handles
+/// stay valid across reload(); only the definitions behind them change.
+class JokerRegistry {
+public:
+  /// Handle returned for paths that could not be loaded
+  static constexpr int kInvalidHandle = -1;
+
+  /// @brief Get the singleton registry
+  static JokerRegistry &getInstance();
+
+  /// @brief Load every *.json file in a directory
+  /// Files that fail to parse are skipped with a warning.
+  /// @param directory Directory to scan (non-recursive)
+  /// @return Number of jokers loaded
+  int loadDirectory(const std::string &directory);
+
+  /// @brief Get the handle for a joker file, loading it on first use
+  /// @param jsonPath Path to the joker JSON file
+  /// @return Stable handle (throws std::runtime_error if loading fails)
+  int intern(const std::string &jsonPath);
+
+  /// @brief Look up a handle without loading
+  /// @return Handle, or kInvalidHandle if the path was never interned
+  int find(const std::string &jsonPath) const;
+
+  /// @brief Look up a handle by joker id (the "id" JSON field)
+  /// @return Handle, or kInvalidHandle if no loaded joker has this id
+  int findById(const std::string &id) const;
+
+  /// @brief Check whether a handle refers to a loaded joker
+  bool isValid(int handle) const {
+    return handle >= 0 && handle < static_cast<int>(m_entries.size());
+  }
+
+  /// @brief Get the joker definition for a handle (handle must be valid)
+  /// References stay valid while more jokers are interned; clear()
+  /// invalidates them.
+  const Joker &get(int handle) const { return m_entries[handle].joker; }
+
+  /// @brief Get the compiled program for a handle (handle must be valid)
+  const CompiledJoker &getCompiled(int handle) const {
+    return m_entries[handle].compiled;
+  }
+
+  /// @brief Get the source path for a handle (handle must be valid)
+  const std::string &getPath(int handle) const {
+    return m_entries[handle].path;
+  }
+
+  /// @brief Re-read every interned file (hot reload)
+  /// Handles are preserved. Files that fail to parse keep their previous
+  /// definition and a warning is logged.
+  /// @return Number of jokers successfully reloaded
+  int reload();
+
+  /// @brief Number of interned jokers
+  int size() const { return static_cast<int>(m_entries.size()); }
+
+  /// @brief Drop all jokers (invalidates every handle)
+  void clear();
+
+private:
+  JokerRegistry() = default;
+  JokerRegistry(const JokerRegistry &) = delete;
+  JokerRegistry &operator=(const JokerRegistry &) = delete;
+
+  struct Entry {
+    std::string path;
+    Joker joker;
+    CompiledJoker compiled;
+  };
+
+  void rebuildIdIndex();
+
+  /// Deque so interning never moves jokers already handed out by pointer
+  std::deque<Entry> m_entries;
+  std::unordered_map<std::string, int> m_byPath;
+  std::unordered_map<std::string, int> m_byId;
+};
+
+} // namespace gameplay
@@ -24,6 +24,12 @@ public:
   std::string getDescription() const override {
     return "has_nobs";
   }
+
+  ConditionOp compile() const override {
+    ConditionOp op;
+    op.kind = ConditionOp::Kind::HasNobs;
+    return op;
+  }
 };
 
 /**
@@ -42,6 +48,12 @@ public:
   std::string getDescription() const override {
     return "hand_total_21";
   }
+
+  ConditionOp compile() const override {
+    ConditionOp op;
+    op.kind = ConditionOp::Kind::HandTotal21;
+    return op;
+  }
 };
 
 } // namespace gameplay
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../cribbage/HandEvaluator.h"
+#include "../JokerProgram.h"
 #include <memory>
 #include <string>
 
@@ -20,6 +21,9 @@ public:
   /// @brief Get human-readable description of this condition
   virtual std::string getDescription() const = 0;
 
+  /// @brief Lower this condition to its POD form for CompiledJoker
+  virtual ConditionOp compile() const = 0;
+
   /// @brief Parse condition string and create appropriate Condition instance
   /// @param conditionStr Condition string from JSON (e.g., "contains_rank:7",
   /// "count_15s > 0")
@@ -37,6 +41,8 @@ public:
   }
 
   std::string getDescription() const override { return "Always true"; }
+
+  ConditionOp compile() const override { return {}; }
 };
 
 } // namespace gameplay
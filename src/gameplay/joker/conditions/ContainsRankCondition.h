@@ -27,6 +27,13 @@ public:
   std::string getDescription() const override {
     return "Contains rank " + std::to_string(targetRank_);
   }
+
+  ConditionOp compile() const override {
+    ConditionOp op;
+    op.kind = ConditionOp::Kind::ContainsRank;
+    op.value = targetRank_;
+    return op;
+  }
 };
 
 } // namespace gameplay
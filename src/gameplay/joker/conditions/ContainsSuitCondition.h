@@ -30,6 +30,13 @@ public:
     }
     return "Contains suit (unknown)";
   }
+
+  ConditionOp compile() const override {
+    ConditionOp op;
+    op.kind = ConditionOp::Kind::ContainsSuit;
+    op.value = targetSuit_;
+    return op;
+  }
 };
 
 } // namespace gameplay
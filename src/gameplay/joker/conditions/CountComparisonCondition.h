@@ -45,6 +45,15 @@ public:
            std::to_string(value_);
   }
 
+  ConditionOp compile() const override {
+    ConditionOp op;
+    op.kind = ConditionOp::Kind::Compare;
+    op.count = type_;
+    op.cmp = op_;
+    op.value = value_;
+    return op;
+  }
+
 private:
   /// @brief Get count value from hand based on type
   int getCount(CountType type, const HandEvaluator::HandResult &hand) const {
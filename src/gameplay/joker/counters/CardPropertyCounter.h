@@ -71,6 +71,30 @@ public:
     return total;
   }
 
+  CounterOp compile() const override {
+    CounterOp op;
+    switch (m_Type) {
+    case PropertyType::Even:
+      op.kind = CounterOp::Kind::Even;
+      break;
+    case PropertyType::Odd:
+      op.kind = CounterOp::Kind::Odd;
+      break;
+    case PropertyType::Face:
+      op.kind = CounterOp::Kind::Face;
+      break;
+    case PropertyType::SpecificRank:
+      op.kind = CounterOp::Kind::Rank;
+      op.value = m_Rank;
+      break;
+    case PropertyType::SpecificSuit:
+      op.kind = CounterOp::Kind::Suit;
+      op.value = m_Suit;
+      break;
+    }
+    return op;
+  }
+
 private:
   PropertyType m_Type;
   int m_Rank;  // For SpecificRank counter
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gameplay/cribbage/HandEvaluator.h"
+#include "gameplay/joker/JokerProgram.h"
 #include <memory>
 #include <string>
 
@@ -26,6 +27,11 @@ public:
    * @return Number of occurrences (multiplier for joker effects)
    */
   virtual int count(const HandEvaluator::HandResult &handResult) const = 0;
+
+  /**
+   * Lower this counter to its POD form for CompiledJoker
+   */
+  virtual CounterOp compile() const = 0;
   
   /**
    * Factory method - parses string and creates appropriate Counter
@@ -44,6 +50,8 @@ public:
   int count(const HandEvaluator::HandResult &handResult) const override {
     return 1;
   }
+
+  CounterOp compile() const override { return {}; }
 };
 
 } // namespace gameplay
@@ -47,6 +47,28 @@ public:
     return 1; // Default fallback
   }
 
+  CounterOp compile() const override {
+    CounterOp op;
+    switch (m_Type) {
+    case PatternType::Fifteens:
+      op.kind = CounterOp::Kind::Fifteens;
+      break;
+    case PatternType::Pairs:
+      op.kind = CounterOp::Kind::Pairs;
+      break;
+    case PatternType::Runs:
+      op.kind = CounterOp::Kind::Runs;
+      break;
+    case PatternType::CardsInRuns:
+      op.kind = CounterOp::Kind::CardsInRuns;
+      break;
+    case PatternType::CardCount:
+      op.kind = CounterOp::Kind::CardCount;
+      break;
+    }
+    return op;
+  }
+
 private:
   PatternType m_Type;
 };
@@ -22,6 +22,13 @@ public:
   
   float getValue() const override { return m_Value; }
 
+  EffectOp compile() const override {
+    EffectOp op;
+    op.kind = EffectOp::Kind::AddChips;
+    op.value = m_Value;
+    return op;
+  }
+
 private:
   float m_Value;
 };
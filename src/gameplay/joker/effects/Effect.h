@@ -2,6 +2,7 @@
 
 #include "gameplay/cribbage/HandEvaluator.h"
 #include "gameplay/joker/JokerEffectSystem.h"
+#include "gameplay/joker/JokerProgram.h"
 #include <memory>
 #include <string>
 
@@ -41,6 +42,12 @@ public:
    * Get the effect value
    */
   virtual float getValue() const = 0;
+
+  /**
+   * Lower this effect to its POD form for CompiledJoker
+   * (the "per" counter is filled in by the caller)
+   */
+  virtual EffectOp compile() const = 0;
 };
 
 /**
@@ -54,6 +61,8 @@ public:
   }
   
   float getValue() const override { return 0.0f; }
+
+  EffectOp compile() const override { return {}; }
 };
 
 } // namespace gameplay
@@ -0,0 +1,222 @@
+#include "graphics/ParticlePool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int kColumnCount = static_cast<int>(ParticlePool::Column::Count);
+constexpr int kBlock = ParticlePool::kBlock;
+
+// Degrees to radians
+float DegToRad(float deg) { return deg * 3.14159265f / 180.0f; }
+
+// Linear interpolation
+float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+int RoundUpToBlock(int count) { return (count + kBlock - 1) / kBlock * kBlock; }
+
+// The kernels below take every column as a separate restrict pointer and
+// walk whole blocks (count is padded), so each inner loop vectorizes with
+// no aliasing checks or scalar tail. Padding lanes compute garbage that is
+// never read.
+
+void Integrate(int count, float dt, float gravityX, float gravityY,
+               float *__restrict x, float *__restrict y, float *__restrict vx,
+               float *__restrict vy, float *__restrict life,
+               float *__restrict rotation,
+               const float *__restrict rotationSpeed) {
+  const float dvx = gravityX * dt;
+  const float dvy = gravityY * dt;
+  for (int base = 0; base < count; base += kBlock) {
+    for (int i = base; i < base + kBlock; ++i) {
+      vx[i] += dvx;
+      vy[i] += dvy;
+      x[i] += vx[i] * dt;
+      y[i] += vy[i] * dt;
+      life[i] -= dt;
+      rotation[i] += rotationSpeed[i] * dt;
+    }
+  }
+}
+
+void InterpolateSize(int count, const float *__restrict life,
+                     const float *__restrict invMaxLife,
+                     const float *__restrict startSize,
+                     const float *__restrict endSize,
+                     float *__restrict size) {
+  for (int base = 0; base < count; base += kBlock) {
+    for (int i = base; i < base + kBlock; ++i) {
+      // 0 = just spawned, 1 = about to die
+      float progress = 1.0f - life[i] * invMaxLife[i];
+      size[i] = startSize[i] + (endSize[i] - startSize[i]) * progress;
+    }
+  }
+}
+
+void InterpolateColor(int count, const float *__restrict life,
+                      const float *__restrict invMaxLife,
+                      const float *__restrict startR,
+                      const float *__restrict startG,
+                      const float *__restrict startB,
+                      const float *__restrict startA,
+                      const float *__restrict endR,
+                      const float *__restrict endG,
+                      const float *__restrict endB,
+                      const float *__restrict endA, float *__restrict r,
+                      float *__restrict g, float *__restrict b,
+                      float *__restrict a) {
+  for (int base = 0; base < count; base += kBlock) {
+    for (int i = base; i < base + kBlock; ++i) {
+      float progress = 1.0f - life[i] * invMaxLife[i];
+      r[i] = startR[i] + (endR[i] - startR[i]) * progress;
+      g[i] = startG[i] + (endG[i] - startG[i]) * progress;
+      b[i] = startB[i] + (endB[i] - startB[i]) * progress;
+      a[i] = startA[i] + (endA[i] - startA[i]) * progress;
+    }
+  }
+}
+
+} // namespace
+
+ParticlePool::ParticlePool(int capacity)
+    : m_Capacity(capacity > 0 ? capacity : 0),
+      m_Stride(RoundUpToBlock(m_Capacity)),
+      m_Data(static_cast<size_t>(m_Stride) * kColumnCount, 0.0f) {}
+
+int ParticlePool::emit(const EmitterConfig &config, int count,
+                       ParticleRng &rng) {
+  const int begin = m_Size;
+  const int end = begin + std::clamp(count, 0, m_Capacity - m_Size);
+  if (begin == end) {
+    return 0;
+  }
+  m_Size = end;
+
+  // The new particles are the contiguous block [begin, end). Each column is
+  // written in its own loop: constant columns become plain fills, and the
+  // random ones draw from the emitter's generator in a tight loop.
+  auto fill = [&](Column c, float value) {
+    std::fill(column(c) + begin, column(c) + end, value);
+  };
+
+  // Random position within spawn area (point emitters skip the draws)
+  auto scatter = [&](Column c, float center, float extent) {
+    if (extent == 0.0f) {
+      fill(c, center);
+      return;
+    }
+    float *values = column(c);
+    for (int i = begin; i < end; ++i) {
+      values[i] = center + (rng.next01() - 0.5f) * extent;
+    }
+  };
+  scatter(Column::X, config.x, config.width);
+  scatter(Column::Y, config.y, config.height);
+
+  // Random velocity within direction cone
+  float *velX = column(Column::VelX);
+  float *velY = column(Column::VelY);
+  for (int i = begin; i < end; ++i) {
+    float speed = Lerp(config.minSpeed, config.maxSpeed, rng.next01());
+    float angle = config.direction + (rng.next01() - 0.5f) * config.spread;
+    float rad = DegToRad(angle);
+    velX[i] = std::cos(rad) * speed;
+    velY[i] = -std::sin(rad) * speed; // Y increases downward
+  }
+
+  // Lifetime
+  float *life = column(Column::Life);
+  float *invMaxLife = column(Column::InvMaxLife);
+  for (int i = begin; i < end; ++i) {
+    life[i] = Lerp(config.minLife, config.maxLife, rng.next01());
+    invMaxLife[i] = 1.0f / life[i];
+  }
+
+  // Size with variation
+  if (config.sizeVariation == 0.0f) {
+    fill(Column::StartSize, config.startSize);
+    fill(Column::EndSize, config.endSize);
+    fill(Column::Size, config.startSize);
+  } else {
+    float *startSize = column(Column::StartSize);
+    float *endSize = column(Column::EndSize);
+    float *size = column(Column::Size);
+    for (int i = begin; i < end; ++i) {
+      float sizeVar = (rng.next01() - 0.5f) * 2.0f * config.sizeVariation;
+      startSize[i] = size[i] = config.startSize + sizeVar;
+      endSize[i] = config.endSize + sizeVar;
+    }
+  }
+
+  // Color
+  fill(Column::R, config.r);
+  fill(Column::G, config.g);
+  fill(Column::B, config.b);
+  fill(Column::A, config.a);
+  fill(Column::StartR, config.r);
+  fill(Column::StartG, config.g);
+  fill(Column::StartB, config.b);
+  fill(Column::StartA, config.a);
+  fill(Column::EndR, config.endR);
+  fill(Column::EndG, config.endG);
+  fill(Column::EndB, config.endB);
+  fill(Column::EndA, config.endA);
+
+  // Rotation (optional)
+  fill(Column::Rotation, 0.0f);
+  fill(Column::RotationSpeed, 0.0f);
+  return end - begin;
+}
+
+void ParticlePool::update(const EmitterConfig &config, float dt) {
+  advance(config, dt, 0, m_Size);
+  removeExpired();
+}
+
+void ParticlePool::advance(const EmitterConfig &config, float dt, int begin,
+                           int end) {
+  if (begin >= end) {
+    return;
+  }
+
+  // Whole blocks: a trailing partial block only runs into padding, since
+  // end is either block-aligned or the live size
+  int count = RoundUpToBlock(end) - begin;
+  auto at = [&](Column c) { return column(c) + begin; };
+
+  Integrate(count, dt, config.gravityX, config.gravityY, at(Column::X),
+            at(Column::Y), at(Column::VelX), at(Column::VelY),
+            at(Column::Life), at(Column::Rotation), at(Column::RotationSpeed));
+
+  // Expired particles are interpolated too (progress past 1); they are
+  // removed before anything reads them
+  InterpolateSize(count, at(Column::Life), at(Column::InvMaxLife),
+                  at(Column::StartSize), at(Column::EndSize),
+                  at(Column::Size));
+  if (config.colorInterpolation) {
+    InterpolateColor(count, at(Column::Life), at(Column::InvMaxLife),
+                     at(Column::StartR), at(Column::StartG),
+                     at(Column::StartB), at(Column::StartA),
+                     at(Column::EndR), at(Column::EndG), at(Column::EndB),
+                     at(Column::EndA), at(Column::R), at(Column::G),
+                     at(Column::B), at(Column::A));
+  }
+}
+
+void ParticlePool::removeExpired() {
+  const float *life = column(Column::Life);
+  int i = 0;
+  while (i < m_Size) {
+    if (life[i] > 0.0f) {
+      ++i;
+      continue;
+    }
+    // Swap-remove: the last live particle takes this slot (and is checked
+    // on the next iteration)
+    --m_Size;
+    for (int c = 0; c < kColumnCount; ++c) {
+      float *values = m_Data.data() + c * m_Stride;
+      values[i] = values[m_Size];
+    }
+  }
+}
@@ -1,6 +1,8 @@
 #include "graphics/ParticleSystem.h"
 #include "core/Logger.h"
+#include "core/ParallelFor.h"
 #include "graphics/SpriteRenderer.h"
+#include <algorithm>
 #include <cmath>
 
 extern "C" {
@@ -9,15 +11,25 @@ extern "C" {
 #include <lualib.h>
 }
 
-// Degrees to radians
-static float DegToRad(float deg) { return deg * 3.14159265f / 180.0f; }
+namespace {
 
-// Linear interpolation
-static float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+// Particles per job; big emitters are split into several chunks. A
+// multiple of ParticlePool::kBlock, as ParticlePool::advance requires.
+constexpr int kChunkSize = 4096;
+
+// Below this many live particles the jobs run on the calling thread:
+// starting workers would cost more than the update
+constexpr int kParallelThreshold = 16384;
+
+int ThreadsFor(int particles) {
+  return particles >= kParallelThreshold ? 0 : 1;
+}
+
+} // namespace
 
 ParticleSystem::ParticleSystem()
     : m_Renderer(nullptr), m_NextEmitterId(1), m_DefaultTextureId(0),
-      m_Rng(std::random_device{}()), m_Dist01(0.0f, 1.0f) {}
+      m_Rng(std::random_device{}()) {}
 
 ParticleSystem::~ParticleSystem() {
   // Cleanup handled in Destroy()
@@ -45,14 +57,10 @@ int ParticleSystem::CreateEmitter(const EmitterConfig &config) {
 
   Emitter emitter;
   emitter.config = config;
-  emitter.particles.resize(config.maxParticles);
+  emitter.particles = ParticlePool(config.maxParticles);
+  emitter.rng = ParticleRng(m_Rng(), static_cast<uint64_t>(id));
   emitter.spawnAccumulator = 0;
 
-  // Initialize all particles as inactive
-  for (auto &p : emitter.particles) {
-    p.active = false;
-  }
-
   m_Emitters[id] = std::move(emitter);
 
   LOG_DEBUG("Created particle emitter %d (max particles: %d)", id,
@@ -97,160 +105,114 @@ void ParticleSystem::Burst(int id, int count) {
     return;
 
   Emitter &emitter = it->second;
-  for (int i = 0; i < count; ++i) {
-    SpawnParticle(emitter);
-  }
+  emitter.particles.emit(emitter.config, count, emitter.rng);
 }
 
-void ParticleSystem::SpawnParticle(Emitter &emitter) {
-  const EmitterConfig &config = emitter.config;
-
-  // Find an inactive particle in the pool
-  Particle *p = nullptr;
-  for (auto &particle : emitter.particles) {
-    if (!particle.active) {
-      p = &particle;
-      break;
+int ParticleSystem::BuildChunks() {
+  m_ActiveEmitters.clear();
+  m_Chunks.clear();
+  int total = 0;
+  for (auto &pair : m_Emitters) {
+    int index = static_cast<int>(m_ActiveEmitters.size());
+    m_ActiveEmitters.push_back(&pair.second);
+    int size = pair.second.particles.size();
+    for (int begin = 0; begin < size; begin += kChunkSize) {
+      int end = std::min(begin + kChunkSize, size);
+      m_Chunks.push_back({index, begin, end, total + begin});
     }
+    total += size;
   }
-
-  if (!p)
-    return; // Pool exhausted
-
-  // Initialize particle
-  p->active = true;
-
-  // Random position within spawn area
-  float offsetX = (m_Dist01(m_Rng) - 0.5f) * config.width;
-  float offsetY = (m_Dist01(m_Rng) - 0.5f) * config.height;
-  p->x = config.x + offsetX;
-  p->y = config.y + offsetY;
-
-  // Random velocity within direction cone
-  float speed = Lerp(config.minSpeed, config.maxSpeed, m_Dist01(m_Rng));
-  float angle = config.direction + (m_Dist01(m_Rng) - 0.5f) * config.spread;
-  float rad = DegToRad(angle);
-  p->vx = cos(rad) * speed;
-  p->vy = -sin(rad) * speed; // Negative because Y increases downward
-
-  // Lifetime
-  p->life = Lerp(config.minLife, config.maxLife, m_Dist01(m_Rng));
-  p->maxLife = p->life;
-
-  // Size with variation
-  float sizeVar = (m_Dist01(m_Rng) - 0.5f) * 2.0f * config.sizeVariation;
-  p->startSize = config.startSize + sizeVar;
-  p->endSize = config.endSize + sizeVar;
-  p->size = p->startSize;
-
-  // Color
-  p->startR = config.r;
-  p->startG = config.g;
-  p->startB = config.b;
-  p->startA = config.a;
-  p->endR = config.endR;
-  p->endG = config.endG;
-  p->endB = config.endB;
-  p->endA = config.endA;
-  p->r = p->startR;
-  p->g = p->startG;
-  p->b = p->startB;
-  p->a = p->startA;
-
-  // Rotation (optional)
-  p->rotation = 0;
-  p->rotationSpeed = 0;
-}
-
-void ParticleSystem::UpdateParticle(Particle &p, const EmitterConfig &config,
-                                    float dt) {
-  // Apply acceleration
-  p.vx += config.gravityX * dt;
-  p.vy += config.gravityY * dt;
-
-  // Update position
-  p.x += p.vx * dt;
-  p.y += p.vy * dt;
-
-  // Update lifetime
-  p.life -= dt;
-
-  if (p.life <= 0) {
-    p.active = false;
-    return;
-  }
-
-  // Calculate lifetime progress (0 = just spawned, 1 = about to die)
-  float progress = 1.0f - (p.life / p.maxLife);
-
-  // Interpolate size
-  p.size = Lerp(p.startSize, p.endSize, progress);
-
-  // Interpolate color
-  if (config.colorInterpolation) {
-    p.r = Lerp(p.startR, p.endR, progress);
-    p.g = Lerp(p.startG, p.endG, progress);
-    p.b = Lerp(p.startB, p.endB, progress);
-    p.a = Lerp(p.startA, p.endA, progress);
-  }
-
-  // Update rotation
-  p.rotation += p.rotationSpeed * dt;
+  return total;
 }
 
 void ParticleSystem::Update(float dt) {
-  for (auto &pair : m_Emitters) {
-    Emitter &emitter = pair.second;
-    const EmitterConfig &config = emitter.config;
-
-    // Spawn new particles if enabled
-    if (config.enabled && config.spawnRate > 0) {
-      emitter.spawnAccumulator += config.spawnRate * dt;
-
-      while (emitter.spawnAccumulator >= 1.0f) {
-        SpawnParticle(emitter);
-        emitter.spawnAccumulator -= 1.0f;
-      }
-    }
-
-    // Update existing particles
-    for (auto &p : emitter.particles) {
-      if (p.active) {
-        UpdateParticle(p, config, dt);
-      }
-    }
-  }
+  int threads = ThreadsFor(BuildChunks());
+
+  // Integrate and age every particle, one job per chunk
+  ParallelFor(m_Chunks.size(), threads, 1,
+              [&](int, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                  const Chunk &chunk = m_Chunks[i];
+                  Emitter &emitter = *m_ActiveEmitters[chunk.emitter];
+                  emitter.particles.advance(emitter.config, dt, chunk.begin,
+                                            chunk.end);
+                }
+              });
+
+  // Then one job per emitter drops expired particles and spawns new ones
+  // from the emitter's own RNG stream, so the result does not depend on
+  // which thread ran what. New particles start advancing next frame.
+  ParallelFor(m_ActiveEmitters.size(), threads, 1,
+              [&](int, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                  Emitter &emitter = *m_ActiveEmitters[i];
+                  const EmitterConfig &config = emitter.config;
+                  emitter.particles.removeExpired();
+
+                  if (config.enabled && config.spawnRate > 0) {
+                    emitter.spawnAccumulator += config.spawnRate * dt;
+
+                    int count = static_cast<int>(emitter.spawnAccumulator);
+                    emitter.particles.emit(config, count, emitter.rng);
+                    emitter.spawnAccumulator -= static_cast<float>(count);
+                  }
+                }
+              });
 }
 
 void ParticleSystem::Draw() {
   if (!m_Renderer)
     return;
 
-  for (auto &pair : m_Emitters) {
-    Emitter &emitter = pair.second;
-    const EmitterConfig &config = emitter.config;
-
-    int textureId =
-        config.textureId > 0 ? config.textureId : m_DefaultTextureId;
+  // Each chunk writes its sprites into its own range of the staging array,
+  // in emitter order, which then goes to the renderer in one call
+  int total = BuildChunks();
+  m_DrawStaging.resize(static_cast<size_t>(total));
 
-    for (const auto &p : emitter.particles) {
-      if (!p.active)
-        continue;
+  ParallelFor(m_Chunks.size(), ThreadsFor(total), 1,
+              [&](int, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                  StageSprites(m_Chunks[i]);
+                }
+              });
 
-      // Draw particle as a colored quad
-      float halfSize = p.size * 0.5f;
-      float drawX = p.x - halfSize;
-      float drawY = p.y - halfSize;
+  m_Renderer->DrawSprites(m_DrawStaging.data(), m_DrawStaging.size());
+}
 
-      // Use particle color as tint
-      Color tint(p.r, p.g, p.b, p.a);
+void ParticleSystem::StageSprites(const Chunk &chunk) {
+  const Emitter &emitter = *m_ActiveEmitters[chunk.emitter];
+  const EmitterConfig &config = emitter.config;
 
-      // DrawSprite signature: (textureId, x, y, w, h, rotation, flipX, flipY,
-      // tint, screenSpace)
-      m_Renderer->DrawSprite(textureId, drawX, drawY, p.size, p.size,
-                             p.rotation, false, false, tint,
-                             config.screenSpace);
-    }
+  int textureId = config.textureId > 0 ? config.textureId : m_DefaultTextureId;
+
+  using Column = ParticlePool::Column;
+  const ParticlePool &pool = emitter.particles;
+  const float *x = pool.column(Column::X);
+  const float *y = pool.column(Column::Y);
+  const float *size = pool.column(Column::Size);
+  const float *rotation = pool.column(Column::Rotation);
+  const float *r = pool.column(Column::R);
+  const float *g = pool.column(Column::G);
+  const float *b = pool.column(Column::B);
+  const float *a = pool.column(Column::A);
+
+  SpriteRenderer::DrawCommand *out = m_DrawStaging.data() + chunk.offset;
+  for (int i = chunk.begin; i < chunk.end; ++i) {
+    // Draw particle as a colored quad, tinted with the particle color
+    float halfSize = size[i] * 0.5f;
+    SpriteRenderer::DrawCommand &cmd = *out++;
+    cmd.textureId = textureId;
+    cmd.x = x[i] - halfSize;
+    cmd.y = y[i] - halfSize;
+    cmd.w = cmd.h = size[i];
+    cmd.sx = cmd.sy = 0.0f;
+    cmd.sw = cmd.sh = 1.0f;
+    cmd.rotation = rotation[i];
+    cmd.flipX = cmd.flipY = false;
+    cmd.screenSpace = config.screenSpace;
+    cmd.tint = Color(r[i], g[i], b[i], a[i]);
+    cmd.zIndex = 0;
+    cmd.sortY = cmd.y + cmd.h; // As DrawSpriteRect
   }
 }
 
@@ -1,90 +1,20 @@
 #pragma once
 
+#include "graphics/ParticlePool.h"
+#include "graphics/SpriteRenderer.h"
 #include <SDL3/SDL.h>
 #include <vector>
 #include <map>
 #include <random>
 
 // Forward declarations
-class SpriteRenderer;
 struct lua_State;
 
-// Individual particle state
-struct Particle {
-    float x, y;           // Position
-    float vx, vy;         // Velocity
-    float life;           // Remaining lifetime (seconds)
-    float maxLife;        // Initial lifetime
-    float size;           // Current size
-    float startSize, endSize;
-    float r, g, b, a;     // Current color
-    float startR, startG, startB, startA;
-    float endR, endG, endB, endA;
-    float rotation;       // Rotation angle
-    float rotationSpeed;
-    bool active;
-};
-
-// Emitter configuration - can be modified at runtime
-struct EmitterConfig {
-    // Spawn properties
-    float spawnRate;      // Particles per second
-    int maxParticles;     // Pool size
-    
-    // Position & area
-    float x, y;           // Emitter center
-    float width, height;  // Spawn area (0 = point emitter)
-    bool worldSpace;      // true = particles stay in world, false = follow emitter
-    bool screenSpace;     // Render in screen space (for UI effects)
-    
-    // Velocity
-    float minSpeed, maxSpeed;
-    float direction;      // Angle in degrees (0 = right, 90 = up, 180 = left, 270 = down)
-    float spread;         // Cone spread in degrees
-    
-    // Acceleration
-    float gravityX, gravityY;
-    
-    // Lifetime
-    float minLife, maxLife;
-    
-    // Size
-    float startSize, endSize;
-    float sizeVariation;  // ±variation
-    
-    // Color (RGBA 0-1)
-    float r, g, b, a;
-    float endR, endG, endB, endA;
-    bool colorInterpolation;  // Interpolate color over lifetime
-    
-    // Texture (0 for default white texture)
-    int textureId;
-    
-    // Enabled state
-    bool enabled;
-    
-    // Default constructor with sensible defaults
-    EmitterConfig() 
-        : spawnRate(100.0f), maxParticles(500)
-        , x(0), y(0), width(0), height(0)
-        , worldSpace(true), screenSpace(false)
-        , minSpeed(50.0f), maxSpeed(100.0f)
-        , direction(90.0f), spread(30.0f)
-        , gravityX(0), gravityY(0)
-        , minLife(1.0f), maxLife(2.0f)
-        , startSize(4.0f), endSize(4.0f), sizeVariation(0)
-        , r(1.0f), g(1.0f), b(1.0f), a(1.0f)
-        , endR(1.0f), endG(1.0f), endB(1.0f), endA(0.0f)
-        , colorInterpolation(true)
-        , textureId(0)
-        , enabled(true)
-    {}
-};
-
 // Internal emitter state
 struct Emitter {
     EmitterConfig config;
-    std::vector<Particle> particles;
+    ParticlePool particles;  // Live particles, packed (see ParticlePool)
+    ParticleRng rng;         // Spawn randomness, own stream per emitter
     float spawnAccumulator;  // Fractional particle spawning
     
     Emitter() : spawnAccumulator(0) {}
@@ -116,15 +46,25 @@ public:
     static void RegisterLua(lua_State* L, ParticleSystem* system);
     
 private:
-    void SpawnParticle(Emitter& emitter);
-    void UpdateParticle(Particle& p, const EmitterConfig& config, float dt);
-    
     SpriteRenderer* m_Renderer;
     std::map<int, Emitter> m_Emitters;
     int m_NextEmitterId;
     int m_DefaultTextureId;  // White 4x4 texture for colored particles
     
-    // Random number generation
-    std::mt19937 m_Rng;
-    std::uniform_real_distribution<float> m_Dist01;  // 0.0 to 1.0
+    // Seeds each emitter's ParticleRng
+    std::mt19937_64 m_Rng;
+    
+    // Parallel update/draw: particles are split into chunks, one job each
+    struct Chunk {
+        int emitter;  // Index into m_ActiveEmitters
+        int begin, end;  // Particle range within the emitter's pool
+        int offset;  // Where the chunk's sprites go in m_DrawStaging
+    };
+    std::vector<Emitter*> m_ActiveEmitters;  // m_Emitters in id order
+    std::vector<Chunk> m_Chunks;
+    std::vector<SpriteRenderer::DrawCommand> m_DrawStaging;
+    
+    // Rebuild m_ActiveEmitters and m_Chunks; returns total live particles
+    int BuildChunks();
+    void StageSprites(const Chunk& chunk);
 };
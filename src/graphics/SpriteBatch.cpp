@@ -0,0 +1,141 @@
+#include "graphics/SpriteBatch.h"
+#include "core/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+// [0, 1] to the full range of an unsigned normalized integer
+template <typename T> T Normalize(float value, float scale) {
+  return static_cast<T>(std::clamp(value, 0.0f, 1.0f) * scale + 0.5f);
+}
+
+} // namespace
+
+SpriteBatch::SpriteBatch(UploadBuffer &buffer, int capacity)
+    : m_Buffer(buffer), m_Capacity(capacity) {}
+
+void SpriteBatch::FillQuadIndices(uint16_t *indices) {
+  // Vertices go BL, TL, TR, BR: triangles BL-TL-TR and BL-TR-BR
+  for (int sprite = 0; sprite < kMaxBatchSprites; ++sprite) {
+    uint16_t base = static_cast<uint16_t>(sprite * kVerticesPerSprite);
+    uint16_t *quad = indices + sprite * kIndicesPerSprite;
+    quad[0] = base;
+    quad[1] = static_cast<uint16_t>(base + 1);
+    quad[2] = static_cast<uint16_t>(base + 2);
+    quad[3] = base;
+    quad[4] = static_cast<uint16_t>(base + 2);
+    quad[5] = static_cast<uint16_t>(base + 3);
+  }
+}
+
+void SpriteBatch::beginSegment(int maxSprites, const View &view) {
+  // Wrap instead of splitting a segment; a segment at the start cycles the
+  // buffer, so the earlier ones stay intact for the GPU
+  if (m_Cursor + maxSprites * kVerticesPerSprite > m_Capacity) {
+    m_Cursor = 0;
+  }
+  m_SegmentStart = m_Cursor;
+  m_View = view;
+  m_Batches.clear();
+  if (maxSprites > 0) {
+    m_Mapped = m_Buffer.map(segmentCycled());
+  }
+}
+
+void SpriteBatch::endSegment() {
+  if (m_Mapped) {
+    m_Buffer.unmap();
+    m_Mapped = nullptr;
+  }
+}
+
+void SpriteBatch::add(const SpriteCommand &cmd) {
+  if (m_Cursor + kVerticesPerSprite > m_Capacity) {
+    static bool warned = false;
+    if (!warned) {
+      LOG_WARN("Vertex buffer full (MAX_VERTICES=%d), dropping sprites",
+               m_Capacity);
+      warned = true;
+    }
+    return;
+  }
+
+  float finalX = cmd.x;
+  float finalY = cmd.y;
+  float finalW = cmd.w;
+  float finalH = cmd.h;
+
+  if (!cmd.screenSpace) {
+    // Apply camera offset
+    finalX -= m_View.cameraX;
+    finalY -= m_View.cameraY;
+
+    // Apply zoom scaling for viewport mode
+    if (m_View.zoom != 1.0f) {
+      finalX *= m_View.zoom;
+      finalY *= m_View.zoom;
+      finalW *= m_View.zoom;
+      finalH *= m_View.zoom;
+    }
+
+    // Center viewport on screen (letterboxing if aspect ratios differ)
+    if (m_View.viewportWidth > 0 && m_View.viewportHeight > 0) {
+      float scaledViewW = m_View.viewportWidth * m_View.zoom;
+      float scaledViewH = m_View.viewportHeight * m_View.zoom;
+      finalX += (m_View.windowWidth - scaledViewW) / 2.0f;
+      finalY += (m_View.windowHeight - scaledViewH) / 2.0f;
+    }
+  }
+
+  // Rotation logic (around center)
+  float cx = finalX + finalW * 0.5f;
+  float cy = finalY + finalH * 0.5f;
+
+  float c = std::cos(cmd.rotation);
+  float s = std::sin(cmd.rotation);
+
+  float dx = -finalW * 0.5f;
+  float dy = -finalH * 0.5f;
+
+  auto transform = [&](float lx, float ly) -> std::pair<float, float> {
+    return {cx + lx * c - ly * s, cy + lx * s + ly * c};
+  };
+
+  if (m_Batches.empty() || m_Batches.back().textureId != cmd.textureId ||
+      m_Batches.back().vertexCount == kMaxBatchSprites * kVerticesPerSprite) {
+    m_Batches.push_back({cmd.textureId, 0, m_Cursor});
+  }
+
+  uint16_t u0 = Normalize<uint16_t>(cmd.sx, 65535.0f);
+  uint16_t v0 = Normalize<uint16_t>(cmd.sy, 65535.0f);
+  uint16_t u1 = Normalize<uint16_t>(cmd.sx + cmd.sw, 65535.0f);
+  uint16_t v1 = Normalize<uint16_t>(cmd.sy + cmd.sh, 65535.0f);
+
+  if (cmd.flipX)
+    std::swap(u0, u1);
+  if (cmd.flipY)
+    std::swap(v0, v1);
+
+  auto p0 = transform(dx, dy);                   // TL
+  auto p1 = transform(dx + finalW, dy);          // TR
+  auto p2 = transform(dx + finalW, dy + finalH); // BR
+  auto p3 = transform(dx, dy + finalH);          // BL
+
+  uint8_t r = Normalize<uint8_t>(cmd.tint.r, 255.0f);
+  uint8_t g = Normalize<uint8_t>(cmd.tint.g, 255.0f);
+  uint8_t b = Normalize<uint8_t>(cmd.tint.b, 255.0f);
+  uint8_t a = Normalize<uint8_t>(cmd.tint.a, 255.0f);
+
+  // Mapped upload memory may be write-combined: write each vertex whole
+  // and in order, never read it back
+  Vertex *out = m_Mapped + m_Cursor;
+  out[0] = {p3.first, p3.second, u0, v1, r, g, b, a}; // BL
+  out[1] = {p0.first, p0.second, u0, v0, r, g, b, a}; // TL
+  out[2] = {p1.first, p1.second, u1, v0, r, g, b, a}; // TR
+  out[3] = {p2.first, p2.second, u1, v1, r, g, b, a}; // BR
+
+  m_Cursor += kVerticesPerSprite;
+  m_Batches.back().vertexCount += kVerticesPerSprite;
+}
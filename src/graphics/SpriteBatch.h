@@ -0,0 +1,132 @@
+#pragma once
+
+#include "core/Color.h"
+#include <cstdint>
+#include <vector>
+
+// Sprite vertex, 16 bytes: 4 per quad, shared through a static index buffer
+struct Vertex {
+  float x, y;          // Window pixels
+  uint16_t u, v;       // Texture coordinates, normalized (65535 = 1.0)
+  uint8_t r, g, b, a;  // Tint, normalized (255 = 1.0)
+};
+static_assert(sizeof(Vertex) == 16, "Vertex layout must match the pipeline");
+
+// Queued sprite, turned into vertices at Flush/EndFrame
+struct SpriteCommand {
+  int textureId;
+  float x, y, w, h;     // World position/size
+  float sx, sy, sw, sh; // UVs
+  float rotation;
+  bool flipX, flipY;
+  bool screenSpace; // If true, bypass Y-sorting
+  Color tint;
+
+  // Sorting keys
+  int zIndex;  // Primary sort key (Layer)
+  float sortY; // Secondary sort key (Y-position for depth)
+};
+
+/**
+ * Turns sprite commands into quads written straight into mapped upload
+ * memory, grouped into per-texture draw batches.
+ *
+ * The upload buffer is a ring within each frame: every segment (the world
+ * at Flush, the UI at EndFrame) is appended after the previous one, so it
+ * never overwrites vertices the GPU has yet to copy. A segment that starts
+ * at vertex 0 - the first of a frame, or one that wrapped because it did
+ * not fit - maps with cycling, so frames still in flight keep their data.
+ *
+ * No SDL dependency: SpriteRenderer supplies the GPU transfer buffer
+ * through UploadBuffer, and the benchmarks supply a stub.
+ */
+class SpriteBatch {
+public:
+  /// Memory the vertices are written to, e.g. a GPU transfer buffer
+  class UploadBuffer {
+  public:
+    virtual ~UploadBuffer() = default;
+
+    /// Map the whole buffer for writing. With cycle set, contents the GPU
+    /// may still read are kept by handing out fresh memory.
+    virtual Vertex *map(bool cycle) = 0;
+    virtual void unmap() = 0;
+  };
+
+  static constexpr int kVerticesPerSprite = 4;
+  static constexpr int kIndicesPerSprite = 6;
+
+  /// Sprites one draw can reach with 16-bit indices relative to its first
+  /// vertex; longer runs are split into several batches
+  static constexpr int kMaxBatchSprites = 65536 / kVerticesPerSprite;
+
+  /// Consecutive sprites drawn with one texture
+  struct Batch {
+    int textureId;
+    int vertexCount;
+    int startVertex; // Absolute index in the upload buffer
+
+    int indexCount() const {
+      return vertexCount / kVerticesPerSprite * kIndicesPerSprite;
+    }
+  };
+
+  /// Maps world positions to window pixels (screen-space sprites skip it)
+  struct View {
+    float cameraX = 0.0f;
+    float cameraY = 0.0f;
+    float zoom = 1.0f;
+    float viewportWidth = 0.0f; // 0 = no letterboxing
+    float viewportHeight = 0.0f;
+    float windowWidth = 0.0f;
+    float windowHeight = 0.0f;
+  };
+
+  /// @param capacity Vertices the upload buffer holds
+  SpriteBatch(UploadBuffer &buffer, int capacity);
+
+  /**
+   * Fill the static index buffer: two triangles per quad, indices relative
+   * to the batch's first vertex (drawn with it as the vertex offset).
+   *
+   * @param indices Room for kMaxBatchSprites * kIndicesPerSprite entries
+   */
+  static void FillQuadIndices(uint16_t *indices);
+
+  /// Rewind to the start of the buffer for a new frame
+  void beginFrame() { m_Cursor = 0; }
+
+  /**
+   * Map the buffer for a segment of up to maxSprites sprites: after the
+   * frame's earlier segments, or from the start if it would not fit there.
+   */
+  void beginSegment(int maxSprites, const View &view);
+
+  /// Write one sprite's quad, at most maxSprites times per segment.
+  /// Dropped, with a warning, once the buffer is full.
+  void add(const SpriteCommand &cmd);
+
+  /// Unmap the buffer; the segment's vertices are then ready to upload
+  void endSegment();
+
+  /// First vertex of the current segment
+  int segmentStart() const { return m_SegmentStart; }
+
+  /// Vertices written to the current segment
+  int segmentSize() const { return m_Cursor - m_SegmentStart; }
+
+  /// True when the segment starts the buffer, so its upload should cycle
+  bool segmentCycled() const { return m_SegmentStart == 0; }
+
+  /// Draw batches of the current segment
+  const std::vector<Batch> &batches() const { return m_Batches; }
+
+private:
+  UploadBuffer &m_Buffer;
+  int m_Capacity;
+  View m_View;
+  Vertex *m_Mapped = nullptr; // Start of the buffer while a segment is open
+  int m_Cursor = 0;           // Next free vertex
+  int m_SegmentStart = 0;
+  std::vector<Batch> m_Batches;
+};
@@ -3,6 +3,7 @@
 #include "core/Logger.h"
 #include "core/Profiler.h"
 #include "core/WindowManager.h"
+#include <cstddef>
 #include <fstream>
 
 #include <sstream>
@@ -24,9 +25,29 @@ static std::string ReadShaderFile(const char *path) {
   return buffer.str();
 }
 
-// MAX SPRITES per frame
-const int MAX_SPRITES = 10000;
-const int MAX_VERTICES = MAX_SPRITES * 6;
+// MAX SPRITES per frame. The vertex buffer is the same size as it was for
+// 10000 sprites of 6 float vertices (2 MB).
+const int MAX_SPRITES = 32768;
+const int MAX_VERTICES = MAX_SPRITES * SpriteBatch::kVerticesPerSprite;
+const int MAX_INDICES =
+    SpriteBatch::kMaxBatchSprites * SpriteBatch::kIndicesPerSprite;
+
+// SpriteBatch writes into the mapped transfer buffer
+class TransferUpload : public SpriteBatch::UploadBuffer {
+public:
+  TransferUpload(SDL_GPUDevice *device, SDL_GPUTransferBuffer *buffer)
+      : m_Device(device), m_Buffer(buffer) {}
+
+  Vertex *map(bool cycle) override {
+    return static_cast<Vertex *>(
+        SDL_MapGPUTransferBuffer(m_Device, m_Buffer, cycle));
+  }
+  void unmap() override { SDL_UnmapGPUTransferBuffer(m_Device, m_Buffer); }
+
+private:
+  SDL_GPUDevice *m_Device;
+  SDL_GPUTransferBuffer *m_Buffer;
+};
 
 // MSL Shaders
 const char *MSL_VERTEX_SHADER = R"(
@@ -34,7 +55,7 @@ const char *MSL_VERTEX_SHADER = R"(
 using namespace metal;
 
 struct VertexInput {
-    float3 position [[attribute(0)]];
+    float2 position [[attribute(0)]];
     float2 texCoord [[attribute(1)]];
     float4 color [[attribute(2)]];
 };
@@ -103,7 +124,8 @@ vertex VertexOutput post_vertex(uint vertexID [[vertex_id]]) {
 
 SpriteRenderer::SpriteRenderer()
     : m_Device(nullptr), m_Window(nullptr), m_Pipeline(nullptr),
-      m_Sampler(nullptr), m_VertexBuffer(nullptr), m_TransferBuffer(nullptr) {
+      m_Sampler(nullptr), m_VertexBuffer(nullptr), m_IndexBuffer(nullptr),
+      m_TransferBuffer(nullptr) {
   m_RenderTextures[0] = nullptr;
   m_RenderTextures[1] = nullptr;
 }
@@ -159,18 +181,18 @@ bool SpriteRenderer::Init(SDL_GPUDevice *device, SDL_Window *window) {
   SDL_GPUVertexAttribute attributes[3];
   attributes[0].location = 0;
   attributes[0].buffer_slot = 0;
-  attributes[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3;
-  attributes[0].offset = 0;
+  attributes[0].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
+  attributes[0].offset = offsetof(Vertex, x);
 
   attributes[1].location = 1;
   attributes[1].buffer_slot = 0;
-  attributes[1].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2;
-  attributes[1].offset = sizeof(float) * 3;
+  attributes[1].format = SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM;
+  attributes[1].offset = offsetof(Vertex, u);
 
   attributes[2].location = 2;
   attributes[2].buffer_slot = 0;
-  attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4;
-  attributes[2].offset = sizeof(float) * 5;
+  attributes[2].format = SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM;
+  attributes[2].offset = offsetof(Vertex, r);
 
   SDL_GPUVertexBufferDescription binding = {};
   binding.slot = 0;
@@ -231,8 +253,12 @@ bool SpriteRenderer::Init(SDL_GPUDevice *device, SDL_Window *window) {
   transferInfo.size = MAX_VERTICES * sizeof(Vertex);
   m_TransferBuffer = SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
 
-  // Prereserve
-  m_BatchedVertices.reserve(MAX_VERTICES);
+  m_Upload = std::make_unique<TransferUpload>(m_Device, m_TransferBuffer);
+  m_SpriteBatch = std::make_unique<SpriteBatch>(*m_Upload, MAX_VERTICES);
+
+  // Static quad indices, shared by every batch
+  if (!CreateIndexBuffer())
+    return false;
 
   // 5. Get window dimensions from WindowManager (with DPI scaling)
   m_WindowWidth = WindowManager::getInstance().getScaledWidth();
@@ -259,6 +285,51 @@ bool SpriteRenderer::Init(SDL_GPUDevice *device, SDL_Window *window) {
   return true;
 }
 
+bool SpriteRenderer::CreateIndexBuffer() {
+  Uint32 size = MAX_INDICES * sizeof(uint16_t);
+
+  SDL_GPUBufferCreateInfo bufferInfo = {};
+  bufferInfo.usage = SDL_GPU_BUFFERUSAGE_INDEX;
+  bufferInfo.size = size;
+  m_IndexBuffer = SDL_CreateGPUBuffer(m_Device, &bufferInfo);
+  if (!m_IndexBuffer)
+    return false;
+
+  SDL_GPUTransferBufferCreateInfo transferInfo = {};
+  transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+  transferInfo.size = size;
+  SDL_GPUTransferBuffer *transferBuffer =
+      SDL_CreateGPUTransferBuffer(m_Device, &transferInfo);
+  if (!transferBuffer)
+    return false;
+
+  uint16_t *map = static_cast<uint16_t *>(
+      SDL_MapGPUTransferBuffer(m_Device, transferBuffer, false));
+  if (!map) {
+    SDL_ReleaseGPUTransferBuffer(m_Device, transferBuffer);
+    return false;
+  }
+  SpriteBatch::FillQuadIndices(map);
+  SDL_UnmapGPUTransferBuffer(m_Device, transferBuffer);
+
+  SDL_GPUCommandBuffer *cmd = SDL_AcquireGPUCommandBuffer(m_Device);
+  SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(cmd);
+
+  SDL_GPUTransferBufferLocation source = {};
+  source.transfer_buffer = transferBuffer;
+  source.offset = 0;
+  SDL_GPUBufferRegion dest = {};
+  dest.buffer = m_IndexBuffer;
+  dest.offset = 0;
+  dest.size = size;
+  SDL_UploadToGPUBuffer(copyPass, &source, &dest, false);
+
+  SDL_EndGPUCopyPass(copyPass);
+  SDL_SubmitGPUCommandBuffer(cmd);
+  SDL_ReleaseGPUTransferBuffer(m_Device, transferBuffer);
+  return true;
+}
+
 void SpriteRenderer::Destroy() {
   // Guard against invalid device (e.g., during program exit)
   if (!m_Device)
@@ -275,8 +346,12 @@ void SpriteRenderer::Destroy() {
     SDL_ReleaseGPUGraphicsPipeline(m_Device, m_Pipeline);
   if (m_VertexBuffer)
     SDL_ReleaseGPUBuffer(m_Device, m_VertexBuffer);
+  if (m_IndexBuffer)
+    SDL_ReleaseGPUBuffer(m_Device, m_IndexBuffer);
   if (m_TransferBuffer)
     SDL_ReleaseGPUTransferBuffer(m_Device, m_TransferBuffer);
+  m_SpriteBatch.reset();
+  m_Upload.reset();
 
   // Post-processing cleanup
   for (auto &pair : m_PostShaders) {
@@ -436,8 +511,8 @@ int SpriteRenderer::LoadTextureFromMemory(const unsigned char *data, int w,
 
 void SpriteRenderer::BeginFrame(SDL_GPUCommandBuffer *cmdBuf) {
   m_CurrentCmdBuf = cmdBuf;
-  m_BatchedVertices.clear();
-  m_Batches.clear();
+  if (m_SpriteBatch)
+    m_SpriteBatch->beginFrame();
   m_WorldDrawQueue.clear();
   m_ScreenDrawQueue.clear();
   m_Flushed = false;
@@ -513,104 +588,75 @@ void SpriteRenderer::DrawSpriteRect(int textureId, float x, float y, float w,
   }
 }
 
-void SpriteRenderer::GenerateVerticesForCommand(const DrawCommand &cmd) {
-  if (m_BatchedVertices.size() + 6 >= MAX_VERTICES) {
-    static bool warned = false;
-    if (!warned) {
-      LOG_WARN("Vertex buffer full (MAX_VERTICES=%d), dropping sprites",
-               MAX_VERTICES);
-      warned = true;
+void SpriteRenderer::DrawSprites(const DrawCommand *commands, size_t count) {
+  // Append each run of commands bound for the same queue in one insert
+  size_t begin = 0;
+  while (begin < count) {
+    bool screenSpace = commands[begin].screenSpace;
+    size_t end = begin + 1;
+    while (end < count && commands[end].screenSpace == screenSpace) {
+      ++end;
     }
-    return;
+    auto &queue = screenSpace ? m_ScreenDrawQueue : m_WorldDrawQueue;
+    queue.insert(queue.end(), commands + begin, commands + end);
+    begin = end;
   }
+}
 
-  float finalX = cmd.x;
-  float finalY = cmd.y;
-  float finalW = cmd.w;
-  float finalH = cmd.h;
-
-  if (!cmd.screenSpace) {
-    // Apply camera offset
-    finalX -= m_CameraX;
-    finalY -= m_CameraY;
-
-    // Apply zoom scaling for viewport mode
-    if (m_Zoom != 1.0f) {
-      finalX *= m_Zoom;
-      finalY *= m_Zoom;
-      finalW *= m_Zoom;
-      finalH *= m_Zoom;
-    }
-
-    // Center viewport on screen (letterboxing if aspect ratios differ)
-    if (m_ViewportWidth > 0 && m_ViewportHeight > 0) {
-      float scaledViewW = m_ViewportWidth * m_Zoom;
-      float scaledViewH = m_ViewportHeight * m_Zoom;
-      float offsetX = (static_cast<float>(m_WindowWidth) - scaledViewW) / 2.0f;
-      float offsetY = (static_cast<float>(m_WindowHeight) - scaledViewH) / 2.0f;
-      finalX += offsetX;
-      finalY += offsetY;
-    }
+void SpriteRenderer::GenerateVertices(
+    const std::vector<DrawCommand> &commands) {
+  SpriteBatch::View view;
+  view.cameraX = m_CameraX;
+  view.cameraY = m_CameraY;
+  view.zoom = m_Zoom;
+  view.viewportWidth = m_ViewportWidth;
+  view.viewportHeight = m_ViewportHeight;
+  view.windowWidth = static_cast<float>(m_WindowWidth);
+  view.windowHeight = static_cast<float>(m_WindowHeight);
+
+  m_SpriteBatch->beginSegment(static_cast<int>(commands.size()), view);
+  for (const auto &cmd : commands) {
+    m_SpriteBatch->add(cmd);
   }
+  m_SpriteBatch->endSegment();
+}
 
-  // Rotation logic (around center)
-  float cx = finalX + finalW * 0.5f;
-  float cy = finalY + finalH * 0.5f;
-
-  float c = cosf(cmd.rotation);
-  float s = sinf(cmd.rotation);
+void SpriteRenderer::UploadVertices(SDL_GPUCopyPass *copyPass) {
+  // Same offset in both buffers, so batches index the vertex buffer
+  // directly. Earlier segments this frame are left alone.
+  SDL_GPUTransferBufferLocation source = {};
+  source.transfer_buffer = m_TransferBuffer;
+  source.offset = m_SpriteBatch->segmentStart() * sizeof(Vertex);
+  SDL_GPUBufferRegion dest = {};
+  dest.buffer = m_VertexBuffer;
+  dest.offset = source.offset;
+  dest.size = m_SpriteBatch->segmentSize() * sizeof(Vertex);
+  SDL_UploadToGPUBuffer(copyPass, &source, &dest,
+                        m_SpriteBatch->segmentCycled());
+}
 
-  float dx = -finalW * 0.5f;
-  float dy = -finalH * 0.5f;
+void SpriteRenderer::DrawBatches() {
+  SDL_GPUBufferBinding vertexBinding = {};
+  vertexBinding.buffer = m_VertexBuffer;
+  vertexBinding.offset = 0;
+  SDL_BindGPUVertexBuffers(m_CurrentRenderPass, 0, &vertexBinding, 1);
 
-  auto transform = [&](float lx, float ly) -> std::pair<float, float> {
-    return {cx + lx * c - ly * s, cy + lx * s + ly * c};
-  };
+  SDL_GPUBufferBinding indexBinding = {};
+  indexBinding.buffer = m_IndexBuffer;
+  indexBinding.offset = 0;
+  SDL_BindGPUIndexBuffer(m_CurrentRenderPass, &indexBinding,
+                         SDL_GPU_INDEXELEMENTSIZE_16BIT);
 
-  if (m_Batches.empty() || m_Batches.back().textureId != cmd.textureId) {
-    RenderBatch newBatch;
-    newBatch.textureId = cmd.textureId;
-    newBatch.startVertex = (int)m_BatchedVertices.size();
-    newBatch.vertexCount = 0;
-    m_Batches.push_back(newBatch);
+  // Indices are relative to each batch's first vertex
+  for (const auto &batch : m_SpriteBatch->batches()) {
+    auto it = m_Textures.find(batch.textureId);
+    if (it != m_Textures.end()) {
+      SDL_GPUTextureSamplerBinding binding = {it->second.texture, m_Sampler};
+      SDL_BindGPUFragmentSamplers(m_CurrentRenderPass, 0, &binding, 1);
+      SDL_DrawGPUIndexedPrimitives(m_CurrentRenderPass, batch.indexCount(), 1,
+                                   0, batch.startVertex, 0);
+    }
   }
-  RenderBatch &currentBatch = m_Batches.back();
-
-  float u0 = cmd.sx;
-  float v0 = cmd.sy;
-  float u1 = cmd.sx + cmd.sw;
-  float v1 = cmd.sy + cmd.sh;
-
-  if (cmd.flipX)
-    std::swap(u0, u1);
-  if (cmd.flipY)
-    std::swap(v0, v1);
-
-  auto p0 = transform(dx, dy);                   // TL
-  auto p1 = transform(dx + finalW, dy);          // TR
-  auto p2 = transform(dx + finalW, dy + finalH); // BR
-  auto p3 = transform(dx, dy + finalH);          // BL
-
-  float r = cmd.tint.r;
-  float g = cmd.tint.g;
-  float b = cmd.tint.b;
-  float a = cmd.tint.a;
-
-  // BL
-  m_BatchedVertices.push_back({p3.first, p3.second, 0.0f, u0, v1, r, g, b, a});
-  // TL
-  m_BatchedVertices.push_back({p0.first, p0.second, 0.0f, u0, v0, r, g, b, a});
-  // TR
-  m_BatchedVertices.push_back({p1.first, p1.second, 0.0f, u1, v0, r, g, b, a});
-
-  // BL
-  m_BatchedVertices.push_back({p3.first, p3.second, 0.0f, u0, v1, r, g, b, a});
-  // TR
-  m_BatchedVertices.push_back({p1.first, p1.second, 0.0f, u1, v0, r, g, b, a});
-  // BR
-  m_BatchedVertices.push_back({p2.first, p2.second, 0.0f, u1, v1, r, g, b, a});
-
-  currentBatch.vertexCount += 6;
 }
 
 void SpriteRenderer::Flush() {
@@ -633,32 +679,15 @@ void SpriteRenderer::Flush() {
   }
 
   // Generate Vertices from World Queue
-  for (const auto &cmd : m_WorldDrawQueue) {
-    GenerateVerticesForCommand(cmd);
-  }
+  GenerateVertices(m_WorldDrawQueue);
   m_WorldDrawQueue.clear();
 
-  if (m_BatchedVertices.empty())
+  if (m_SpriteBatch->segmentSize() == 0)
     return;
 
   // 1. Upload Vertices
-  Uint8 *map =
-      (Uint8 *)SDL_MapGPUTransferBuffer(m_Device, m_TransferBuffer, true);
-  memcpy(map, m_BatchedVertices.data(),
-         m_BatchedVertices.size() * sizeof(Vertex));
-  SDL_UnmapGPUTransferBuffer(m_Device, m_TransferBuffer);
-
   SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(m_CurrentCmdBuf);
-
-  // Upload vertex data
-  SDL_GPUTransferBufferLocation source = {};
-  source.transfer_buffer = m_TransferBuffer;
-  source.offset = 0;
-  SDL_GPUBufferRegion dest = {};
-  dest.buffer = m_VertexBuffer;
-  dest.offset = 0;
-  dest.size = m_BatchedVertices.size() * sizeof(Vertex);
-  SDL_UploadToGPUBuffer(copyPass, &source, &dest, true);
+  UploadVertices(copyPass);
 
   // Upload uniforms for all active shaders
   for (const auto &shaderName : m_ShaderOrder) {
@@ -684,8 +713,6 @@ void SpriteRenderer::Flush() {
   // Check if swapchain acquisition failed (e.g., window minimized)
   if (!m_SwapchainTexture) {
     // Swapchain unavailable - skip rendering but keep state valid
-    m_BatchedVertices.clear();
-    m_Batches.clear();
     m_Flushed = true;
     return;
   }
@@ -709,20 +736,7 @@ void SpriteRenderer::Flush() {
     SDL_PushGPUVertexUniformData(m_CurrentCmdBuf, 0, screenDims,
                                  sizeof(screenDims));
 
-    SDL_GPUBufferBinding vertexBinding = {};
-    vertexBinding.buffer = m_VertexBuffer;
-    vertexBinding.offset = 0;
-    SDL_BindGPUVertexBuffers(m_CurrentRenderPass, 0, &vertexBinding, 1);
-
-    for (const auto &batch : m_Batches) {
-      auto it = m_Textures.find(batch.textureId);
-      if (it != m_Textures.end()) {
-        SDL_GPUTextureSamplerBinding binding = {it->second.texture, m_Sampler};
-        SDL_BindGPUFragmentSamplers(m_CurrentRenderPass, 0, &binding, 1);
-        SDL_DrawGPUPrimitives(m_CurrentRenderPass, batch.vertexCount, 1,
-                              batch.startVertex, 0);
-      }
-    }
+    DrawBatches();
     SDL_EndGPURenderPass(m_CurrentRenderPass);
   } else {
     // With shaders - multi-pass rendering
@@ -744,20 +758,7 @@ void SpriteRenderer::Flush() {
     SDL_PushGPUVertexUniformData(m_CurrentCmdBuf, 0, screenDimsScene,
                                  sizeof(screenDimsScene));
 
-    SDL_GPUBufferBinding vertexBinding = {};
-    vertexBinding.buffer = m_VertexBuffer;
-    vertexBinding.offset = 0;
-    SDL_BindGPUVertexBuffers(m_CurrentRenderPass, 0, &vertexBinding, 1);
-
-    for (const auto &batch : m_Batches) {
-      auto it = m_Textures.find(batch.textureId);
-      if (it != m_Textures.end()) {
-        SDL_GPUTextureSamplerBinding binding = {it->second.texture, m_Sampler};
-        SDL_BindGPUFragmentSamplers(m_CurrentRenderPass, 0, &binding, 1);
-        SDL_DrawGPUPrimitives(m_CurrentRenderPass, batch.vertexCount, 1,
-                              batch.startVertex, 0);
-      }
-    }
+    DrawBatches();
     SDL_EndGPURenderPass(m_CurrentRenderPass);
 
     // PASS 2+: Apply shaders in chain (ping-pong between textures)
@@ -797,9 +798,6 @@ void SpriteRenderer::Flush() {
     }
   }
 
-  // Clear batches for UI rendering
-  m_BatchedVertices.clear();
-  m_Batches.clear();
   m_Flushed = true;
 }
 
@@ -814,31 +812,16 @@ void SpriteRenderer::EndFrame() {
   // Generate vertices for Screen Space (UI)
   // UI elements MUST preserve submission order for correct layering/blending
   // DO NOT sort by texture - draw order matters for UI!
-  for (const auto &cmd : m_ScreenDrawQueue) {
-    GenerateVerticesForCommand(cmd);
-  }
+  // Appended after the world's vertices in the upload buffer
+  GenerateVertices(m_ScreenDrawQueue);
   m_ScreenDrawQueue.clear();
 
-  if (m_BatchedVertices.empty())
+  if (m_SpriteBatch->segmentSize() == 0)
     return;
 
   // 1. Upload UI Vertices
-  Uint8 *map =
-      (Uint8 *)SDL_MapGPUTransferBuffer(m_Device, m_TransferBuffer, true);
-  memcpy(map, m_BatchedVertices.data(),
-         m_BatchedVertices.size() * sizeof(Vertex));
-  SDL_UnmapGPUTransferBuffer(m_Device, m_TransferBuffer);
-
   SDL_GPUCopyPass *copyPass = SDL_BeginGPUCopyPass(m_CurrentCmdBuf);
-
-  SDL_GPUTransferBufferLocation source = {};
-  source.transfer_buffer = m_TransferBuffer;
-  source.offset = 0;
-  SDL_GPUBufferRegion dest = {};
-  dest.buffer = m_VertexBuffer;
-  dest.offset = 0;
-  dest.size = m_BatchedVertices.size() * sizeof(Vertex);
-  SDL_UploadToGPUBuffer(copyPass, &source, &dest, true);
+  UploadVertices(copyPass);
   SDL_EndGPUCopyPass(copyPass);
 
   // 2. Acquire Swapchain if not already held
@@ -874,20 +857,7 @@ void SpriteRenderer::EndFrame() {
   SDL_PushGPUVertexUniformData(m_CurrentCmdBuf, 0, screenDims,
                                sizeof(screenDims));
 
-  SDL_GPUBufferBinding vertexBinding = {};
-  vertexBinding.buffer = m_VertexBuffer;
-  vertexBinding.offset = 0;
-  SDL_BindGPUVertexBuffers(m_CurrentRenderPass, 0, &vertexBinding, 1);
-
-  for (const auto &batch : m_Batches) {
-    auto it = m_Textures.find(batch.textureId);
-    if (it != m_Textures.end()) {
-      SDL_GPUTextureSamplerBinding binding = {it->second.texture, m_Sampler};
-      SDL_BindGPUFragmentSamplers(m_CurrentRenderPass, 0, &binding, 1);
-      SDL_DrawGPUPrimitives(m_CurrentRenderPass, batch.vertexCount, 1,
-                            batch.startVertex, 0);
-    }
-  }
+  DrawBatches();
   SDL_EndGPURenderPass(m_CurrentRenderPass);
 }
 
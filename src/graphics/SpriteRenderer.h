@@ -1,21 +1,19 @@
 #pragma once
 
 #include "core/Color.h"
+#include "graphics/SpriteBatch.h"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_gpu.h>
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-struct Vertex {
-  float x, y, z;
-  float u, v;
-  float r, g, b, a;
-};
-
 class SpriteRenderer {
 public:
+  using DrawCommand = SpriteCommand;
+
   SpriteRenderer();
   ~SpriteRenderer();
 
@@ -65,6 +63,11 @@ public:
                       bool flipY = false, Color tint = Color::White,
                       bool screenSpace = false, int zIndex = 0);
 
+  // Queue prebuilt commands in order, e.g. sprites staged on worker
+  // threads. Commands are queued as is: set sortY (DrawSpriteRect uses
+  // y + h).
+  void DrawSprites(const DrawCommand *commands, size_t count);
+
   enum class SortMode {
     None, // Submission order (current behavior)
     YSort // Z-index + Y-position sorting
@@ -117,7 +120,9 @@ private:
 
   // Batching support
   SDL_GPUBuffer *m_VertexBuffer;
+  SDL_GPUBuffer *m_IndexBuffer; // Static quad indices (SpriteBatch)
   SDL_GPUTransferBuffer *m_TransferBuffer;
+  bool CreateIndexBuffer();
 
   // Simple texture management
   struct Texture {
@@ -129,32 +134,13 @@ private:
   int m_NextTextureId = 1;
 
   // Deferred Rendering
-  struct DrawCommand {
-    int textureId;
-    float x, y, w, h;     // World position/size
-    float sx, sy, sw, sh; // UVs
-    float rotation;
-    bool flipX, flipY;
-    bool screenSpace; // If true, bypass Y-sorting
-    Color tint;
-
-    // Sorting keys
-    int zIndex;  // Primary sort key (Layer)
-    float sortY; // Secondary sort key (Y-position for depth)
-  };
-
   std::vector<DrawCommand> m_WorldDrawQueue;
   std::vector<DrawCommand> m_ScreenDrawQueue;
   SortMode m_SortMode = SortMode::YSort; // Default to Y-Sorting
 
-  // Batching
-  std::vector<Vertex> m_BatchedVertices;
-  struct RenderBatch {
-    int textureId;
-    int vertexCount;
-    int startVertex;
-  };
-  std::vector<RenderBatch> m_Batches;
+  // Batching: vertices are written straight into m_TransferBuffer
+  std::unique_ptr<SpriteBatch::UploadBuffer> m_Upload;
+  std::unique_ptr<SpriteBatch> m_SpriteBatch;
 
   SDL_GPUCommandBuffer *m_CurrentCmdBuf;
   SDL_GPURenderPass *m_CurrentRenderPass;
@@ -163,6 +149,9 @@ private:
   bool m_Flushed = false;
   SDL_GPUTexture *m_SwapchainTexture = nullptr;
 
-  // Internal helper to generate vertices from a command
-  void GenerateVerticesForCommand(const DrawCommand &cmd);
+  // Write the commands' vertices as the next upload segment
+  void GenerateVertices(const std::vector<DrawCommand> &commands);
+  // Record the copy of the current segment into m_VertexBuffer
+  void UploadVertices(SDL_GPUCopyPass *copyPass);
+  void DrawBatches();
 };
@@ -1,144 +1,1032 @@
 #include "pathfinding/Pathfinder.h"
 #include "core/Logger.h"
+#include "core/WorkerPool.h"
 #include "tilemap/TileMap.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
 #include <cmath>
-#include <queue>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <unordered_set>
 
 // ============================================================================
-// Node Pool for Zero-Allocation Searches
+// Dense Search Space (one node per tile, reused across searches)
 // ============================================================================
 
-class Pathfinder::NodePool {
+class Pathfinder::SearchSpace {
 public:
-  explicit NodePool(size_t initialSize = 4096) { m_Nodes.resize(initialSize); }
-
-  Node *acquire(const Point &point) {
-    if (m_Index >= m_Nodes.size()) {
-      // Pool exhausted, expand it
-      size_t oldSize = m_Nodes.size();
-      m_Nodes.resize(oldSize * 2);
-      LOG_WARN("Pathfinding node pool expanded from %zu to %zu", oldSize,
-               m_Nodes.size());
+  static constexpr int32_t kNone = -1;
+  static constexpr int32_t kClosed = -2;
+
+  struct Node {
+    float gCost = 0.0f;
+    float hCost = 0.0f;
+    int32_t parent = kNone;
+    int32_t heapIndex = kNone; // Position in the open heap, or kClosed
+    uint32_t generation = 0;   // Node belongs to the search with this stamp
+  };
+
+  /**
+   * Start a new search over a width x height grid. Bumping the generation
+   * invalidates every node at once; arrays are only touched on resize or
+   * when the 32-bit stamp wraps.
+   */
+  void begin(int width, int height) {
+    size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (m_Nodes.size() != count) {
+      m_Nodes.assign(count, Node{});
+      m_Generation = 0;
+    }
+    if (++m_Generation == 0) {
+      for (Node &node : m_Nodes) {
+        node.generation = 0;
+      }
+      m_Generation = 1;
     }
+    m_Heap.clear();
+  }
 
-    Node *node = &m_Nodes[m_Index++];
-    node->reset();
-    node->point = point;
-    return node;
+  bool visited(int32_t index) const {
+    return m_Nodes[index].generation == m_Generation;
   }
 
-  void reset() { m_Index = 0; }
+  bool closed(int32_t index) const {
+    return visited(index) && m_Nodes[index].heapIndex == kClosed;
+  }
+
+  const Node &node(int32_t index) const { return m_Nodes[index]; }
+
+  bool empty() const { return m_Heap.empty(); }
+
+  /**
+   * Add an unvisited node to the open heap.
+   */
+  void open(int32_t index, float gCost, float hCost, int32_t parent) {
+    Node &node = m_Nodes[index];
+    node.gCost = gCost;
+    node.hCost = hCost;
+    node.parent = parent;
+    node.generation = m_Generation;
+    m_Heap.push_back({gCost + hCost, hCost, index});
+    siftUp(m_Heap.size() - 1);
+  }
 
-  size_t getUsage() const { return m_Index; }
+  /**
+   * Lower the cost of an open node (decrease-key).
+   */
+  void decrease(int32_t index, float gCost, int32_t parent) {
+    Node &node = m_Nodes[index];
+    node.gCost = gCost;
+    node.parent = parent;
+    size_t pos = static_cast<size_t>(node.heapIndex);
+    m_Heap[pos].fCost = gCost + node.hCost;
+    siftUp(pos);
+  }
+
+  /**
+   * Remove the best open node and mark it closed.
+   */
+  int32_t pop() {
+    int32_t index = m_Heap.front().index;
+    m_Heap.front() = m_Heap.back();
+    m_Heap.pop_back();
+    if (!m_Heap.empty()) {
+      siftDown(0);
+    }
+    m_Nodes[index].heapIndex = kClosed;
+    return index;
+  }
 
 private:
+  struct HeapEntry {
+    float fCost;
+    float hCost;
+    int32_t index;
+  };
+
+  static bool before(const HeapEntry &a, const HeapEntry &b) {
+    // Lower f-cost first; near-ties prefer nodes closer to the goal
+    if (std::abs(a.fCost - b.fCost) < 0.001f) {
+      return a.hCost < b.hCost;
+    }
+    return a.fCost < b.fCost;
+  }
+
+  void place(size_t pos, const HeapEntry &entry) {
+    m_Heap[pos] = entry;
+    m_Nodes[entry.index].heapIndex = static_cast<int32_t>(pos);
+  }
+
+  void siftUp(size_t pos) {
+    HeapEntry entry = m_Heap[pos];
+    while (pos > 0) {
+      size_t parent = (pos - 1) / 2;
+      if (!before(entry, m_Heap[parent])) {
+        break;
+      }
+      place(pos, m_Heap[parent]);
+      pos = parent;
+    }
+    place(pos, entry);
+  }
+
+  void siftDown(size_t pos) {
+    HeapEntry entry = m_Heap[pos];
+    size_t count = m_Heap.size();
+    for (;;) {
+      size_t child = 2 * pos + 1;
+      if (child >= count) {
+        break;
+      }
+      if (child + 1 < count && before(m_Heap[child + 1], m_Heap[child])) {
+        ++child;
+      }
+      if (!before(m_Heap[child], entry)) {
+        break;
+      }
+      place(pos, m_Heap[child]);
+      pos = child;
+    }
+    place(pos, entry);
+  }
+
   std::vector<Node> m_Nodes;
-  size_t m_Index = 0;
+  std::vector<HeapEntry> m_Heap;
+  uint32_t m_Generation = 0;
 };
 
 // ============================================================================
-// Priority Queue Comparator
+// Baked Navigation Cost Grid
 // ============================================================================
 
-struct NodeComparator {
-  bool operator()(const Pathfinder::Node *a, const Pathfinder::Node *b) const {
-    // Min-heap: lower f-cost has higher priority
-    if (std::abs(a->fCost - b->fCost) < 0.001f) {
-      // Tie-breaking: prefer nodes closer to goal (lower h-cost)
-      return a->hCost > b->hCost;
+/**
+ * Traversal costs for one navigation layer, one byte per tile. Each byte
+ * indexes a palette of the distinct costs on the layer (entry 0 means
+ * unwalkable), so costs stay exact and searches never read strings.
+ *
+ * Walkability is also packed one bit per tile, row-major and transposed
+ * (column-major), so jump scans test 64 tiles per word in either axis.
+ * Tiles per palette entry are counted to tell uniform-cost layers apart
+ * and to reuse entries no tile holds any more.
+ */
+class Pathfinder::NavGrid {
+public:
+  static constexpr uint8_t kBlocked = 0;
+  static constexpr size_t kMaxPalette = 256;
+
+  NavGrid(int width, int height)
+      : m_Width(width), m_Height(height),
+        m_Cells(static_cast<size_t>(width) * static_cast<size_t>(height),
+                kBlocked),
+        m_Palette{-1.0f, 1.0f}, m_RowWords((width + 63) / 64),
+        m_ColumnWords((height + 63) / 64),
+        m_Rows(static_cast<size_t>(height) * m_RowWords, 0),
+        m_Columns(static_cast<size_t>(width) * m_ColumnWords, 0),
+        m_Counts{} {}
+
+  int getWidth() const { return m_Width; }
+  int getHeight() const { return m_Height; }
+
+  float cost(int x, int y) const {
+    return m_Palette[m_Cells[static_cast<size_t>(y) * m_Width + x]];
+  }
+
+  void set(int x, int y, float cost) {
+    uint8_t &cell = m_Cells[static_cast<size_t>(y) * m_Width + x];
+    uint8_t code = encode(cost);
+    if (cell == code) {
+      return;
+    }
+
+    if (cell != kBlocked && --m_Counts[cell] == 0) {
+      --m_UsedCosts;
+    }
+    if (code != kBlocked && m_Counts[code]++ == 0) {
+      ++m_UsedCosts;
+    }
+    cell = code;
+
+    bool open = code != kBlocked;
+    setBit(&m_Rows[static_cast<size_t>(y) * m_RowWords], x, open);
+    setBit(&m_Columns[static_cast<size_t>(x) * m_ColumnWords], y, open);
+  }
+
+  /**
+   * Bounds-checked walkability from the packed bits.
+   */
+  bool walkable(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_Width || y >= m_Height) {
+      return false;
+    }
+    const uint64_t *line = row(y);
+    return (line[x >> 6] >> (x & 63)) & 1;
+  }
+
+  /**
+   * Packed walkability of row y (bit x), or nullptr outside the grid.
+   */
+  const uint64_t *row(int y) const {
+    if (y < 0 || y >= m_Height) {
+      return nullptr;
+    }
+    return &m_Rows[static_cast<size_t>(y) * m_RowWords];
+  }
+
+  /**
+   * Packed walkability of column x (bit y), or nullptr outside the grid.
+   */
+  const uint64_t *column(int x) const {
+    if (x < 0 || x >= m_Width) {
+      return nullptr;
+    }
+    return &m_Columns[static_cast<size_t>(x) * m_ColumnWords];
+  }
+
+  int rowWords() const { return m_RowWords; }
+  int columnWords() const { return m_ColumnWords; }
+
+  /**
+   * True if every walkable tile has the same cost.
+   */
+  bool isUniform() const { return m_UsedCosts <= 1; }
+
+  /**
+   * Cost shared by every walkable tile (meaningful when isUniform()).
+   */
+  float uniformCost() const {
+    for (size_t i = 1; i < m_Palette.size(); i++) {
+      if (m_Counts[i] != 0) {
+        return m_Palette[i];
+      }
+    }
+    return 1.0f;
+  }
+
+private:
+  static void setBit(uint64_t *line, int bit, bool value) {
+    uint64_t mask = uint64_t{1} << (bit & 63);
+    if (value) {
+      line[bit >> 6] |= mask;
+    } else {
+      line[bit >> 6] &= ~mask;
+    }
+  }
+
+  uint8_t encode(float cost) {
+    if (cost < 0.0f) {
+      return kBlocked;
+    }
+
+    for (size_t i = 1; i < m_Palette.size(); i++) {
+      if (m_Palette[i] == cost) {
+        return static_cast<uint8_t>(i);
+      }
+    }
+
+    if (m_Palette.size() < kMaxPalette) {
+      m_Palette.push_back(cost);
+      return static_cast<uint8_t>(m_Palette.size() - 1);
+    }
+
+    // Palette full: reuse an entry no tile holds any more
+    for (size_t i = 1; i < m_Palette.size(); i++) {
+      if (m_Counts[i] == 0) {
+        m_Palette[i] = cost;
+        return static_cast<uint8_t>(i);
+      }
+    }
+
+    // Every entry in use: snap to the nearest known cost
+    size_t best = 1;
+    for (size_t i = 2; i < m_Palette.size(); i++) {
+      if (std::abs(m_Palette[i] - cost) < std::abs(m_Palette[best] - cost)) {
+        best = i;
+      }
+    }
+    if (!m_Saturated) {
+      LOG_WARN("Pathfinding: more than %zu distinct tile costs in use, "
+               "snapping new ones to the nearest (%.3f to %.3f)",
+               kMaxPalette - 1, cost, m_Palette[best]);
+      m_Saturated = true;
     }
-    return a->fCost > b->fCost;
+    return static_cast<uint8_t>(best);
   }
+
+  int m_Width;
+  int m_Height;
+  std::vector<uint8_t> m_Cells;
+  std::vector<float> m_Palette;
+
+  int m_RowWords;
+  int m_ColumnWords;
+  std::vector<uint64_t> m_Rows;    // height lines of rowWords words
+  std::vector<uint64_t> m_Columns; // width lines of columnWords words
+
+  std::array<uint32_t, kMaxPalette> m_Counts; // Tiles per palette entry
+  int m_UsedCosts = 0; // Palette entries (excluding blocked) in use
+  bool m_Saturated = false; // Snapping has been reported
+};
+
+/**
+ * Where a search reads tile costs: the layer's baked grid, or the
+ * request's custom cost function. Negative means unwalkable.
+ */
+class Pathfinder::CostSource {
+public:
+  CostSource(const NavGrid *grid, const PathRequest &request, int width,
+             int height)
+      : m_Grid(grid), m_Custom(&request.customCostFn), m_Width(width),
+        m_Height(height) {}
+
+  float cost(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_Width || y >= m_Height) {
+      return -1.0f;
+    }
+    return m_Grid ? m_Grid->cost(x, y) : (*m_Custom)(x, y);
+  }
+
+  bool walkable(int x, int y) const { return cost(x, y) >= 0.0f; }
+
+  int getWidth() const { return m_Width; }
+  int getHeight() const { return m_Height; }
+
+  /**
+   * The baked grid, or nullptr when a custom cost function is used.
+   */
+  const NavGrid *grid() const { return m_Grid; }
+
+private:
+  const NavGrid *m_Grid;
+  const std::function<float(int x, int y)> *m_Custom;
+  int m_Width;
+  int m_Height;
 };
 
 // ============================================================================
-// Hash Function for Point
+// Hierarchical Cluster Graph (HPA*)
 // ============================================================================
 
-namespace std {
-template <> struct hash<Pathfinder::Point> {
-  size_t operator()(const Pathfinder::Point &p) const {
-    // Use prime multipliers for better collision resistance on grid patterns
-    return static_cast<size_t>(p.x * 73856093) ^
-           static_cast<size_t>(p.y * 19349663);
+/**
+ * Abstract graph over kClusterSize x kClusterSize clusters of one baked
+ * grid. Adjacent clusters are linked by transitions: one per short run of
+ * open tiles along their shared border, or one at each end of a long run.
+ * Each cluster stores its entrance tiles and the shortest in-cluster cost
+ * between every pair of them.
+ *
+ * Tile edits only mark clusters dirty; update() re-scans the borders of
+ * dirty clusters and rebuilds them, plus any neighbor whose shared
+ * transitions actually changed.
+ */
+class Pathfinder::ClusterGraph {
+public:
+  static constexpr float kUnreachable = std::numeric_limits<float>::infinity();
+
+  // Runs at least this long get a transition at each end
+  static constexpr int kLongEntrance = 6;
+
+  struct Cluster {
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0; // Tile bounds (max exclusive)
+    std::vector<int32_t> entrances;     // Entrance tiles, sorted
+    std::vector<std::array<int32_t, 4>> partners; // Tiles across borders
+    std::vector<float> distances; // [from * entrances + to]
+  };
+
+  ClusterGraph(const NavGrid &grid, bool diagonal)
+      : m_Grid(grid), m_Diagonal(diagonal), m_Width(grid.getWidth()),
+        m_ClustersX((grid.getWidth() + kClusterSize - 1) / kClusterSize),
+        m_ClustersY((grid.getHeight() + kClusterSize - 1) / kClusterSize) {
+    size_t count = static_cast<size_t>(m_ClustersX) * m_ClustersY;
+    m_Clusters.resize(count);
+    m_East.resize(count);
+    m_South.resize(count);
+    m_Dirty.assign(count, 1);
+    for (int cy = 0; cy < m_ClustersY; cy++) {
+      for (int cx = 0; cx < m_ClustersX; cx++) {
+        Cluster &cluster = m_Clusters[cy * m_ClustersX + cx];
+        cluster.x0 = cx * kClusterSize;
+        cluster.y0 = cy * kClusterSize;
+        cluster.x1 = std::min(cluster.x0 + kClusterSize, grid.getWidth());
+        cluster.y1 = std::min(cluster.y0 + kClusterSize, grid.getHeight());
+      }
+    }
   }
+
+  int clusterAt(int x, int y) const {
+    return (y / kClusterSize) * m_ClustersX + x / kClusterSize;
+  }
+
+  const Cluster &cluster(int index) const { return m_Clusters[index]; }
+
+  /**
+   * Index of a tile in cluster.entrances, or -1.
+   */
+  static int entranceSlot(const Cluster &cluster, int32_t tile) {
+    auto it = std::lower_bound(cluster.entrances.begin(),
+                               cluster.entrances.end(), tile);
+    if (it == cluster.entrances.end() || *it != tile) {
+      return -1;
+    }
+    return static_cast<int>(it - cluster.entrances.begin());
+  }
+
+  /**
+   * Mark the clusters overlapping a tile rectangle (max exclusive).
+   */
+  void invalidate(int x0, int y0, int x1, int y1) {
+    if (x0 >= x1 || y0 >= y1) {
+      return;
+    }
+    for (int cy = y0 / kClusterSize; cy <= (y1 - 1) / kClusterSize; cy++) {
+      for (int cx = x0 / kClusterSize; cx <= (x1 - 1) / kClusterSize; cx++) {
+        m_Dirty[cy * m_ClustersX + cx] = 1;
+      }
+    }
+    m_AnyDirty = true;
+  }
+
+  /**
+   * Rebuild dirty clusters.
+   * @return Number of clusters rebuilt
+   */
+  int update() {
+    if (!m_AnyDirty) {
+      return 0;
+    }
+
+    std::vector<uint8_t> rebuild = m_Dirty;
+    auto refreshBorder = [&](int index, bool east) {
+      Transitions found = findTransitions(index, east);
+      Transitions &stored = east ? m_East[index] : m_South[index];
+      if (found != stored) {
+        stored.swap(found);
+        rebuild[index] = 1;
+        rebuild[east ? index + 1 : index + m_ClustersX] = 1;
+      }
+    };
+
+    for (size_t i = 0; i < m_Dirty.size(); i++) {
+      if (!m_Dirty[i]) {
+        continue;
+      }
+      int index = static_cast<int>(i);
+      int cx = index % m_ClustersX;
+      int cy = index / m_ClustersX;
+      if (cx + 1 < m_ClustersX) {
+        refreshBorder(index, true);
+      }
+      if (cy + 1 < m_ClustersY) {
+        refreshBorder(index, false);
+      }
+      if (cx > 0) {
+        refreshBorder(index - 1, true);
+      }
+      if (cy > 0) {
+        refreshBorder(index - m_ClustersX, false);
+      }
+    }
+
+    int rebuilt = 0;
+    for (size_t i = 0; i < rebuild.size(); i++) {
+      if (rebuild[i]) {
+        rebuildCluster(static_cast<int>(i));
+        rebuilt++;
+      }
+    }
+
+    std::fill(m_Dirty.begin(), m_Dirty.end(), 0);
+    m_AnyDirty = false;
+    return rebuilt;
+  }
+
+  /**
+   * In-cluster cost from a tile to each entrance, or (reverse) from each
+   * entrance to the tile. kUnreachable where there is no in-cluster route.
+   */
+  void distances(const Cluster &cluster, int32_t tile, bool reverse,
+                 std::vector<float> &out) {
+    loadCosts(cluster);
+    search(cluster, tile, reverse);
+    out.resize(cluster.entrances.size());
+    for (size_t i = 0; i < cluster.entrances.size(); i++) {
+      out[i] = m_Dist[local(cluster, cluster.entrances[i])];
+    }
+  }
+
+private:
+  using Transitions = std::vector<std::pair<int32_t, int32_t>>;
+  using HeapEntry = std::pair<float, int32_t>;
+
+  size_t local(const Cluster &cluster, int32_t tile) const {
+    int x = tile % m_Width - cluster.x0;
+    int y = tile / m_Width - cluster.y0;
+    return static_cast<size_t>(y) * (cluster.x1 - cluster.x0) + x;
+  }
+
+  /**
+   * Transitions across the east or south border of a cluster, as
+   * (tile inside, tile in the neighbor) pairs.
+   */
+  Transitions findTransitions(int index, bool east) const {
+    const Cluster &cluster = m_Clusters[index];
+    Transitions transitions;
+
+    // Walk the border; (x, y) inside, (x + dx, y + dy) across
+    int x = east ? cluster.x1 - 1 : cluster.x0;
+    int y = east ? cluster.y0 : cluster.y1 - 1;
+    int dx = east ? 1 : 0;
+    int dy = east ? 0 : 1;
+    int length = east ? cluster.y1 - cluster.y0 : cluster.x1 - cluster.x0;
+
+    auto tileAt = [&](int i, int across) {
+      int tx = east ? x + across : x + i;
+      int ty = east ? y + i : y + across;
+      return ty * m_Width + tx;
+    };
+    auto addRun = [&](int first, int last) {
+      if (last - first + 1 >= kLongEntrance) {
+        transitions.emplace_back(tileAt(first, 0), tileAt(first, 1));
+        transitions.emplace_back(tileAt(last, 0), tileAt(last, 1));
+      } else {
+        int mid = (first + last) / 2;
+        transitions.emplace_back(tileAt(mid, 0), tileAt(mid, 1));
+      }
+    };
+
+    int runStart = -1;
+    for (int i = 0; i < length; i++) {
+      int tx = x + (east ? 0 : i);
+      int ty = y + (east ? i : 0);
+      bool open = m_Grid.walkable(tx, ty) && m_Grid.walkable(tx + dx, ty + dy);
+      if (open && runStart < 0) {
+        runStart = i;
+      } else if (!open && runStart >= 0) {
+        addRun(runStart, i - 1);
+        runStart = -1;
+      }
+    }
+    if (runStart >= 0) {
+      addRun(runStart, length - 1);
+    }
+    return transitions;
+  }
+
+  void rebuildCluster(int index) {
+    Cluster &cluster = m_Clusters[index];
+    int cx = index % m_ClustersX;
+    int cy = index / m_ClustersX;
+
+    // (entrance, partner) from all four borders
+    Transitions links = m_East[index];
+    links.insert(links.end(), m_South[index].begin(), m_South[index].end());
+    if (cx > 0) {
+      for (const auto &[a, b] : m_East[index - 1]) {
+        links.emplace_back(b, a);
+      }
+    }
+    if (cy > 0) {
+      for (const auto &[a, b] : m_South[index - m_ClustersX]) {
+        links.emplace_back(b, a);
+      }
+    }
+    std::sort(links.begin(), links.end());
+
+    cluster.entrances.clear();
+    cluster.partners.clear();
+    for (const auto &[tile, partner] : links) {
+      if (cluster.entrances.empty() || cluster.entrances.back() != tile) {
+        cluster.entrances.push_back(tile);
+        cluster.partners.push_back({-1, -1, -1, -1});
+      }
+      auto &slots = cluster.partners.back();
+      *std::find(slots.begin(), slots.end(), -1) = partner;
+    }
+
+    size_t count = cluster.entrances.size();
+    cluster.distances.assign(count * count, kUnreachable);
+    loadCosts(cluster);
+    for (size_t i = 0; i < count; i++) {
+      search(cluster, cluster.entrances[i], false);
+      for (size_t j = 0; j < count; j++) {
+        cluster.distances[i * count + j] =
+            m_Dist[local(cluster, cluster.entrances[j])];
+      }
+    }
+  }
+
+  /**
+   * Copy a cluster's tile costs into m_Costs (local indices) for search().
+   */
+  void loadCosts(const Cluster &cluster) {
+    m_Costs.clear();
+    for (int y = cluster.y0; y < cluster.y1; y++) {
+      for (int x = cluster.x0; x < cluster.x1; x++) {
+        m_Costs.push_back(m_Grid.cost(x, y));
+      }
+    }
+  }
+
+  /**
+   * Dijkstra from one tile, confined to the cluster, into m_Dist (local
+   * indices; costs from loadCosts). Moves cost like A* steps (step length
+   * times the cost of the tile entered); reverse computes the cost of
+   * reaching the source instead.
+   */
+  void search(const Cluster &cluster, int32_t source, bool reverse) {
+    static const Point kSteps[] = {{0, -1},  {1, 0},  {0, 1},  {-1, 0},
+                                   {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+    const int stepCount = m_Diagonal ? 8 : 4;
+    const int width = cluster.x1 - cluster.x0;
+    const int height = cluster.y1 - cluster.y0;
+
+    m_Dist.assign(m_Costs.size(), kUnreachable);
+    m_Heap.clear();
+    auto later = [](const HeapEntry &a, const HeapEntry &b) {
+      return a.first > b.first;
+    };
+
+    int32_t start = static_cast<int32_t>(local(cluster, source));
+    m_Dist[start] = 0.0f;
+    m_Heap.emplace_back(0.0f, start);
+    while (!m_Heap.empty()) {
+      std::pop_heap(m_Heap.begin(), m_Heap.end(), later);
+      auto [dist, tile] = m_Heap.back();
+      m_Heap.pop_back();
+      if (dist > m_Dist[tile]) {
+        continue;
+      }
+
+      int x = tile % width;
+      int y = tile / width;
+      for (int i = 0; i < stepCount; i++) {
+        int nx = x + kSteps[i].x;
+        int ny = y + kSteps[i].y;
+        if (nx < 0 || ny < 0 || nx >= width || ny >= height) {
+          continue;
+        }
+        int32_t neighbor = ny * width + nx;
+        if (m_Costs[neighbor] < 0.0f) {
+          continue;
+        }
+
+        float moveCost = i >= 4 ? 1.414f : 1.0f;
+        float next =
+            dist + moveCost * (reverse ? m_Costs[tile] : m_Costs[neighbor]);
+        if (next < m_Dist[neighbor]) {
+          m_Dist[neighbor] = next;
+          m_Heap.emplace_back(next, neighbor);
+          std::push_heap(m_Heap.begin(), m_Heap.end(), later);
+        }
+      }
+    }
+  }
+
+  const NavGrid &m_Grid;
+  bool m_Diagonal;
+  int m_Width;
+  int m_ClustersX;
+  int m_ClustersY;
+
+  std::vector<Cluster> m_Clusters;
+  std::vector<Transitions> m_East;  // Border with cluster + 1
+  std::vector<Transitions> m_South; // Border with cluster + clustersX
+  std::vector<uint8_t> m_Dirty;
+  bool m_AnyDirty = true;
+
+  // Scratch for search()
+  std::vector<float> m_Costs;
+  std::vector<float> m_Dist;
+  std::vector<HeapEntry> m_Heap;
+};
+
+// ============================================================================
+// Async Request State
+// ============================================================================
+
+/**
+ * Ticket bookkeeping shared between a Pathfinder and its queued jobs, so
+ * jobs can finish safely after the Pathfinder is gone.
+ */
+struct Pathfinder::AsyncState {
+  struct Finished {
+    PathResult result;
+    Point start, end; // For logging a failure on the main thread
+  };
+
+  std::mutex mutex;
+  std::unordered_set<Ticket> pending;            // Queued or running
+  std::unordered_map<Ticket, Finished> finished; // Awaiting pollAsync
+  std::vector<Ticket> newlyFinished;             // Awaiting takeFinished
 };
-} // namespace std
 
 // ============================================================================
 // Constructor / Destructor
 // ============================================================================
 
 Pathfinder::Pathfinder(const TileMap &map)
-    : m_Map(map), m_NodePool(std::make_unique<NodePool>()) {}
-
-Pathfinder::~Pathfinder() = default;
+    : m_Map(map), m_Search(std::make_unique<SearchSpace>()),
+      m_Async(std::make_shared<AsyncState>()) {}
+
+Pathfinder::~Pathfinder() {
+  // In-flight jobs hold their own snapshot and state; just drop results
+  std::lock_guard<std::mutex> lock(m_Async->mutex);
+  m_Async->pending.clear();
+  m_Async->finished.clear();
+}
 
 // ============================================================================
 // Public API
 // ============================================================================
 
 Pathfinder::PathResult Pathfinder::findPath(const PathRequest &request) {
-  return findPathInternal(request);
+  if (request.customCostFn || m_PathCacheCapacity == 0) {
+    return findPathInternal(request);
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+  PathCacheKey key{request.navigationLayer, request.start, request.end,
+                   static_cast<uint8_t>(
+                       (request.allowDiagonal ? 1 : 0) |
+                       (request.smoothPath ? 2 : 0) |
+                       (static_cast<int>(request.algorithm) << 2)),
+                   request.maxSteps, request.maxTimeMs};
+
+  auto hit = m_PathCacheIndex.find(key);
+  if (hit != m_PathCacheIndex.end()) {
+    m_PathCacheStats.hits++;
+    m_PathCache.splice(m_PathCache.begin(), m_PathCache, hit->second);
+
+    PathResult result = hit->second->result;
+    result.cached = true;
+    result.nodesExpanded = 0;
+    result.timeMs = std::chrono::duration<float, std::milli>(
+                        std::chrono::steady_clock::now() - startTime)
+                        .count();
+    return result;
+  }
+  m_PathCacheStats.misses++;
+
+  PathResult result = findPathInternal(request);
+  if (!result.found || result.path.empty()) {
+    return result; // Partial and failed searches depend on limits
+  }
+
+  PathCacheEntry entry{std::move(key), result, result.path[0].x,
+                       result.path[0].y, result.path[0].x, result.path[0].y};
+  for (const Point &p : result.path) {
+    entry.minX = std::min(entry.minX, p.x);
+    entry.minY = std::min(entry.minY, p.y);
+    entry.maxX = std::max(entry.maxX, p.x);
+    entry.maxY = std::max(entry.maxY, p.y);
+  }
+
+  m_PathCache.push_front(std::move(entry));
+  m_PathCacheIndex[m_PathCache.front().key] = m_PathCache.begin();
+  while (m_PathCache.size() > m_PathCacheCapacity) {
+    eraseCachedPath(std::prev(m_PathCache.end()));
+  }
+  return result;
+}
+
+void Pathfinder::setPathCacheCapacity(size_t capacity) {
+  m_PathCacheCapacity = capacity;
+  while (m_PathCache.size() > m_PathCacheCapacity) {
+    eraseCachedPath(std::prev(m_PathCache.end()));
+  }
 }
 
+Pathfinder::PathCacheStats Pathfinder::getPathCacheStats() const {
+  PathCacheStats stats = m_PathCacheStats;
+  stats.size = m_PathCache.size();
+  stats.capacity = m_PathCacheCapacity;
+  return stats;
+}
+
+void Pathfinder::resetPathCacheStats() { m_PathCacheStats = {}; }
+
 bool Pathfinder::isWalkable(int x, int y, const std::string &layer) const {
-  // Check bounds
+  return getCost(x, y, layer) >= 0.0f;
+}
+
+float Pathfinder::getCost(int x, int y, const std::string &layer) const {
   if (x < 0 || y < 0 || x >= m_Map.getWidth() || y >= m_Map.getHeight()) {
-    return false;
+    return -1.0f;
   }
+  return getNavGrid(layer).cost(x, y);
+}
 
-  int layerIdx = getLayerIndex(layer);
-  if (layerIdx < 0) {
-    return false;
+void Pathfinder::onTileChanged(int x, int y) { invalidateRegion(x, y, 1, 1); }
+
+void Pathfinder::invalidateRegion(int x, int y, int width, int height) {
+  int x0 = std::max(x, 0);
+  int y0 = std::max(y, 0);
+  int x1 = std::min(x + width, m_Map.getWidth());
+  int y1 = std::min(y + height, m_Map.getHeight());
+
+  // Properties are read from every tile layer, so a change on any layer
+  // can move the cost on every navigation layer
+  for (auto &[layer, grid] : m_NavGrids) {
+    if (grid->getWidth() != m_Map.getWidth() ||
+        grid->getHeight() != m_Map.getHeight()) {
+      continue; // Stale size, re-baked on next use
+    }
+    bool changed = false;
+    for (int ty = y0; ty < y1; ty++) {
+      for (int tx = x0; tx < x1; tx++) {
+        float before = grid->cost(tx, ty);
+        grid->set(tx, ty, readTileCost(tx, ty, layer));
+        changed |= grid->cost(tx, ty) != before;
+      }
+    }
+    m_Snapshots.erase(layer);
+    if (changed) {
+      dropFlowFields(layer, x0, y0, x1, y1);
+      dropCachedPaths(layer, x0, y0, x1, y1);
+    }
+
+    auto graphs = m_ClusterGraphs.find(layer);
+    if (graphs != m_ClusterGraphs.end()) {
+      for (auto &graph : graphs->second) {
+        if (graph) {
+          graph->invalidate(x0, y0, x1, y1);
+        }
+      }
+    }
   }
+}
 
-  // Get tile ID
-  int tileId = m_Map.getTileId(x, y, layer);
-  if (tileId == 0) {
-    // Empty tile is walkable by default
-    return true;
+void Pathfinder::clearCache() {
+  // Search nodes are invalidated per search by generation, not here
+  m_LayerCache.clear();
+  m_ClusterGraphs.clear();
+  m_Snapshots.clear();
+  for (auto &entry : m_FlowFields) {
+    entry.field->m_Stale = true;
   }
+  m_FlowFields.clear();
+  m_PathCache.clear();
+  m_PathCacheIndex.clear();
+  m_NavGrids.clear();
+}
 
-  // Check "walkable" property (if not set, assume walkable)
-  std::string walkableProp = m_Map.getProperty(x, y, "walkable");
-  if (!walkableProp.empty() && walkableProp == "false") {
+// ============================================================================
+// Path Cache
+// ============================================================================
+
+size_t Pathfinder::PathCacheKeyHash::operator()(const PathCacheKey &key) const {
+  size_t h = std::hash<std::string>()(key.layer);
+  auto mix = [&h](uint64_t value) {
+    h ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ull + (h << 6) +
+         (h >> 2);
+  };
+  mix((static_cast<uint64_t>(static_cast<uint32_t>(key.start.x)) << 32) |
+      static_cast<uint32_t>(key.start.y));
+  mix((static_cast<uint64_t>(static_cast<uint32_t>(key.end.x)) << 32) |
+      static_cast<uint32_t>(key.end.y));
+  mix(key.flags);
+  mix((static_cast<uint64_t>(static_cast<uint32_t>(key.maxSteps)) << 32) |
+      std::bit_cast<uint32_t>(key.maxTimeMs + 0.0f)); // -0 hashes as 0
+  return h;
+}
+
+void Pathfinder::dropCachedPaths(const std::string &layer, int x0, int y0,
+                                 int x1, int y1) const {
+  // A step between two path points (smoothed paths skip tiles) can only
+  // cross tiles inside their bounding box
+  auto touches = [&](const PathCacheEntry &entry) {
+    if (x1 < x0) {
+      return true; // Whole layer
+    }
+    if (entry.maxX < x0 || entry.minX >= x1 || entry.maxY < y0 ||
+        entry.minY >= y1) {
+      return false;
+    }
+    const Path &path = entry.result.path;
+    for (size_t i = 0; i < path.size(); i++) {
+      const Point &a = path[i];
+      const Point &b = path[i + 1 < path.size() ? i + 1 : i];
+      if (std::max(a.x, b.x) >= x0 && std::min(a.x, b.x) < x1 &&
+          std::max(a.y, b.y) >= y0 && std::min(a.y, b.y) < y1) {
+        return true;
+      }
+    }
     return false;
+  };
+
+  for (auto it = m_PathCache.begin(); it != m_PathCache.end();) {
+    auto next = std::next(it);
+    if (it->key.layer == layer && touches(*it)) {
+      eraseCachedPath(it);
+      m_PathCacheStats.invalidated++;
+    }
+    it = next;
   }
+}
 
-  return true;
+void Pathfinder::eraseCachedPath(std::list<PathCacheEntry>::iterator it) const {
+  m_PathCacheIndex.erase(it->key);
+  m_PathCache.erase(it);
 }
 
-float Pathfinder::getCost(int x, int y, const std::string &layer) const {
-  if (!isWalkable(x, y, layer)) {
-    return -1.0f;
+// ============================================================================
+// Asynchronous Requests
+// ============================================================================
+
+namespace {
+
+// One pool for every pathfinder; leaves a core for the main thread
+WorkerPool &AsyncWorkers() {
+  static WorkerPool pool;
+  return pool;
+}
+
+std::atomic<uint64_t> s_NextTicket{1};
+
+} // namespace
+
+Pathfinder::Ticket Pathfinder::requestAsync(const PathRequest &request) {
+  Ticket ticket = s_NextTicket.fetch_add(1, std::memory_order_relaxed);
+  std::shared_ptr<const NavGrid> snapshot =
+      request.customCostFn ? nullptr : getSnapshot(request.navigationLayer);
+  {
+    std::lock_guard<std::mutex> lock(m_Async->mutex);
+    m_Async->pending.insert(ticket);
   }
 
-  // Check for custom cost property
-  std::string costProp = m_Map.getProperty(x, y, "cost");
-  if (!costProp.empty()) {
-    try {
-      return std::stof(costProp);
-    } catch (...) {
-      // Invalid cost, use default
+  AsyncWorkers().submit([state = m_Async, snapshot, request, ticket,
+                         width = m_Map.getWidth(),
+                         height = m_Map.getHeight()]() {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (!state->pending.count(ticket)) {
+        return; // Cancelled while queued
+      }
+    }
+
+    // Scratch per worker thread, reused across requests
+    thread_local SearchSpace search;
+
+    auto startTime = std::chrono::steady_clock::now();
+    const CostSource costs(snapshot.get(), request, width, height);
+    PathResult result;
+    if (checkEndpoints(request, costs, result)) {
+      result = searchGrid(request, costs, search, startTime);
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->pending.erase(ticket)) {
+      state->finished.emplace(
+          ticket, AsyncState::Finished{std::move(result), request.start,
+                                       request.end});
+      state->newlyFinished.push_back(ticket);
+    }
+  });
+  return ticket;
+}
+
+bool Pathfinder::pollAsync(Ticket ticket, PathResult &result) {
+  Point start, end;
+  {
+    std::lock_guard<std::mutex> lock(m_Async->mutex);
+    auto it = m_Async->finished.find(ticket);
+    if (it == m_Async->finished.end()) {
+      return false;
     }
+    result = std::move(it->second.result);
+    start = it->second.start;
+    end = it->second.end;
+    m_Async->finished.erase(it);
   }
 
-  return 1.0f; // Default cost
+  logFailure(start, end, result);
+  return true;
 }
 
-void Pathfinder::invalidateRegion(int x, int y, int width, int height) {
-  // Future: invalidate cached paths in this region
-  // For now, just clear the entire cache
-  clearCache();
+void Pathfinder::cancelAsync(Ticket ticket) {
+  std::lock_guard<std::mutex> lock(m_Async->mutex);
+  m_Async->pending.erase(ticket);
+  m_Async->finished.erase(ticket);
 }
 
-void Pathfinder::clearCache() {
-  m_LayerCache.clear();
-  m_NodePool->reset();
+std::vector<Pathfinder::Ticket> Pathfinder::takeFinished() {
+  std::lock_guard<std::mutex> lock(m_Async->mutex);
+  std::vector<Ticket> tickets;
+  for (Ticket ticket : m_Async->newlyFinished) {
+    if (m_Async->finished.count(ticket)) {
+      tickets.push_back(ticket); // Skip cancelled and already-polled
+    }
+  }
+  m_Async->newlyFinished.clear();
+  return tickets;
+}
+
+size_t Pathfinder::pendingAsync() const {
+  std::lock_guard<std::mutex> lock(m_Async->mutex);
+  return m_Async->pending.size();
 }
 
 // ============================================================================
@@ -147,50 +1035,94 @@ void Pathfinder::clearCache() {
 
 Pathfinder::PathResult
 Pathfinder::findPathInternal(const PathRequest &request) {
-  auto startTime = std::chrono::high_resolution_clock::now();
+  auto startTime = std::chrono::steady_clock::now();
+  const CostSource costs = getCostSource(request);
 
   PathResult result;
+  if (!checkEndpoints(request, costs, result)) {
+    logFailure(request.start, request.end, result);
+    return result;
+  }
+
+  // Within a couple of clusters the abstract graph saves nothing
+  const NavGrid *grid = costs.grid();
+  if (request.algorithm == Algorithm::HPA && grid &&
+      heuristicOctile(request.start, request.end) >= 2 * kClusterSize) {
+    return findPathHPA(request, *grid, startTime);
+  }
 
-  // Validate inputs
+  return searchGrid(request, costs, *m_Search, startTime);
+}
+
+bool Pathfinder::checkEndpoints(const PathRequest &request,
+                                const CostSource &costs, PathResult &result) {
   if (request.start == request.end) {
     result.path = {request.start};
     result.found = true;
-    return result;
+    return false;
   }
 
-  if (!isWalkableInternal(request.start.x, request.start.y, request)) {
-    LOG_WARN("Pathfinding: Start position (%d, %d) is not walkable",
-             request.start.x, request.start.y);
-    return result;
+  if (!costs.walkable(request.start.x, request.start.y)) {
+    result.failure = Failure::StartBlocked;
+    return false;
   }
 
-  if (!isWalkableInternal(request.end.x, request.end.y, request)) {
-    LOG_WARN("Pathfinding: End position (%d, %d) is not walkable",
-             request.end.x, request.end.y);
-    return result;
+  if (!costs.walkable(request.end.x, request.end.y)) {
+    result.failure = Failure::EndBlocked;
+    return false;
   }
 
-  // Reset node pool
-  m_NodePool->reset();
+  return true;
+}
 
-  // Open set (priority queue) and closed set
-  std::priority_queue<Node *, std::vector<Node *>, NodeComparator> openSet;
-  std::unordered_set<Point> closedSet;
-  std::unordered_map<Point, Node *> nodeMap;
+void Pathfinder::logFailure(const Point &start, const Point &end,
+                            const PathResult &result) {
+  switch (result.failure) {
+  case Failure::StartBlocked:
+    LOG_WARN("Pathfinding: Start position (%d, %d) is not walkable", start.x,
+             start.y);
+    break;
+  case Failure::EndBlocked:
+    LOG_WARN("Pathfinding: End position (%d, %d) is not walkable", end.x,
+             end.y);
+    break;
+  case Failure::None:
+    break;
+  }
+}
 
-  // Create start node
-  Node *startNode = m_NodePool->acquire(request.start);
-  startNode->gCost = 0.0f;
-  startNode->hCost = request.allowDiagonal
-                         ? heuristicOctile(request.start, request.end)
-                         : heuristicManhattan(request.start, request.end);
-  startNode->fCost = startNode->gCost + startNode->hCost;
+Pathfinder::PathResult
+Pathfinder::searchGrid(const PathRequest &request, const CostSource &costs,
+                       SearchSpace &search,
+                       std::chrono::steady_clock::time_point startTime) {
+  using Clock = std::chrono::steady_clock;
+  auto elapsedMs = [&startTime]() {
+    return std::chrono::duration<float, std::milli>(Clock::now() - startTime)
+        .count();
+  };
+
+  // Jump Point Search only prunes correctly when every step costs the same
+  const NavGrid *grid = costs.grid();
+  if (request.algorithm == Algorithm::JPS && request.allowDiagonal && grid &&
+      grid->isUniform()) {
+    return findPathJPS(request, costs, *grid, search, startTime);
+  }
 
-  openSet.push(startNode);
-  nodeMap[request.start] = startNode;
+  PathResult result;
+  const int width = costs.getWidth();
+  const int height = costs.getHeight();
+  search.begin(width, height);
 
-  Node *closestNode = startNode; // For partial paths
-  float closestDistance = startNode->hCost;
+  const int32_t startIndex = request.start.y * width + request.start.x;
+  const int32_t goalIndex = request.end.y * width + request.end.x;
+
+  float startH = request.allowDiagonal
+                     ? heuristicOctile(request.start, request.end)
+                     : heuristicManhattan(request.start, request.end);
+  search.open(startIndex, 0.0f, startH, SearchSpace::kNone);
+
+  int32_t closestIndex = startIndex; // For partial paths
+  float closestDistance = startH;
 
   // Neighbor offsets (4-way or 8-way)
   const Point neighbors4[] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
@@ -199,8 +1131,17 @@ Pathfinder::findPathInternal(const PathRequest &request) {
   const Point *neighbors = request.allowDiagonal ? neighbors8 : neighbors4;
   const int neighborCount = request.allowDiagonal ? 8 : 4;
 
+  auto buildPath = [&](int32_t index) {
+    Path path;
+    for (; index != SearchSpace::kNone; index = search.node(index).parent) {
+      path.push_back({index % width, index / width});
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+  };
+
   // A* main loop
-  while (!openSet.empty()) {
+  while (!search.empty()) {
     // Check limits
     result.nodesExpanded++;
     if (result.nodesExpanded > request.maxSteps) {
@@ -208,72 +1149,58 @@ Pathfinder::findPathInternal(const PathRequest &request) {
       break;
     }
 
-    auto elapsed = std::chrono::high_resolution_clock::now() - startTime;
-    float elapsedMs = std::chrono::duration<float, std::milli>(elapsed).count();
-    if (elapsedMs > request.maxTimeMs) {
+    if (result.nodesExpanded % kTimeCheckInterval == 0 &&
+        elapsedMs() > request.maxTimeMs) {
       result.partial = true;
       break;
     }
 
-    // Get node with lowest f-cost
-    Node *current = openSet.top();
-    openSet.pop();
-
-    // Skip if already in closed set (can happen due to priority queue)
-    if (closedSet.count(current->point)) {
-      continue;
-    }
-
-    closedSet.insert(current->point);
-    current->inClosedSet = true;
+    // Node with lowest f-cost (closed from here on)
+    int32_t current = search.pop();
+    const SearchSpace::Node &currentNode = search.node(current);
 
     // Check if we reached the goal
-    if (current->point == request.end) {
-      // Reconstruct path
+    if (current == goalIndex) {
       result.found = true;
-      Node *node = current;
-      while (node != nullptr) {
-        result.path.push_back(node->point);
-        node = node->parent;
-      }
-      std::reverse(result.path.begin(), result.path.end());
+      result.path = buildPath(current);
 
       // Apply path smoothing if requested
       if (request.smoothPath && result.path.size() > 2) {
-        result.path = smoothPath(result.path, request);
+        result.path = smoothPath(result.path, costs);
       }
 
-      auto endTime = std::chrono::high_resolution_clock::now();
-      result.timeMs =
-          std::chrono::duration<float, std::milli>(endTime - startTime).count();
+      result.timeMs = elapsedMs();
       return result;
     }
 
     // Track closest node for partial paths
-    if (current->hCost < closestDistance) {
-      closestNode = current;
-      closestDistance = current->hCost;
+    if (currentNode.hCost < closestDistance) {
+      closestIndex = current;
+      closestDistance = currentNode.hCost;
     }
 
+    const int cx = current % width;
+    const int cy = current / width;
+    const float currentG = currentNode.gCost;
+
     // Explore neighbors
     for (int i = 0; i < neighborCount; i++) {
-      Point neighborPoint = {current->point.x + neighbors[i].x,
-                             current->point.y + neighbors[i].y};
+      Point neighborPoint = {cx + neighbors[i].x, cy + neighbors[i].y};
 
       // Check bounds
       if (neighborPoint.x < 0 || neighborPoint.y < 0 ||
-          neighborPoint.x >= m_Map.getWidth() ||
-          neighborPoint.y >= m_Map.getHeight()) {
+          neighborPoint.x >= width || neighborPoint.y >= height) {
         continue;
       }
 
-      // Check if in closed set
-      if (closedSet.count(neighborPoint)) {
+      int32_t neighbor = neighborPoint.y * width + neighborPoint.x;
+      if (search.closed(neighbor)) {
         continue;
       }
 
-      // Check walkability
-      if (!isWalkableInternal(neighborPoint.x, neighborPoint.y, request)) {
+      // Tile cost (negative = unwalkable)
+      float tileCost = costs.cost(neighborPoint.x, neighborPoint.y);
+      if (tileCost < 0.0f) {
         continue;
       }
 
@@ -283,74 +1210,661 @@ Pathfinder::findPathInternal(const PathRequest &request) {
         // Diagonal movement
         moveCost = 1.414f; // sqrt(2)
       }
+      float tentativeGCost = currentG + moveCost * tileCost;
+
+      if (!search.visited(neighbor)) {
+        float hCost = request.allowDiagonal
+                          ? heuristicOctile(neighborPoint, request.end)
+                          : heuristicManhattan(neighborPoint, request.end);
+        search.open(neighbor, tentativeGCost, hCost, current);
+      } else if (tentativeGCost < search.node(neighbor).gCost) {
+        search.decrease(neighbor, tentativeGCost, current);
+      }
+    }
+  }
 
-      // Get tile cost
-      float tileCost =
-          getCostInternal(neighborPoint.x, neighborPoint.y, request);
-      if (tileCost < 0.0f) {
-        continue; // Unwalkable
+  // No path found, but return partial path if requested
+  if (result.partial && closestIndex != startIndex) {
+    result.found = false;
+    result.path = buildPath(closestIndex);
+  }
+
+  result.timeMs = elapsedMs();
+  return result;
+}
+
+// ============================================================================
+// Jump Point Search
+// ============================================================================
+
+namespace {
+
+/**
+ * 64 bits of a packed line starting at bit `start` (may be negative).
+ * Bits outside the line, or a null line, read as blocked (0).
+ */
+uint64_t BitWindow(const uint64_t *line, int words, int start) {
+  if (!line) {
+    return 0;
+  }
+  int word = start >> 6;
+  int shift = start & 63;
+  uint64_t lo = (word >= 0 && word < words) ? line[word] : 0;
+  uint64_t hi = (word + 1 >= 0 && word + 1 < words) ? line[word + 1] : 0;
+  return shift ? (lo >> shift) | (hi << (64 - shift)) : lo;
+}
+
+/**
+ * Straight jump along one packed line, 64 tiles per step. Starting after
+ * `from` and moving by `dir` (+1/-1), find the first tile that is the goal
+ * or has a forced neighbor: a side line that is blocked beside this tile
+ * but open one tile further on. Returns its position, or -1 if a blocked
+ * tile (or the edge) comes first.
+ */
+int ScanLine(const uint64_t *line, const uint64_t *side1,
+             const uint64_t *side2, int words, int from, int dir, int goal) {
+  if (dir > 0) {
+    for (int pos = from + 1;; pos += 64) {
+      uint64_t open = BitWindow(line, words, pos);
+      uint64_t forced =
+          (BitWindow(side1, words, pos + 1) & ~BitWindow(side1, words, pos)) |
+          (BitWindow(side2, words, pos + 1) & ~BitWindow(side2, words, pos));
+      uint64_t stop = ~open | forced;
+      if (goal >= pos && goal < pos + 64) {
+        stop |= uint64_t{1} << (goal - pos);
+      }
+      if (stop) {
+        int bit = std::countr_zero(stop);
+        return ((open >> bit) & 1) ? pos + bit : -1;
+      }
+    }
+  }
+
+  for (int pos = from - 1;; pos -= 64) {
+    int start = pos - 63;
+    uint64_t open = BitWindow(line, words, start);
+    uint64_t forced =
+        (BitWindow(side1, words, start - 1) & ~BitWindow(side1, words, start)) |
+        (BitWindow(side2, words, start - 1) & ~BitWindow(side2, words, start));
+    uint64_t stop = ~open | forced;
+    if (goal >= start && goal <= pos) {
+      stop |= uint64_t{1} << (goal - start);
+    }
+    if (stop) {
+      int bit = 63 - std::countl_zero(stop);
+      return ((open >> bit) & 1) ? start + bit : -1;
+    }
+  }
+}
+
+int Sign(int value) { return (value > 0) - (value < 0); }
+
+} // namespace
+
+/**
+ * Jump rules for an 8-connected grid where diagonal steps may cut corners
+ * (matching the A* neighbor rules). Straight jumps scan the row or the
+ * transposed column bits; diagonal jumps step one tile at a time and
+ * launch a straight scan along both axes from each tile.
+ */
+class Pathfinder::JumpScanner {
+public:
+  JumpScanner(const NavGrid &grid, const Point &goal)
+      : m_Grid(grid), m_Width(grid.getWidth()), m_Goal(goal) {}
+
+  bool walkable(int x, int y) const { return m_Grid.walkable(x, y); }
+
+  /**
+   * Next jump point from (x, y) in direction (dx, dy), as a tile index,
+   * or -1 if there is none.
+   */
+  int32_t jump(int x, int y, int dx, int dy) const {
+    if (dx != 0 && dy != 0) {
+      return jumpDiagonal(x, y, dx, dy);
+    }
+    return jumpStraight(x, y, dx, dy);
+  }
+
+private:
+  int32_t jumpStraight(int x, int y, int dx, int dy) const {
+    if (dy == 0) {
+      int goal = m_Goal.y == y ? m_Goal.x : -1;
+      int nx = ScanLine(m_Grid.row(y), m_Grid.row(y - 1), m_Grid.row(y + 1),
+                        m_Grid.rowWords(), x, dx, goal);
+      return nx < 0 ? -1 : y * m_Width + nx;
+    }
+    int goal = m_Goal.x == x ? m_Goal.y : -1;
+    int ny = ScanLine(m_Grid.column(x), m_Grid.column(x - 1),
+                      m_Grid.column(x + 1), m_Grid.columnWords(), y, dy, goal);
+    return ny < 0 ? -1 : ny * m_Width + x;
+  }
+
+  int32_t jumpDiagonal(int x, int y, int dx, int dy) const {
+    for (;;) {
+      x += dx;
+      y += dy;
+      if (!walkable(x, y)) {
+        return -1;
+      }
+
+      int32_t index = y * m_Width + x;
+      if (x == m_Goal.x && y == m_Goal.y) {
+        return index;
       }
 
-      moveCost *= tileCost;
+      // Forced neighbors behind the diagonal
+      if ((walkable(x - dx, y + dy) && !walkable(x - dx, y)) ||
+          (walkable(x + dx, y - dy) && !walkable(x, y - dy))) {
+        return index;
+      }
+
+      // Anything reachable straight from here makes this a jump point
+      if (jumpStraight(x, y, dx, 0) >= 0 || jumpStraight(x, y, 0, dy) >= 0) {
+        return index;
+      }
+    }
+  }
+
+  const NavGrid &m_Grid;
+  int m_Width;
+  Point m_Goal;
+};
 
-      float tentativeGCost = current->gCost + moveCost;
+Pathfinder::PathResult
+Pathfinder::findPathJPS(const PathRequest &request, const CostSource &costs,
+                        const NavGrid &grid, SearchSpace &search,
+                        std::chrono::steady_clock::time_point startTime) {
+  using Clock = std::chrono::steady_clock;
+  auto elapsedMs = [&startTime]() {
+    return std::chrono::duration<float, std::milli>(Clock::now() - startTime)
+        .count();
+  };
 
-      // Get or create neighbor node
-      Node *neighborNode = nullptr;
-      auto it = nodeMap.find(neighborPoint);
-      if (it != nodeMap.end()) {
-        neighborNode = it->second;
+  PathResult result;
+  result.algorithm = Algorithm::JPS;
+
+  const int width = grid.getWidth();
+  search.begin(width, grid.getHeight());
+
+  const JumpScanner scanner(grid, request.end);
+  const float tileCost = grid.uniformCost();
+
+  const int32_t startIndex = request.start.y * width + request.start.x;
+  const int32_t goalIndex = request.end.y * width + request.end.x;
+
+  float startH = heuristicOctile(request.start, request.end);
+  search.open(startIndex, 0.0f, startH, SearchSpace::kNone);
+
+  int32_t closestIndex = startIndex; // For partial paths
+  float closestDistance = startH;
+
+  // Jump points are joined by straight or diagonal runs; fill in the tiles
+  auto buildPath = [&](int32_t index) {
+    Path path = {{index % width, index / width}};
+    for (int32_t parent = search.node(index).parent;
+         parent != SearchSpace::kNone;
+         index = parent, parent = search.node(index).parent) {
+      Point from = {parent % width, parent / width};
+      Point step = path.back();
+      int dx = Sign(from.x - step.x);
+      int dy = Sign(from.y - step.y);
+      while (step != from) {
+        step.x += dx;
+        step.y += dy;
+        path.push_back(step);
+      }
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+  };
+
+  const Point allDirections[] = {{0, -1},  {1, 0},  {0, 1},  {-1, 0},
+                                 {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
+  // JPS main loop
+  while (!search.empty()) {
+    // Check limits
+    result.nodesExpanded++;
+    if (result.nodesExpanded > request.maxSteps) {
+      result.partial = true;
+      break;
+    }
+
+    if (result.nodesExpanded % kTimeCheckInterval == 0 &&
+        elapsedMs() > request.maxTimeMs) {
+      result.partial = true;
+      break;
+    }
+
+    int32_t current = search.pop();
+    const SearchSpace::Node &currentNode = search.node(current);
+
+    if (current == goalIndex) {
+      result.found = true;
+      result.path = buildPath(current);
+
+      if (request.smoothPath && result.path.size() > 2) {
+        result.path = smoothPath(result.path, costs);
+      }
+
+      result.timeMs = elapsedMs();
+      return result;
+    }
+
+    if (currentNode.hCost < closestDistance) {
+      closestIndex = current;
+      closestDistance = currentNode.hCost;
+    }
+
+    const int cx = current % width;
+    const int cy = current / width;
+    const float currentG = currentNode.gCost;
+
+    // Pruned directions: keep moving the way we came, plus forced turns
+    Point directions[8];
+    int directionCount = 0;
+    if (currentNode.parent == SearchSpace::kNone) {
+      std::copy(std::begin(allDirections), std::end(allDirections),
+                directions);
+      directionCount = 8;
+    } else {
+      int dx = Sign(cx - currentNode.parent % width);
+      int dy = Sign(cy - currentNode.parent / width);
+      if (dx != 0 && dy != 0) {
+        directions[directionCount++] = {0, dy};
+        directions[directionCount++] = {dx, 0};
+        directions[directionCount++] = {dx, dy};
+        if (!scanner.walkable(cx - dx, cy)) {
+          directions[directionCount++] = {-dx, dy};
+        }
+        if (!scanner.walkable(cx, cy - dy)) {
+          directions[directionCount++] = {dx, -dy};
+        }
+      } else if (dx != 0) {
+        directions[directionCount++] = {dx, 0};
+        if (!scanner.walkable(cx, cy + 1)) {
+          directions[directionCount++] = {dx, 1};
+        }
+        if (!scanner.walkable(cx, cy - 1)) {
+          directions[directionCount++] = {dx, -1};
+        }
       } else {
-        neighborNode = m_NodePool->acquire(neighborPoint);
-        nodeMap[neighborPoint] = neighborNode;
+        directions[directionCount++] = {0, dy};
+        if (!scanner.walkable(cx + 1, cy)) {
+          directions[directionCount++] = {1, dy};
+        }
+        if (!scanner.walkable(cx - 1, cy)) {
+          directions[directionCount++] = {-1, dy};
+        }
+      }
+    }
+
+    for (int i = 0; i < directionCount; i++) {
+      const Point &dir = directions[i];
+      int32_t jumpPoint = scanner.jump(cx, cy, dir.x, dir.y);
+      if (jumpPoint < 0 || search.closed(jumpPoint)) {
+        continue;
       }
 
-      // Check if this is a better path
-      if (neighborNode->parent == nullptr ||
-          tentativeGCost < neighborNode->gCost) {
-        neighborNode->parent = current;
-        neighborNode->gCost = tentativeGCost;
-        neighborNode->hCost =
-            request.allowDiagonal
-                ? heuristicOctile(neighborPoint, request.end)
-                : heuristicManhattan(neighborPoint, request.end);
-        neighborNode->fCost = neighborNode->gCost + neighborNode->hCost;
+      Point jumpTo = {jumpPoint % width, jumpPoint / width};
+      int steps = std::max(std::abs(jumpTo.x - cx), std::abs(jumpTo.y - cy));
+      float moveCost = (dir.x != 0 && dir.y != 0) ? 1.414f : 1.0f;
+      float tentativeGCost = currentG + steps * moveCost * tileCost;
 
-        openSet.push(neighborNode);
+      if (!search.visited(jumpPoint)) {
+        search.open(jumpPoint, tentativeGCost,
+                    heuristicOctile(jumpTo, request.end), current);
+      } else if (tentativeGCost < search.node(jumpPoint).gCost) {
+        search.decrease(jumpPoint, tentativeGCost, current);
       }
     }
   }
 
-  // No path found, but return partial path if requested
-  if (result.partial && closestNode != startNode) {
+  if (result.partial && closestIndex != startIndex) {
     result.found = false;
-    result.partial = true;
+    result.path = buildPath(closestIndex);
+  }
+
+  result.timeMs = elapsedMs();
+  return result;
+}
 
-    // Reconstruct partial path to closest node
-    Node *node = closestNode;
-    while (node != nullptr) {
-      result.path.push_back(node->point);
-      node = node->parent;
+// ============================================================================
+// Hierarchical A* (HPA*)
+// ============================================================================
+
+Pathfinder::PathResult
+Pathfinder::findPathHPA(const PathRequest &request, const NavGrid &grid,
+                        std::chrono::steady_clock::time_point startTime) {
+  using Clock = std::chrono::steady_clock;
+  auto elapsedMs = [&startTime]() {
+    return std::chrono::duration<float, std::milli>(Clock::now() - startTime)
+        .count();
+  };
+
+  PathResult result;
+  result.algorithm = Algorithm::HPA;
+
+  const CostSource costs = getCostSource(request);
+  ClusterGraph &graph =
+      getClusterGraph(request.navigationLayer, grid, request.allowDiagonal);
+  const int width = grid.getWidth();
+  const int32_t startIndex = request.start.y * width + request.start.x;
+  const int32_t goalIndex = request.end.y * width + request.end.x;
+
+  // Connect start and goal to the entrances of their clusters
+  const ClusterGraph::Cluster &startCluster =
+      graph.cluster(graph.clusterAt(request.start.x, request.start.y));
+  const ClusterGraph::Cluster &goalCluster =
+      graph.cluster(graph.clusterAt(request.end.x, request.end.y));
+  std::vector<float> startDistances;
+  std::vector<float> goalDistances;
+  graph.distances(startCluster, startIndex, false, startDistances);
+  graph.distances(goalCluster, goalIndex, true, goalDistances);
+
+  auto heuristic = [&](int32_t tile) {
+    Point point = {tile % width, tile / width};
+    return request.allowDiagonal ? heuristicOctile(point, request.end)
+                                 : heuristicManhattan(point, request.end);
+  };
+
+  // Abstract search over entrance tiles, reusing the dense search space
+  SearchSpace &search = *m_Search;
+  search.begin(width, grid.getHeight());
+  search.open(startIndex, 0.0f, heuristic(startIndex), SearchSpace::kNone);
+
+  auto relax = [&](int32_t tile, float gCost, int32_t parent) {
+    if (search.closed(tile)) {
+      return;
+    }
+    if (!search.visited(tile)) {
+      search.open(tile, gCost, heuristic(tile), parent);
+    } else if (gCost < search.node(tile).gCost) {
+      search.decrease(tile, gCost, parent);
+    }
+  };
+
+  int32_t closestIndex = startIndex; // For partial paths
+  float closestDistance = search.node(startIndex).hCost;
+  bool reached = false;
+
+  while (!search.empty()) {
+    // Check limits
+    result.nodesExpanded++;
+    if (result.nodesExpanded > request.maxSteps) {
+      result.partial = true;
+      break;
+    }
+
+    if (result.nodesExpanded % kTimeCheckInterval == 0 &&
+        elapsedMs() > request.maxTimeMs) {
+      result.partial = true;
+      break;
+    }
+
+    int32_t current = search.pop();
+    if (current == goalIndex) {
+      reached = true;
+      break;
+    }
+
+    const SearchSpace::Node &currentNode = search.node(current);
+    if (currentNode.hCost < closestDistance) {
+      closestIndex = current;
+      closestDistance = currentNode.hCost;
+    }
+    const float currentG = currentNode.gCost;
+
+    const ClusterGraph::Cluster &cluster = graph.cluster(
+        graph.clusterAt(current % width, current / width));
+    const size_t count = cluster.entrances.size();
+    const int slot = ClusterGraph::entranceSlot(cluster, current);
+
+    // Across the cluster
+    if (current == startIndex) {
+      for (size_t j = 0; j < count; j++) {
+        if (startDistances[j] != ClusterGraph::kUnreachable) {
+          relax(cluster.entrances[j], currentG + startDistances[j], current);
+        }
+      }
+    } else if (slot >= 0) {
+      for (size_t j = 0; j < count; j++) {
+        float distance = cluster.distances[slot * count + j];
+        if (j != static_cast<size_t>(slot) &&
+            distance != ClusterGraph::kUnreachable) {
+          relax(cluster.entrances[j], currentG + distance, current);
+        }
+      }
+    }
+
+    if (slot < 0) {
+      continue;
+    }
+
+    // Across borders, one step into the neighbor cluster
+    for (int32_t partner : cluster.partners[slot]) {
+      if (partner >= 0) {
+        relax(partner, currentG + grid.cost(partner % width, partner / width),
+              current);
+      }
+    }
+
+    // Down to the goal
+    if (&cluster == &goalCluster &&
+        goalDistances[slot] != ClusterGraph::kUnreachable) {
+      relax(goalIndex, currentG + goalDistances[slot], current);
     }
-    std::reverse(result.path.begin(), result.path.end());
   }
 
-  auto endTime = std::chrono::high_resolution_clock::now();
-  result.timeMs =
-      std::chrono::duration<float, std::milli>(endTime - startTime).count();
+  int32_t last = reached ? goalIndex
+                 : (result.partial && closestIndex != startIndex)
+                     ? closestIndex
+                     : SearchSpace::kNone;
+  if (last == SearchSpace::kNone) {
+    result.timeMs = elapsedMs();
+    return result;
+  }
 
+  std::vector<int32_t> waypoints;
+  for (int32_t index = last; index != SearchSpace::kNone;
+       index = search.node(index).parent) {
+    waypoints.push_back(index);
+  }
+  std::reverse(waypoints.begin(), waypoints.end());
+
+  // Refine each abstract hop with a local A* search (this reuses the
+  // search space, so the waypoints were copied out first)
+  PathRequest leg = request;
+  leg.algorithm = Algorithm::AStar;
+  leg.smoothPath = false;
+
+  Path path = {request.start};
+  for (size_t i = 1; i < waypoints.size(); i++) {
+    Point from = {waypoints[i - 1] % width, waypoints[i - 1] / width};
+    Point to = {waypoints[i] % width, waypoints[i] / width};
+    if (std::abs(to.x - from.x) + std::abs(to.y - from.y) == 1) {
+      path.push_back(to);
+      continue;
+    }
+
+    leg.start = from;
+    leg.end = to;
+    leg.maxTimeMs = std::max(0.0f, request.maxTimeMs - elapsedMs());
+    PathResult hop = searchGrid(leg, costs, search, Clock::now());
+    result.nodesExpanded += hop.nodesExpanded;
+    if (!hop.found) {
+      reached = false;
+      result.partial = true;
+      break;
+    }
+    path.insert(path.end(), hop.path.begin() + 1, hop.path.end());
+  }
+
+  result.found = reached;
+  result.path = std::move(path);
+  if (result.path.size() < 2 && !result.found) {
+    result.path.clear();
+  }
+
+  if (result.found && request.smoothPath && result.path.size() > 2) {
+    result.path = smoothPath(result.path, costs);
+  }
+
+  result.timeMs = elapsedMs();
   return result;
 }
 
+// ============================================================================
+// Flow Fields
+// ============================================================================
+
+std::shared_ptr<const Pathfinder::FlowField>
+Pathfinder::getFlowField(const Point &goal, const std::string &layer,
+                         bool allowDiagonal) {
+  const NavGrid &grid = getNavGrid(layer);
+
+  for (auto it = m_FlowFields.begin(); it != m_FlowFields.end(); ++it) {
+    if (it->goal == goal && it->diagonal == allowDiagonal &&
+        it->layer == layer) {
+      // Move to the back (most recently used)
+      std::rotate(it, it + 1, m_FlowFields.end());
+      return m_FlowFields.back().field;
+    }
+  }
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto field = buildFlowField(goal, grid, allowDiagonal);
+  LOG_DEBUG("Pathfinding: built flow field to (%d, %d) on '%s' in %.2f ms",
+            goal.x, goal.y, layer.c_str(),
+            std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - startTime)
+                .count());
+
+  if (m_FlowFields.size() >= kFlowFieldCacheSize) {
+    m_FlowFields.erase(m_FlowFields.begin());
+  }
+  m_FlowFields.push_back({layer, goal, allowDiagonal, field});
+  return field;
+}
+
+std::shared_ptr<Pathfinder::FlowField>
+Pathfinder::buildFlowField(const Point &goal, const NavGrid &grid,
+                           bool allowDiagonal) {
+  const int width = grid.getWidth();
+  const int height = grid.getHeight();
+  const size_t count = static_cast<size_t>(width) * height;
+
+  auto field = std::make_shared<FlowField>();
+  field->m_Goal = goal;
+  field->m_Width = width;
+  field->m_Height = height;
+  field->m_Distance.assign(count, -1.0f);
+  field->m_Steps.assign(count, FlowField::kNoStep);
+
+  if (goal.x < 0 || goal.y < 0 || goal.x >= width || goal.y >= height ||
+      grid.cost(goal.x, goal.y) < 0.0f) {
+    LOG_WARN("Pathfinding: flow field goal (%d, %d) is not walkable", goal.x,
+             goal.y);
+    return field;
+  }
+
+  // Same neighbor order and step costs as A*; searching backwards, moving
+  // from a neighbor onto the current tile costs step * cost(current)
+  const Point neighbors[] = {{0, -1},  {1, 0},  {0, 1},  {-1, 0},
+                             {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+  const int neighborCount = allowDiagonal ? 8 : 4;
+
+  SearchSpace &search = *m_Search;
+  search.begin(width, height);
+  search.open(goal.y * width + goal.x, 0.0f, 0.0f, SearchSpace::kNone);
+
+  while (!search.empty()) {
+    int32_t current = search.pop();
+    const int cx = current % width;
+    const int cy = current / width;
+    const float currentG = search.node(current).gCost;
+    const float enterCost = grid.cost(cx, cy);
+
+    for (int i = 0; i < neighborCount; i++) {
+      int nx = cx + neighbors[i].x;
+      int ny = cy + neighbors[i].y;
+      if (nx < 0 || ny < 0 || nx >= width || ny >= height ||
+          grid.cost(nx, ny) < 0.0f) {
+        continue;
+      }
+
+      int32_t neighbor = ny * width + nx;
+      if (search.closed(neighbor)) {
+        continue;
+      }
+
+      float g = currentG + (i >= 4 ? 1.414f : 1.0f) * enterCost;
+      if (!search.visited(neighbor)) {
+        search.open(neighbor, g, 0.0f, current);
+      } else if (g < search.node(neighbor).gCost) {
+        search.decrease(neighbor, g, current);
+      }
+    }
+  }
+
+  // Every reached tile is closed; its parent is the next step to the goal
+  for (int32_t index = 0; index < static_cast<int32_t>(count); index++) {
+    if (!search.visited(index)) {
+      continue;
+    }
+    const SearchSpace::Node &node = search.node(index);
+    field->m_Distance[index] = node.gCost;
+    if (node.parent != SearchSpace::kNone) {
+      int dx = node.parent % width - index % width;
+      int dy = node.parent / width - index / width;
+      field->m_Steps[index] = static_cast<uint8_t>((dx + 1) + (dy + 1) * 3);
+    }
+  }
+  return field;
+}
+
+void Pathfinder::dropFlowFields(const std::string &layer, int x0, int y0,
+                                int x1, int y1) const {
+  auto reaches = [&](const FlowField &field) {
+    if (x1 < x0) {
+      return true; // Whole layer
+    }
+    // A tile next to the field's reachable area may have become walkable
+    int bx0 = std::max(x0 - 1, 0);
+    int by0 = std::max(y0 - 1, 0);
+    int bx1 = std::min(x1 + 1, field.getWidth());
+    int by1 = std::min(y1 + 1, field.getHeight());
+    for (int y = by0; y < by1; y++) {
+      for (int x = bx0; x < bx1; x++) {
+        if (field.reachable(x, y)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  auto it = std::remove_if(
+      m_FlowFields.begin(), m_FlowFields.end(),
+      [&](const FlowFieldEntry &entry) {
+        if (entry.layer != layer || !reaches(*entry.field)) {
+          return false;
+        }
+        entry.field->m_Stale = true;
+        return true;
+      });
+  m_FlowFields.erase(it, m_FlowFields.end());
+}
+
 // ============================================================================
 // Heuristic Functions
 // ============================================================================
 
-float Pathfinder::heuristicManhattan(const Point &a, const Point &b) const {
+float Pathfinder::heuristicManhattan(const Point &a, const Point &b) {
   return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
 }
 
-float Pathfinder::heuristicOctile(const Point &a, const Point &b) const {
+float Pathfinder::heuristicOctile(const Point &a, const Point &b) {
   int dx = std::abs(a.x - b.x);
   int dy = std::abs(a.y - b.y);
   return static_cast<float>(std::max(dx, dy) + 0.414f * std::min(dx, dy));
@@ -361,7 +1875,7 @@ float Pathfinder::heuristicOctile(const Point &a, const Point &b) const {
 // ============================================================================
 
 Pathfinder::Path Pathfinder::smoothPath(const Path &rawPath,
-                                        const PathRequest &request) const {
+                                        const CostSource &costs) {
   if (rawPath.size() < 3) {
     return rawPath;
   }
@@ -375,7 +1889,7 @@ Pathfinder::Path Pathfinder::smoothPath(const Path &rawPath,
 
     // Find farthest visible point (check all remaining points)
     for (size_t i = current + 2; i < rawPath.size(); i++) {
-      if (hasLineOfSight(rawPath[current], rawPath[i], request)) {
+      if (hasLineOfSight(rawPath[current], rawPath[i], costs)) {
         farthest = i;
         // Don't break - keep checking for an even farther visible point
       }
@@ -389,7 +1903,7 @@ Pathfinder::Path Pathfinder::smoothPath(const Path &rawPath,
 }
 
 bool Pathfinder::hasLineOfSight(const Point &a, const Point &b,
-                                const PathRequest &request) const {
+                                const CostSource &costs) {
   // Bresenham's line algorithm
   int dx = std::abs(b.x - a.x);
   int dy = std::abs(b.y - a.y);
@@ -402,7 +1916,7 @@ bool Pathfinder::hasLineOfSight(const Point &a, const Point &b,
   while (true) {
     // Check if current tile is walkable
     if (current != a && current != b) {
-      if (!isWalkableInternal(current.x, current.y, request)) {
+      if (!costs.walkable(current.x, current.y)) {
         return false;
       }
     }
@@ -448,28 +1962,93 @@ int Pathfinder::getLayerIndex(const std::string &layerName) const {
   return 0;
 }
 
-bool Pathfinder::isWalkableInternal(int x, int y,
-                                    const PathRequest &request) const {
-  // Check bounds
-  if (x < 0 || y < 0 || x >= m_Map.getWidth() || y >= m_Map.getHeight()) {
-    return false;
+const Pathfinder::NavGrid &
+Pathfinder::getNavGrid(const std::string &layer) const {
+  const int width = m_Map.getWidth();
+  const int height = m_Map.getHeight();
+
+  auto it = m_NavGrids.find(layer);
+  if (it != m_NavGrids.end() && it->second->getWidth() == width &&
+      it->second->getHeight() == height) {
+    return *it->second;
   }
 
-  // Use custom cost function if provided
-  if (request.customCostFn) {
-    float cost = request.customCostFn(x, y);
-    return cost >= 0.0f;
+  // Bake once; tile edits are applied incrementally via onTileChanged
+  auto grid = std::make_unique<NavGrid>(width, height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      grid->set(x, y, readTileCost(x, y, layer));
+    }
   }
+  LOG_DEBUG("Pathfinding: baked cost grid for '%s' (%dx%d)", layer.c_str(),
+            width, height);
+
+  // Cluster graphs, snapshots, flow fields and cached paths describe the
+  // grid being replaced
+  m_ClusterGraphs.erase(layer);
+  m_Snapshots.erase(layer);
+  dropFlowFields(layer);
+  dropCachedPaths(layer);
+
+  auto &slot = m_NavGrids[layer];
+  slot = std::move(grid);
+  return *slot;
+}
 
-  return isWalkable(x, y, request.navigationLayer);
+Pathfinder::CostSource
+Pathfinder::getCostSource(const PathRequest &request) const {
+  const NavGrid *grid =
+      request.customCostFn ? nullptr : &getNavGrid(request.navigationLayer);
+  return CostSource(grid, request, m_Map.getWidth(), m_Map.getHeight());
 }
 
-float Pathfinder::getCostInternal(int x, int y,
-                                  const PathRequest &request) const {
-  // Use custom cost function if provided
-  if (request.customCostFn) {
-    return request.customCostFn(x, y);
+Pathfinder::ClusterGraph &
+Pathfinder::getClusterGraph(const std::string &layer, const NavGrid &grid,
+                            bool diagonal) {
+  auto &graph = m_ClusterGraphs[layer][diagonal ? 1 : 0];
+  if (!graph) {
+    graph = std::make_unique<ClusterGraph>(grid, diagonal);
+  }
+
+  int rebuilt = graph->update();
+  if (rebuilt > 0) {
+    LOG_DEBUG("Pathfinding: rebuilt %d HPA* clusters for '%s'", rebuilt,
+              layer.c_str());
   }
+  return *graph;
+}
 
-  return getCost(x, y, request.navigationLayer);
+std::shared_ptr<const Pathfinder::NavGrid>
+Pathfinder::getSnapshot(const std::string &layer) {
+  const NavGrid &grid = getNavGrid(layer);
+  auto &snapshot = m_Snapshots[layer];
+  if (!snapshot) {
+    snapshot = std::make_shared<const NavGrid>(grid);
+  }
+  return snapshot;
+}
+
+float Pathfinder::readTileCost(int x, int y, const std::string &layer) const {
+  if (getLayerIndex(layer) < 0) {
+    return -1.0f;
+  }
+
+  // Empty tile is walkable by default; otherwise check "walkable" property
+  // (if not set, assume walkable)
+  int tileId = m_Map.getTileId(x, y, layer);
+  if (tileId != 0 && m_Map.getProperty(x, y, "walkable") == "false") {
+    return -1.0f;
+  }
+
+  // Check for custom cost property
+  std::string costProp = m_Map.getProperty(x, y, "cost");
+  if (!costProp.empty()) {
+    try {
+      return std::stof(costProp);
+    } catch (...) {
+      // Invalid cost, use default
+    }
+  }
+
+  return 1.0f; // Default cost
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <list>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -12,6 +16,14 @@ class TileMap;
 /**
  * High-performance A* pathfinding system for tile-based navigation.
  * Integrates with TileMap to read tile properties for traversal costs.
+ * Search state lives in map-sized arrays indexed by y * width + x and
+ * stamped with a per-search generation, so nothing is allocated, hashed or
+ * cleared between searches. Uniform-cost layers can be searched with Jump
+ * Point Search instead, and long queries on large maps with hierarchical
+ * A* over a cached cluster graph (PathRequest::algorithm). Found paths are
+ * kept in an LRU cache until a tile along them changes. Requests can
+ * also be queued to background workers (requestAsync), and agents sharing
+ * a goal can sample one cached flow field instead (getFlowField).
  */
 class Pathfinder {
 public:
@@ -33,6 +45,18 @@ public:
    */
   typedef std::vector<Point> Path;
 
+  /**
+   * Search algorithm.
+   */
+  enum class Algorithm {
+    AStar, // Any tile costs, 4- or 8-way
+    JPS,   // Jump Point Search; needs allowDiagonal and a layer where every
+           // walkable tile has the same cost, otherwise runs as AStar
+    HPA    // Hierarchical A* over cached clusters (near-optimal: tested
+           // to stay within 1.5x of the AStar cost); short queries and
+           // custom cost functions run as AStar
+  };
+
   /**
    * Pathfinding request parameters.
    */
@@ -44,12 +68,22 @@ public:
     int maxSteps = 1000;
     float maxTimeMs = 5.0f;
     bool smoothPath = false;
+    Algorithm algorithm = Algorithm::AStar;
 
     // Optional custom cost function (nullptr = use tile properties)
     // Returns cost multiplier, or negative for unwalkable
     std::function<float(int x, int y)> customCostFn = nullptr;
   };
 
+  /**
+   * Why a request failed before any search ran.
+   */
+  enum class Failure {
+    None,
+    StartBlocked, // Start tile unwalkable or outside the map
+    EndBlocked    // End tile unwalkable or outside the map
+  };
+
   /**
    * Pathfinding result with metadata.
    */
@@ -57,8 +91,77 @@ public:
     Path path;            // Empty if no path found
     bool found = false;   // True if complete path found
     bool partial = false; // True if timeout/maxSteps hit
-    int nodesExpanded = 0;
+    int nodesExpanded = 0; // Tiles (A*) or jump points (JPS) expanded
     float timeMs = 0.0f;
+    Algorithm algorithm = Algorithm::AStar; // Algorithm actually used
+    bool cached = false; // Served from the path cache (nothing expanded)
+    Failure failure = Failure::None;
+  };
+
+  /**
+   * Path cache counters.
+   */
+  struct PathCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidated = 0; // Entries dropped by tile changes
+    size_t size = 0;
+    size_t capacity = 0;
+  };
+
+  /**
+   * Cost-to-goal and next step for every tile, from one Dijkstra pass out
+   * of the goal using the same step costs as A*. Sampling is O(1), so any
+   * number of agents can share it. A field is never modified; once a tile
+   * change could affect it, it is marked stale and dropped from the cache.
+   */
+  class FlowField {
+  public:
+    Point getGoal() const { return m_Goal; }
+    int getWidth() const { return m_Width; }
+    int getHeight() const { return m_Height; }
+
+    /**
+     * Cost to reach the goal from a tile, or -1.0 if it can't.
+     */
+    float distance(int x, int y) const {
+      if (x < 0 || y < 0 || x >= m_Width || y >= m_Height) {
+        return -1.0f;
+      }
+      return m_Distance[static_cast<size_t>(y) * m_Width + x];
+    }
+
+    bool reachable(int x, int y) const { return distance(x, y) >= 0.0f; }
+
+    /**
+     * Step toward the goal ({-1..1, -1..1}); {0, 0} at the goal and on
+     * tiles that can't reach it.
+     */
+    Point direction(int x, int y) const {
+      if (x < 0 || y < 0 || x >= m_Width || y >= m_Height) {
+        return {0, 0};
+      }
+      int code = m_Steps[static_cast<size_t>(y) * m_Width + x];
+      return {code % 3 - 1, code / 3 - 1};
+    }
+
+    /**
+     * True once a tile change may have made this field wrong (fetch a
+     * fresh one with getFlowField).
+     */
+    bool isStale() const { return m_Stale; }
+
+  private:
+    friend class Pathfinder;
+
+    static constexpr uint8_t kNoStep = 4; // (dx + 1) + (dy + 1) * 3
+
+    Point m_Goal = {0, 0};
+    int m_Width = 0;
+    int m_Height = 0;
+    std::vector<float> m_Distance;
+    std::vector<uint8_t> m_Steps;
+    bool m_Stale = false;
   };
 
   /**
@@ -75,76 +178,262 @@ public:
 
   /**
    * Find a path from start to end.
+   * Found paths are cached by (start, end, layer, diagonal, smooth,
+   * algorithm, maxSteps, maxTimeMs) and returned again until a tile along
+   * them changes, so a hit never outlasts the budget it was found with; a
+   * change elsewhere that would allow a cheaper route does not evict them.
+   * Requests with a customCostFn are never cached.
    */
   PathResult findPath(const PathRequest &request);
 
   /**
-   * Check if a specific tile is walkable.
+   * Maximum cached paths (0 disables the cache); shrinking evicts the
+   * least recently used.
+   */
+  void setPathCacheCapacity(size_t capacity);
+
+  PathCacheStats getPathCacheStats() const;
+  void resetPathCacheStats();
+
+  /**
+   * Identifies an async request (unique across all pathfinders).
+   */
+  using Ticket = uint64_t;
+
+  /**
+   * Queue a search on the shared worker pool. It runs against a snapshot
+   * of the layer's cost grid taken now (shared by every request until the
+   * next tile change), so later edits don't affect it. HPA requests run as
+   * AStar. A customCostFn is called on a worker thread.
+   */
+  Ticket requestAsync(const PathRequest &request);
+
+  /**
+   * Take the result of a finished async request. Workers never log; a
+   * request that failed before searching is logged here instead.
+   * @return false while it is queued or running, or if the ticket is
+   * unknown, cancelled or already taken.
+   */
+  bool pollAsync(Ticket ticket, PathResult &result);
+
+  /**
+   * Drop an async request; if it is running, its result is discarded.
+   */
+  void cancelAsync(Ticket ticket);
+
+  /**
+   * Tickets that finished since the last call, in completion order.
+   * Their results stay available to pollAsync until taken.
+   */
+  std::vector<Ticket> takeFinished();
+
+  /**
+   * Async requests queued or running.
+   */
+  size_t pendingAsync() const;
+
+  /**
+   * Flow field toward goal on a layer's baked cost grid, built on first
+   * request and cached (least recently used fields are evicted).
+   */
+  std::shared_ptr<const FlowField>
+  getFlowField(const Point &goal, const std::string &layer = "nav_ground",
+               bool allowDiagonal = true);
+
+  /**
+   * Check if a specific tile is walkable (reads the baked cost grid).
    */
   bool isWalkable(int x, int y, const std::string &layer) const;
 
   /**
-   * Get traversal cost for a tile.
+   * Get traversal cost for a tile (reads the baked cost grid).
    * @return Cost multiplier (>= 0), or -1.0 if unwalkable.
    */
   float getCost(int x, int y, const std::string &layer) const;
 
   /**
-   * Invalidate cached paths in a rectangular region.
+   * Re-read one tile into every baked cost grid.
+   * Hook this to TileMap::addTileChangedListener (the Lua bindings do).
+   */
+  void onTileChanged(int x, int y);
+
+  /**
+   * Re-read tiles in a rectangular region into the baked cost grids,
+   * mark the clusters it touches for rebuild in the HPA* graphs and drop
+   * cached flow fields that reach the region.
    */
   void invalidateRegion(int x, int y, int width, int height);
 
   /**
-   * Clear all internal caches.
+   * Clear all internal caches (cost grids are re-baked on next use).
    */
   void clearCache();
 
-public:
   /**
-   * Internal node structure for A* algorithm.
-   */
-  struct Node {
-    Point point;
-    float gCost = 0.0f;
-    float hCost = 0.0f;
-    float fCost = 0.0f;
-    Node *parent = nullptr;
-    bool inClosedSet = false;
-
-    void reset() {
-      gCost = 0.0f;
-      hCost = 0.0f;
-      fCost = 0.0f;
-      parent = nullptr;
-      inClosedSet = false;
-    }
-  };
+   * The tilemap this pathfinder navigates.
+   */
+  const TileMap &getTileMap() const { return m_Map; }
+
+  /**
+   * Expansions between time-budget checks (reading the clock on every
+   * expansion costs more than expanding a node).
+   */
+  static constexpr int kTimeCheckInterval = 64;
+
+  /**
+   * HPA* cluster edge length in tiles. Queries shorter than two clusters
+   * (octile distance) are answered by plain A*.
+   */
+  static constexpr int kClusterSize = 16;
+
+  /**
+   * Flow fields kept per pathfinder (one per goal, layer and movement).
+   */
+  static constexpr size_t kFlowFieldCacheSize = 8;
+
+  /**
+   * Default path cache capacity.
+   */
+  static constexpr size_t kDefaultPathCacheSize = 256;
 
 private:
-  class NodePool;
+  class SearchSpace;
+  class NavGrid;
+  class CostSource;
+  class JumpScanner;
+  class ClusterGraph;
+  struct AsyncState;
 
   const TileMap &m_Map;
 
   // Layer name -> layer index cache
   mutable std::unordered_map<std::string, int> m_LayerCache;
 
-  // Node pool for allocation reuse
-  std::unique_ptr<NodePool> m_NodePool;
+  // Navigation layer -> baked cost grid (built on first use)
+  mutable std::unordered_map<std::string, std::unique_ptr<NavGrid>>
+      m_NavGrids;
+
+  // Navigation layer -> HPA* cluster graph, [0] 4-way / [1] 8-way
+  // (built on first HPA query, dropped when the layer is re-baked)
+  mutable std::unordered_map<std::string,
+                             std::array<std::unique_ptr<ClusterGraph>, 2>>
+      m_ClusterGraphs;
+
+  // Navigation layer -> read-only copy of its grid for async requests
+  // (taken on demand, dropped on the next change to the layer)
+  mutable std::unordered_map<std::string, std::shared_ptr<const NavGrid>>
+      m_Snapshots;
+
+  // Cached flow fields, most recently used last
+  struct FlowFieldEntry {
+    std::string layer;
+    Point goal;
+    bool diagonal;
+    std::shared_ptr<FlowField> field;
+  };
+  mutable std::vector<FlowFieldEntry> m_FlowFields;
+
+  // Found paths, most recently used first; the index maps request keys
+  // into the list
+  struct PathCacheKey {
+    std::string layer;
+    Point start;
+    Point end;
+    uint8_t flags; // diagonal | smooth << 1 | algorithm << 2
+    int maxSteps;  // A tighter budget may not find the cached path
+    float maxTimeMs;
+
+    bool operator==(const PathCacheKey &other) const {
+      return start == other.start && end == other.end &&
+             flags == other.flags && maxSteps == other.maxSteps &&
+             maxTimeMs == other.maxTimeMs && layer == other.layer;
+    }
+  };
+  struct PathCacheKeyHash {
+    size_t operator()(const PathCacheKey &key) const;
+  };
+  struct PathCacheEntry {
+    PathCacheKey key;
+    PathResult result;
+    int minX, minY, maxX, maxY; // Bounds of the path, inclusive
+  };
+  mutable std::list<PathCacheEntry> m_PathCache;
+  mutable std::unordered_map<PathCacheKey,
+                             std::list<PathCacheEntry>::iterator,
+                             PathCacheKeyHash>
+      m_PathCacheIndex;
+  size_t m_PathCacheCapacity = kDefaultPathCacheSize;
+  mutable PathCacheStats m_PathCacheStats;
+
+  // Dense per-tile search state, reused across searches
+  std::unique_ptr<SearchSpace> m_Search;
+
+  // Async tickets and results, shared with in-flight worker jobs
+  std::shared_ptr<AsyncState> m_Async;
 
   // Internal A* implementation
   PathResult findPathInternal(const PathRequest &request);
 
+  // Trivial requests (start == end, unwalkable endpoints) are answered
+  // here; returns true if a search is still needed. Safe on workers: the
+  // reason for a failure goes in result.failure, it is not logged.
+  static bool checkEndpoints(const PathRequest &request,
+                             const CostSource &costs, PathResult &result);
+
+  // Log result.failure, if any (main thread only: Logger isn't
+  // thread-safe)
+  static void logFailure(const Point &start, const Point &end,
+                         const PathResult &result);
+
+  // A* or JPS over a cost source; touches no Pathfinder state, so workers
+  // can run it with their own search space
+  static PathResult searchGrid(const PathRequest &request,
+                               const CostSource &costs, SearchSpace &search,
+                               std::chrono::steady_clock::time_point startTime);
+
+  // Jump Point Search over the packed walkability bits of a uniform grid
+  static PathResult findPathJPS(const PathRequest &request,
+                                const CostSource &costs, const NavGrid &grid,
+                                SearchSpace &search,
+                                std::chrono::steady_clock::time_point startTime);
+
+  // Hierarchical A*: search the cluster graph, then refine each hop
+  PathResult findPathHPA(const PathRequest &request, const NavGrid &grid,
+                         std::chrono::steady_clock::time_point startTime);
+
+  // Drop cached paths on layer with a step touching the rectangle
+  // (x0, y0)-(x1, y1) exclusive, or every path on layer if it is empty
+  void dropCachedPaths(const std::string &layer, int x0 = 0, int y0 = 0,
+                       int x1 = -1, int y1 = -1) const;
+  void eraseCachedPath(std::list<PathCacheEntry>::iterator it) const;
+
+  // Dijkstra out of the goal over the baked grid
+  std::shared_ptr<FlowField> buildFlowField(const Point &goal,
+                                            const NavGrid &grid,
+                                            bool allowDiagonal);
+
+  // Mark stale and drop cached fields on layer that reach the rectangle
+  // (x0, y0)-(x1, y1) exclusive, or every field on layer if it is empty
+  void dropFlowFields(const std::string &layer, int x0 = 0, int y0 = 0,
+                      int x1 = -1, int y1 = -1) const;
+
   // Heuristic functions
-  float heuristicManhattan(const Point &a, const Point &b) const;
-  float heuristicOctile(const Point &a, const Point &b) const;
+  static float heuristicManhattan(const Point &a, const Point &b);
+  static float heuristicOctile(const Point &a, const Point &b);
 
   // Path smoothing
-  Path smoothPath(const Path &rawPath, const PathRequest &request) const;
-  bool hasLineOfSight(const Point &a, const Point &b,
-                      const PathRequest &request) const;
+  static Path smoothPath(const Path &rawPath, const CostSource &costs);
+  static bool hasLineOfSight(const Point &a, const Point &b,
+                             const CostSource &costs);
 
   // Tile queries
   int getLayerIndex(const std::string &layerName) const;
-  bool isWalkableInternal(int x, int y, const PathRequest &request) const;
-  float getCostInternal(int x, int y, const PathRequest &request) const;
+  const NavGrid &getNavGrid(const std::string &layer) const;
+  CostSource getCostSource(const PathRequest &request) const;
+  ClusterGraph &getClusterGraph(const std::string &layer, const NavGrid &grid,
+                                bool diagonal);
+  std::shared_ptr<const NavGrid> getSnapshot(const std::string &layer);
+
+  // Cost from tile properties (string lookups; used only for baking)
+  float readTileCost(int x, int y, const std::string &layer) const;
 };
@@ -1,7 +1,13 @@
 #include "gameplay/card/Card.h"
 #include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/DiscardOptimizer.h"
+#include "gameplay/cribbage/FastHandEvaluator.h"
 #include "gameplay/cribbage/HandEvaluator.h"
 #include "gameplay/cribbage/ScoringEngine.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
 
 extern "C" {
 #include <lauxlib.h>
@@ -13,16 +19,44 @@ using namespace gameplay;
 
 // ===== Cribbage Bindings =====
 
+// Push a list of card subset masks as a table of 1-indexed card index tables
+static void PushMaskList(lua_State *L, const uint8_t *masks, int count) {
+  lua_createtable(L, count, 0);
+  for (int i = 0; i < count; ++i) {
+    lua_createtable(L, std::popcount(masks[i]), 0);
+    int n = 0;
+    for (unsigned bits = masks[i]; bits != 0; bits &= bits - 1) {
+      lua_pushinteger(L, std::countr_zero(bits) + 1); // Lua is 1-indexed
+      lua_rawseti(L, -2, ++n);
+    }
+    lua_rawseti(L, -2, i + 1);
+  }
+}
+
+// Append the strings of the array at stack index idx to out
+static void ReadStringList(lua_State *L, int idx,
+                           std::vector<std::string> &out) {
+  idx = lua_absindex(L, idx);
+  size_t len = lua_rawlen(L, idx);
+  for (size_t i = 1; i <= len; ++i) {
+    lua_rawgeti(L, idx, i);
+    if (lua_isstring(L, -1)) {
+      out.push_back(lua_tostring(L, -1));
+    }
+    lua_pop(L, 1);
+  }
+}
+
 static int Lua_CribbageEvaluate(lua_State *L) {
   // Expect table of 4 cards (hand) and 1 card (cut)
   luaL_checktype(L, 1, LUA_TTABLE);
 
   // Extract hand cards
-  std::vector<Card> hand;
+  std::array<Card, 4> hand;
   for (int i = 1; i <= 4; ++i) {
     lua_rawgeti(L, 1, i);
     Card *card = (Card *)luaL_checkudata(L, -1, "MagicHands.Card");
-    hand.push_back(*card);
+    hand[i - 1] = *card;
     lua_pop(L, 1);
   }
 
@@ -31,46 +65,23 @@ static int Lua_CribbageEvaluate(lua_State *L) {
   Card *cutCard = (Card *)luaL_checkudata(L, -1, "MagicHands.Card");
   lua_pop(L, 1);
 
-  // Evaluate hand
-  HandEvaluator::HandResult result = HandEvaluator::Evaluate(hand, *cutCard);
+  // Evaluate hand (allocation-free, combos as card subset masks)
+  FastHandEvaluator::HandResult result =
+      FastHandEvaluator::Evaluate(hand, *cutCard);
 
   // Return result as Lua table
   lua_newtable(L);
 
   // Fifteens
-  lua_newtable(L);
-  for (size_t i = 0; i < result.fifteens.size(); ++i) {
-    lua_newtable(L);
-    for (size_t j = 0; j < result.fifteens[i].size(); ++j) {
-      lua_pushinteger(L, result.fifteens[i][j] + 1); // Lua is 1-indexed
-      lua_rawseti(L, -2, j + 1);
-    }
-    lua_rawseti(L, -2, i + 1);
-  }
+  PushMaskList(L, result.fifteens.data(), result.fifteenCount);
   lua_setfield(L, -2, "fifteens");
 
   // Pairs
-  lua_newtable(L);
-  for (size_t i = 0; i < result.pairs.size(); ++i) {
-    lua_newtable(L);
-    for (size_t j = 0; j < result.pairs[i].size(); ++j) {
-      lua_pushinteger(L, result.pairs[i][j] + 1); // Lua is 1-indexed
-      lua_rawseti(L, -2, j + 1);
-    }
-    lua_rawseti(L, -2, i + 1);
-  }
+  PushMaskList(L, result.pairs.data(), result.pairCount);
   lua_setfield(L, -2, "pairs");
 
   // Runs
-  lua_newtable(L);
-  for (size_t i = 0; i < result.runs.size(); ++i) {
-    lua_newtable(L);
-    for (size_t j = 0; j < result.runs[i].size(); ++j) {
-      lua_pushinteger(L, result.runs[i][j] + 1); // Lua is 1-indexed
-      lua_rawseti(L, -2, j + 1);
-    }
-    lua_rawseti(L, -2, i + 1);
-  }
+  PushMaskList(L, result.runs.data(), result.runCount);
   lua_setfield(L, -2, "runs");
 
   // Flush count
@@ -111,14 +122,7 @@ static int Lua_CribbageScore(lua_State *L) {
   // Optional: boss rules (table of strings)
   std::vector<std::string> bossRules;
   if (lua_gettop(L) >= 4 && lua_istable(L, 4)) {
-    size_t len = lua_rawlen(L, 4);
-    for (size_t i = 1; i <= len; ++i) {
-      lua_rawgeti(L, 4, i); // Push rule string
-      if (lua_isstring(L, -1)) {
-        bossRules.push_back(lua_tostring(L, -1));
-      }
-      lua_pop(L, 1);
-    }
+    ReadStringList(L, 4, bossRules);
   }
 
   // Check for warp_inversion - modify card values before evaluation
@@ -142,11 +146,9 @@ static int Lua_CribbageScore(lua_State *L) {
     // based on low cards. Actually, let's implement this properly in ScoringEngine.
   }
   
-  // Evaluate and score
-  HandEvaluator::HandResult handResult =
-      HandEvaluator::Evaluate(evalHand, evalCut);
-  ScoringEngine::ScoreResult scoreResult =
-      ScoringEngine::CalculateScore(handResult, tempMult, permMult, bossRules);
+  // Score via the precomputed pattern table (no HandEvaluator pass)
+  ScoringEngine::ScoreResult scoreResult = ScoringEngine::CalculateScore(
+      evalHand, evalCut, tempMult, permMult, bossRules);
 
   // Return score result as table
   lua_newtable(L);
@@ -181,6 +183,165 @@ static int Lua_CribbageScore(lua_State *L) {
   return 1;
 }
 
+static int Lua_CribbageBestDiscard(lua_State *L) {
+  // Args: hand (table of 6 cards), optional options table:
+  //   { tempMult = n, permMult = n, bossRules = {..}, cuts = {cards} }
+  luaL_checktype(L, 1, LUA_TTABLE);
+
+  std::array<Card, 6> hand;
+  for (int i = 1; i <= 6; ++i) {
+    lua_rawgeti(L, 1, i);
+    Card *card = (Card *)luaL_checkudata(L, -1, "MagicHands.Card");
+    hand[i - 1] = *card;
+    lua_pop(L, 1);
+  }
+
+  DiscardOptimizer::Options options;
+  if (lua_istable(L, 2)) {
+    lua_getfield(L, 2, "tempMult");
+    options.tempMult = static_cast<float>(luaL_optnumber(L, -1, 0.0));
+    lua_pop(L, 1);
+
+    lua_getfield(L, 2, "permMult");
+    options.permMult = static_cast<float>(luaL_optnumber(L, -1, 0.0));
+    lua_pop(L, 1);
+
+    lua_getfield(L, 2, "bossRules");
+    if (lua_istable(L, -1)) {
+      ReadStringList(L, -1, options.bossRules);
+    }
+    lua_pop(L, 1);
+
+    lua_getfield(L, 2, "cuts");
+    if (lua_istable(L, -1)) {
+      size_t len = lua_rawlen(L, -1);
+      options.cutPool.reserve(len);
+      for (size_t i = 1; i <= len; ++i) {
+        lua_rawgeti(L, -1, i);
+        Card *card = (Card *)luaL_checkudata(L, -1, "MagicHands.Card");
+        options.cutPool.push_back(*card);
+        lua_pop(L, 1);
+      }
+    }
+    lua_pop(L, 1);
+  }
+
+  auto results = DiscardOptimizer::Evaluate(hand, options);
+
+  // Best expected score first (stable: ties keep enumeration order)
+  std::stable_sort(results.begin(), results.end(),
+                   [](const DiscardOptimizer::DiscardStats &a,
+                      const DiscardOptimizer::DiscardStats &b) {
+                     return a.expected > b.expected;
+                   });
+
+  lua_createtable(L, DiscardOptimizer::kDiscardCount, 0);
+  for (int i = 0; i < DiscardOptimizer::kDiscardCount; ++i) {
+    const auto &stats = results[i];
+    lua_createtable(L, 0, 4);
+
+    lua_createtable(L, 2, 0);
+    lua_pushinteger(L, stats.discard[0] + 1); // Lua is 1-indexed
+    lua_rawseti(L, -2, 1);
+    lua_pushinteger(L, stats.discard[1] + 1);
+    lua_rawseti(L, -2, 2);
+    lua_setfield(L, -2, "discard");
+
+    lua_pushnumber(L, stats.expected);
+    lua_setfield(L, -2, "expected");
+
+    lua_pushinteger(L, stats.minScore);
+    lua_setfield(L, -2, "min");
+
+    lua_pushinteger(L, stats.maxScore);
+    lua_setfield(L, -2, "max");
+
+    lua_rawseti(L, -2, i + 1);
+  }
+
+  return 1;
+}
+
+static int Lua_CribbageScoreBatch(lua_State *L) {
+  // Args: hands (string of packed card bytes, or flat table of packed
+  // integers), optional tempMult, permMult, bossRules (shared by all hands).
+  // Each hand is 5 cards (4 hand cards, then the cut); a card packs as
+  // rank (1-13) + 16 * suit (0=H, 1=D, 2=C, 3=S), see Card::toByte.
+  // Returns two flat arrays with one entry per hand: finalScore, baseChips.
+  float tempMult = static_cast<float>(luaL_optnumber(L, 2, 0.0));
+  float permMult = static_cast<float>(luaL_optnumber(L, 3, 0.0));
+
+  std::vector<std::string> bossRules;
+  if (lua_istable(L, 4)) {
+    ReadStringList(L, 4, bossRules);
+  }
+
+  try {
+    std::vector<Card> cards;
+    if (lua_type(L, 1) == LUA_TSTRING) {
+      size_t len = 0;
+      const char *bytes = lua_tolstring(L, 1, &len);
+      cards.reserve(len);
+      for (size_t i = 0; i < len; ++i) {
+        cards.push_back(Card::fromByte(static_cast<uint8_t>(bytes[i])));
+      }
+    } else {
+      luaL_checktype(L, 1, LUA_TTABLE);
+      size_t len = lua_rawlen(L, 1);
+      cards.reserve(len);
+      for (size_t i = 1; i <= len; ++i) {
+        lua_rawgeti(L, 1, i);
+        lua_Integer packed = lua_tointeger(L, -1);
+        lua_pop(L, 1);
+        if (packed < 0 || packed > 0xFF) {
+          throw std::invalid_argument("Invalid packed card value: " +
+                                      std::to_string(packed));
+        }
+        cards.push_back(Card::fromByte(static_cast<uint8_t>(packed)));
+      }
+    }
+
+    std::vector<ScoringEngine::ScoreResult> results(cards.size() / 5);
+    ScoringEngine::ScoreBatch(cards, tempMult, permMult, bossRules, results);
+
+    int count = static_cast<int>(results.size());
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; ++i) {
+      lua_pushinteger(L, results[i].finalScore);
+      lua_rawseti(L, -2, i + 1);
+    }
+
+    lua_createtable(L, count, 0);
+    for (int i = 0; i < count; ++i) {
+      lua_pushinteger(L, results[i].baseChips);
+      lua_rawseti(L, -2, i + 1);
+    }
+
+    return 2;
+  } catch (const std::exception &e) {
+    lua_pushnil(L);
+    lua_pushstring(L, e.what());
+    return 2;
+  }
+}
+
+static int Lua_CribbagePackCards(lua_State *L) {
+  // Args: table of Card userdata -> string of packed bytes for scoreBatch
+  luaL_checktype(L, 1, LUA_TTABLE);
+
+  size_t len = lua_rawlen(L, 1);
+  std::string packed(len, '\0');
+  for (size_t i = 1; i <= len; ++i) {
+    lua_rawgeti(L, 1, i);
+    Card *card = (Card *)luaL_checkudata(L, -1, "MagicHands.Card");
+    packed[i - 1] = static_cast<char>(card->toByte());
+    lua_pop(L, 1);
+  }
+
+  lua_pushlstring(L, packed.data(), packed.size());
+  return 1;
+}
+
 void RegisterCribbageBindings(lua_State *L) {
   // Register cribbage global table
   lua_newtable(L);
@@ -191,5 +352,14 @@ void RegisterCribbageBindings(lua_State *L) {
   lua_pushcfunction(L, Lua_CribbageScore);
   lua_setfield(L, -2, "score");
 
+  lua_pushcfunction(L, Lua_CribbageBestDiscard);
+  lua_setfield(L, -2, "bestDiscard");
+
+  lua_pushcfunction(L, Lua_CribbageScoreBatch);
+  lua_setfield(L, -2, "scoreBatch");
+
+  lua_pushcfunction(L, Lua_CribbagePackCards);
+  lua_setfield(L, -2, "packCards");
+
   lua_setglobal(L, "cribbage");
 }
@@ -2,6 +2,7 @@
 #include "gameplay/cribbage/HandEvaluator.h"
 #include "gameplay/joker/Joker.h"
 #include "gameplay/joker/JokerEffectSystem.h"
+#include "gameplay/joker/JokerRegistry.h"
 
 extern "C" {
 #include <lauxlib.h>
@@ -17,7 +18,8 @@ static int Lua_JokerLoad(lua_State *L) {
   const char *filePath = luaL_checkstring(L, 1);
 
   try {
-    Joker joker = Joker::FromJSON(filePath);
+    JokerRegistry &registry = JokerRegistry::getInstance();
+    const Joker &joker = registry.get(registry.intern(filePath));
 
     // Return joker as Lua table
     lua_newtable(L);
@@ -45,40 +47,26 @@ static int Lua_JokerLoad(lua_State *L) {
   }
 }
 
-static int Lua_JokerApplyEffects(lua_State *L) {
-  // Args: jokerPaths (table), hand (table of 5 cards), trigger (string)
-  // Optional 4th arg: stackCounts (table) - if provided, use tier system
-  luaL_checktype(L, 1, LUA_TTABLE);
-  luaL_checktype(L, 2, LUA_TTABLE);
-  const char *trigger = luaL_checkstring(L, 3);
-  
-  bool hasStackCounts = lua_istable(L, 4);
-
-  // Load all jokers from paths
-  std::vector<std::pair<Joker, int>> jokersWithStacks;
-  int jokerCount = lua_rawlen(L, 1);
-  for (int i = 1; i <= jokerCount; ++i) {
-    lua_rawgeti(L, 1, i);
-    const char *path = lua_tostring(L, -1);
-    lua_pop(L, 1);
-
-    int stackCount = 1;
-    if (hasStackCounts) {
-      lua_rawgeti(L, 4, i);
-      stackCount = lua_tointeger(L, -1);
-      lua_pop(L, 1);
-      if (stackCount < 1) stackCount = 1;
-      if (stackCount > 5) stackCount = 5; // GDD: max 5 stacks
-    }
-
-    try {
-      Joker joker = Joker::FromJSON(path);
-      jokersWithStacks.push_back({joker, stackCount});
-    } catch (...) {
-      // Skip invalid jokers
-    }
+/// Read the stack count for slot i from the optional stacks table at index 4
+static int ReadStackCount(lua_State *L, bool hasStackCounts, int i) {
+  if (!hasStackCounts) {
+    return 1;
   }
 
+  lua_rawgeti(L, 4, i);
+  int stackCount = lua_tointeger(L, -1);
+  lua_pop(L, 1);
+  if (stackCount < 1) stackCount = 1;
+  if (stackCount > 5) stackCount = 5; // GDD: max 5 stacks
+  return stackCount;
+}
+
+/// Evaluate the hand at stack index 2 (4 cards + cut) against the given
+/// jokers and push the effect result table
+static int PushJokerEffects(
+    lua_State *L,
+    const std::vector<std::pair<const CompiledJoker *, int>> &jokersWithStacks,
+    const char *trigger) {
   // Extract cards from hand
   std::vector<Card> hand;
   for (int i = 1; i <= 4; ++i) {
@@ -99,7 +87,7 @@ static int Lua_JokerApplyEffects(lua_State *L) {
 
   // Apply joker effects with stack counts
   JokerEffectSystem::EffectResult effects =
-      JokerEffectSystem::ApplyJokersWithStacks(jokersWithStacks, handResult, trigger);
+      JokerEffectSystem::ApplyCompiled(jokersWithStacks, handResult, trigger);
 
   // Return effect result as table
   lua_newtable(L);
@@ -119,6 +107,102 @@ static int Lua_JokerApplyEffects(lua_State *L) {
   return 1;
 }
 
+static int Lua_JokerApplyEffects(lua_State *L) {
+  // Args: jokerPaths (table), hand (table of 5 cards), trigger (string)
+  // Optional 4th arg: stackCounts (table) - if provided, use tier system
+  luaL_checktype(L, 1, LUA_TTABLE);
+  luaL_checktype(L, 2, LUA_TTABLE);
+  const char *trigger = luaL_checkstring(L, 3);
+  
+  bool hasStackCounts = lua_istable(L, 4);
+
+  // Resolve paths through the registry (parsed on first use only). Every
+  // path is interned before any joker is referenced by pointer.
+  JokerRegistry &registry = JokerRegistry::getInstance();
+  std::vector<std::pair<int, int>> handlesWithStacks;
+  int jokerCount = lua_rawlen(L, 1);
+  handlesWithStacks.reserve(jokerCount);
+  for (int i = 1; i <= jokerCount; ++i) {
+    lua_rawgeti(L, 1, i);
+    const char *path = lua_tostring(L, -1);
+    lua_pop(L, 1);
+
+    int stackCount = ReadStackCount(L, hasStackCounts, i);
+
+    if (!path) {
+      continue;
+    }
+
+    try {
+      handlesWithStacks.push_back({registry.intern(path), stackCount});
+    } catch (...) {
+      // Skip invalid jokers
+    }
+  }
+
+  std::vector<std::pair<const CompiledJoker *, int>> jokersWithStacks;
+  jokersWithStacks.reserve(handlesWithStacks.size());
+  for (const auto &[handle, stackCount] : handlesWithStacks) {
+    jokersWithStacks.push_back({&registry.getCompiled(handle), stackCount});
+  }
+
+  return PushJokerEffects(L, jokersWithStacks, trigger);
+}
+
+static int Lua_JokerApplyEffectsById(lua_State *L) {
+  // Args: handles (table of ints from joker.intern), hand, trigger
+  // Optional 4th arg: stackCounts (table)
+  luaL_checktype(L, 1, LUA_TTABLE);
+  luaL_checktype(L, 2, LUA_TTABLE);
+  const char *trigger = luaL_checkstring(L, 3);
+
+  bool hasStackCounts = lua_istable(L, 4);
+
+  const JokerRegistry &registry = JokerRegistry::getInstance();
+  std::vector<std::pair<const CompiledJoker *, int>> jokersWithStacks;
+  int jokerCount = lua_rawlen(L, 1);
+  jokersWithStacks.reserve(jokerCount);
+  for (int i = 1; i <= jokerCount; ++i) {
+    lua_rawgeti(L, 1, i);
+    int isNum = 0;
+    int handle = static_cast<int>(lua_tointegerx(L, -1, &isNum));
+    lua_pop(L, 1);
+
+    int stackCount = ReadStackCount(L, hasStackCounts, i);
+
+    // Skip unknown handles, mirroring applyEffects' handling of bad paths
+    if (isNum && registry.isValid(handle)) {
+      jokersWithStacks.push_back({&registry.getCompiled(handle), stackCount});
+    }
+  }
+
+  return PushJokerEffects(L, jokersWithStacks, trigger);
+}
+
+static int Lua_JokerIntern(lua_State *L) {
+  const char *filePath = luaL_checkstring(L, 1);
+
+  try {
+    lua_pushinteger(L, JokerRegistry::getInstance().intern(filePath));
+    return 1;
+  } catch (const std::exception &e) {
+    lua_pushnil(L);
+    lua_pushstring(L, e.what());
+    return 2;
+  }
+}
+
+static int Lua_JokerLoadDirectory(lua_State *L) {
+  const char *directory = luaL_checkstring(L, 1);
+  lua_pushinteger(L, JokerRegistry::getInstance().loadDirectory(directory));
+  return 1;
+}
+
+static int Lua_JokerReload(lua_State *L) {
+  lua_pushinteger(L, JokerRegistry::getInstance().reload());
+  return 1;
+}
+
 void RegisterJokerBindings(lua_State *L) {
   // Register joker global table
   lua_newtable(L);
@@ -129,5 +213,17 @@ void RegisterJokerBindings(lua_State *L) {
   lua_pushcfunction(L, Lua_JokerApplyEffects);
   lua_setfield(L, -2, "applyEffects");
 
+  lua_pushcfunction(L, Lua_JokerApplyEffectsById);
+  lua_setfield(L, -2, "applyEffectsById");
+
+  lua_pushcfunction(L, Lua_JokerIntern);
+  lua_setfield(L, -2, "intern");
+
+  lua_pushcfunction(L, Lua_JokerLoadDirectory);
+  lua_setfield(L, -2, "loadDirectory");
+
+  lua_pushcfunction(L, Lua_JokerReload);
+  lua_setfield(L, -2, "reload");
+
   lua_setglobal(L, "joker");
 }
@@ -1,9 +1,12 @@
 #include "core/Engine.h"
 #include "core/Logger.h"
+#include "events/EventSystem.h"
 #include "pathfinding/Pathfinder.h"
 #include "scripting/LuaBindings.h"
 #include "tilemap/TileMap.h"
+#include <climits>
 #include <memory>
+#include <new>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +18,15 @@ static int s_CurrentPathfinderId = -1; // Active pathfinder for current scene
 // Storage for Lua function references that need cleanup
 static std::vector<int> s_PendingFuncRefs;
 
+// Lua ticket -> (pathfinder id, pathfinder ticket); Lua tickets stay small
+// enough for EventData ints
+struct AsyncTicket {
+  int pathfinderId;
+  Pathfinder::Ticket ticket;
+};
+static std::unordered_map<int, AsyncTicket> s_AsyncTickets;
+static int s_NextAsyncTicket = 1;
+
 // ============================================================================
 // Helper: Get Current Pathfinder
 // ============================================================================
@@ -34,6 +46,27 @@ static Pathfinder *getCurrentPathfinder(lua_State *L) {
   return it->second.get();
 }
 
+// ============================================================================
+// Helper: Keep baked cost grids in sync with tile edits
+// ============================================================================
+
+// Pathfinder id -> the tilemap listener feeding it tile edits
+struct TileWatch {
+  TileMap *tilemap;
+  int listener;
+};
+static std::unordered_map<int, TileWatch> s_TileWatches;
+
+// Listeners leave the map's own callback and other watchers in place
+static void WatchTileChanges(int id, TileMap &tilemap) {
+  Pathfinder *pathfinder = s_Pathfinders.at(id).get();
+  int listener = tilemap.addTileChangedListener(
+      [pathfinder](int x, int y, const std::string &, int, int) {
+        pathfinder->onTileChanged(x, y);
+      });
+  s_TileWatches[id] = {&tilemap, listener};
+}
+
 // ============================================================================
 // Pathfinding.create(tilemap) - Create pathfinder for a tilemap
 // ============================================================================
@@ -56,6 +89,7 @@ static int Lua_PathfindingCreateForTileMap(lua_State *L) {
   int id = s_NextPathfinderId++;
   s_Pathfinders[id] = std::make_unique<Pathfinder>(*tilemap);
   s_CurrentPathfinderId = id;
+  WatchTileChanges(id, *tilemap);
 
   lua_pushinteger(L, id);
   return 1;
@@ -79,21 +113,47 @@ static int Lua_PathfindingSetActive(lua_State *L) {
 }
 
 // ============================================================================
-// Pathfinding.find(request) - Find a path
+// Pathfinding.destroy(id) - Destroy a pathfinder and stop watching its map
 // ============================================================================
 
-static int Lua_PathfindingFind(lua_State *L) {
-  Pathfinder *pathfinder = getCurrentPathfinder(L);
-  if (!pathfinder)
+static int Lua_PathfindingDestroy(lua_State *L) {
+  int id = static_cast<int>(luaL_checkinteger(L, 1));
+
+  auto it = s_Pathfinders.find(id);
+  if (it == s_Pathfinders.end()) {
     return 0;
+  }
 
-  // Parse request table
-  luaL_checktype(L, 1, LUA_TTABLE);
+  auto watch = s_TileWatches.find(id);
+  if (watch != s_TileWatches.end()) {
+    watch->second.tilemap->removeTileChangedListener(watch->second.listener);
+    s_TileWatches.erase(watch);
+  }
 
-  Pathfinder::PathRequest request;
+  // Its async requests die with it
+  std::erase_if(s_AsyncTickets, [id](const auto &entry) {
+    return entry.second.pathfinderId == id;
+  });
+
+  s_Pathfinders.erase(it);
+  if (s_CurrentPathfinderId == id) {
+    s_CurrentPathfinderId = -1;
+  }
+  return 0;
+}
+
+// ============================================================================
+// Helper: Request tables and result tables
+// ============================================================================
+
+// Read start/target/diagonal/layer/maxSteps/maxTime/smooth/algorithm from
+// the request table at index (costFunction is handled by the caller)
+static void ParseRequest(lua_State *L, int index, const char *fn,
+                         Pathfinder::PathRequest &request) {
+  luaL_checktype(L, index, LUA_TTABLE);
 
   // Get start point
-  lua_getfield(L, 1, "start");
+  lua_getfield(L, index, "start");
   if (lua_istable(L, -1)) {
     lua_getfield(L, -1, "x");
     request.start.x = static_cast<int>(luaL_checkinteger(L, -1));
@@ -103,12 +163,12 @@ static int Lua_PathfindingFind(lua_State *L) {
     request.start.y = static_cast<int>(luaL_checkinteger(L, -1));
     lua_pop(L, 1);
   } else {
-    luaL_error(L, "Pathfinding.find: 'start' must be a table with x and y");
+    luaL_error(L, "%s: 'start' must be a table with x and y", fn);
   }
   lua_pop(L, 1);
 
   // Get target point
-  lua_getfield(L, 1, "target");
+  lua_getfield(L, index, "target");
   if (lua_istable(L, -1)) {
     lua_getfield(L, -1, "x");
     request.end.x = static_cast<int>(luaL_checkinteger(L, -1));
@@ -118,45 +178,127 @@ static int Lua_PathfindingFind(lua_State *L) {
     request.end.y = static_cast<int>(luaL_checkinteger(L, -1));
     lua_pop(L, 1);
   } else {
-    luaL_error(L, "Pathfinding.find: 'target' must be a table with x and y");
+    luaL_error(L, "%s: 'target' must be a table with x and y", fn);
   }
   lua_pop(L, 1);
 
   // Optional: diagonal
-  lua_getfield(L, 1, "diagonal");
+  lua_getfield(L, index, "diagonal");
   if (!lua_isnil(L, -1)) {
     request.allowDiagonal = lua_toboolean(L, -1);
   }
   lua_pop(L, 1);
 
   // Optional: layer
-  lua_getfield(L, 1, "layer");
+  lua_getfield(L, index, "layer");
   if (lua_isstring(L, -1)) {
     request.navigationLayer = lua_tostring(L, -1);
   }
   lua_pop(L, 1);
 
   // Optional: maxSteps
-  lua_getfield(L, 1, "maxSteps");
+  lua_getfield(L, index, "maxSteps");
   if (lua_isnumber(L, -1)) {
     request.maxSteps = static_cast<int>(lua_tointeger(L, -1));
   }
   lua_pop(L, 1);
 
   // Optional: maxTime
-  lua_getfield(L, 1, "maxTime");
+  lua_getfield(L, index, "maxTime");
   if (lua_isnumber(L, -1)) {
     request.maxTimeMs = static_cast<float>(lua_tonumber(L, -1));
   }
   lua_pop(L, 1);
 
   // Optional: smooth
-  lua_getfield(L, 1, "smooth");
+  lua_getfield(L, index, "smooth");
   if (!lua_isnil(L, -1)) {
     request.smoothPath = lua_toboolean(L, -1);
   }
   lua_pop(L, 1);
 
+  // Optional: algorithm ("astar", "jps" or "hpa")
+  lua_getfield(L, index, "algorithm");
+  if (lua_isstring(L, -1)) {
+    std::string algorithm = lua_tostring(L, -1);
+    if (algorithm == "jps") {
+      request.algorithm = Pathfinder::Algorithm::JPS;
+    } else if (algorithm == "hpa") {
+      request.algorithm = Pathfinder::Algorithm::HPA;
+    } else if (algorithm != "astar") {
+      LOG_WARN("%s: unknown algorithm '%s', using astar", fn,
+               algorithm.c_str());
+    }
+  }
+  lua_pop(L, 1);
+}
+
+// Push { path, found, partial, nodesExpanded, timeMs, algorithm, cached }
+static void PushResult(lua_State *L, const Pathfinder::PathResult &result) {
+  lua_newtable(L);
+
+  // path array
+  lua_createtable(L, static_cast<int>(result.path.size()), 0);
+  for (size_t i = 0; i < result.path.size(); i++) {
+    lua_newtable(L);
+
+    lua_pushinteger(L, result.path[i].x);
+    lua_setfield(L, -2, "x");
+
+    lua_pushinteger(L, result.path[i].y);
+    lua_setfield(L, -2, "y");
+
+    lua_rawseti(L, -2, static_cast<int>(i + 1));
+  }
+  lua_setfield(L, -2, "path");
+
+  // found
+  lua_pushboolean(L, result.found);
+  lua_setfield(L, -2, "found");
+
+  // partial
+  lua_pushboolean(L, result.partial);
+  lua_setfield(L, -2, "partial");
+
+  // nodesExpanded
+  lua_pushinteger(L, result.nodesExpanded);
+  lua_setfield(L, -2, "nodesExpanded");
+
+  // timeMs
+  lua_pushnumber(L, result.timeMs);
+  lua_setfield(L, -2, "timeMs");
+
+  // algorithm (JPS/HPA requests may have fallen back to A*)
+  switch (result.algorithm) {
+  case Pathfinder::Algorithm::JPS:
+    lua_pushstring(L, "jps");
+    break;
+  case Pathfinder::Algorithm::HPA:
+    lua_pushstring(L, "hpa");
+    break;
+  default:
+    lua_pushstring(L, "astar");
+    break;
+  }
+  lua_setfield(L, -2, "algorithm");
+
+  // cached (served from the path cache)
+  lua_pushboolean(L, result.cached);
+  lua_setfield(L, -2, "cached");
+}
+
+// ============================================================================
+// Pathfinding.find(request) - Find a path
+// ============================================================================
+
+static int Lua_PathfindingFind(lua_State *L) {
+  Pathfinder *pathfinder = getCurrentPathfinder(L);
+  if (!pathfinder)
+    return 0;
+
+  Pathfinder::PathRequest request;
+  ParseRequest(L, 1, "Pathfinding.find", request);
+
   // Optional: costFunction (Lua callback)
   int costFuncRef = LUA_NOREF;
   lua_getfield(L, 1, "costFunction");
@@ -190,43 +332,229 @@ static int Lua_PathfindingFind(lua_State *L) {
     luaL_unref(L, LUA_REGISTRYINDEX, costFuncRef);
   }
 
-  // Build result table
-  lua_newtable(L);
+  PushResult(L, result);
+  return 1;
+}
 
-  // path array
-  lua_createtable(L, static_cast<int>(result.path.size()), 0);
-  for (size_t i = 0; i < result.path.size(); i++) {
-    lua_newtable(L);
+// ============================================================================
+// Pathfinding.requestAsync(request) - Queue a path search, returns a ticket
+// ============================================================================
 
-    lua_pushinteger(L, result.path[i].x);
-    lua_setfield(L, -2, "x");
+static int Lua_PathfindingRequestAsync(lua_State *L) {
+  Pathfinder *pathfinder = getCurrentPathfinder(L);
+  if (!pathfinder)
+    return 0;
 
-    lua_pushinteger(L, result.path[i].y);
-    lua_setfield(L, -2, "y");
+  Pathfinder::PathRequest request;
+  ParseRequest(L, 1, "Pathfinding.requestAsync", request);
 
-    lua_rawseti(L, -2, static_cast<int>(i + 1));
+  // Lua can't be called from worker threads
+  lua_getfield(L, 1, "costFunction");
+  if (!lua_isnil(L, -1)) {
+    LOG_WARN("Pathfinding.requestAsync: costFunction is ignored (use "
+             "Pathfinding.find)");
   }
-  lua_setfield(L, -2, "path");
+  lua_pop(L, 1);
 
-  // found
-  lua_pushboolean(L, result.found);
-  lua_setfield(L, -2, "found");
+  int luaTicket = s_NextAsyncTicket;
+  s_NextAsyncTicket = s_NextAsyncTicket == INT_MAX ? 1 : s_NextAsyncTicket + 1;
+  s_AsyncTickets[luaTicket] = {s_CurrentPathfinderId,
+                               pathfinder->requestAsync(request)};
 
-  // partial
-  lua_pushboolean(L, result.partial);
-  lua_setfield(L, -2, "partial");
+  lua_pushinteger(L, luaTicket);
+  return 1;
+}
 
-  // nodesExpanded
-  lua_pushinteger(L, result.nodesExpanded);
-  lua_setfield(L, -2, "nodesExpanded");
+// ============================================================================
+// Pathfinding.poll(ticket) - Result table once finished, nil while pending
+// ============================================================================
 
-  // timeMs
-  lua_pushnumber(L, result.timeMs);
-  lua_setfield(L, -2, "timeMs");
+static int Lua_PathfindingPoll(lua_State *L) {
+  int luaTicket = static_cast<int>(luaL_checkinteger(L, 1));
+
+  auto it = s_AsyncTickets.find(luaTicket);
+  if (it == s_AsyncTickets.end()) {
+    return luaL_error(L, "Pathfinding.poll: unknown ticket %d", luaTicket);
+  }
+
+  auto pathfinder = s_Pathfinders.find(it->second.pathfinderId);
+  Pathfinder::PathResult result;
+  if (pathfinder == s_Pathfinders.end() ||
+      !pathfinder->second->pollAsync(it->second.ticket, result)) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  s_AsyncTickets.erase(it);
+  PushResult(L, result);
+  return 1;
+}
+
+// ============================================================================
+// Pathfinding.cancel(ticket) - Drop a pending request
+// ============================================================================
+
+static int Lua_PathfindingCancel(lua_State *L) {
+  int luaTicket = static_cast<int>(luaL_checkinteger(L, 1));
+
+  auto it = s_AsyncTickets.find(luaTicket);
+  if (it == s_AsyncTickets.end()) {
+    return 0;
+  }
+
+  auto pathfinder = s_Pathfinders.find(it->second.pathfinderId);
+  if (pathfinder != s_Pathfinders.end()) {
+    pathfinder->second->cancelAsync(it->second.ticket);
+  }
+  s_AsyncTickets.erase(it);
+  return 0;
+}
+
+// ============================================================================
+// Pathfinding.flowField(request) - Shared direction field toward a target
+// ============================================================================
+
+// FlowField userdata keeps its field alive after the cache drops it
+static const char *FLOWFIELD_MT = "MagicHands.FlowField";
+
+struct FlowFieldUD {
+  std::shared_ptr<const Pathfinder::FlowField> field;
+};
+
+static const Pathfinder::FlowField &checkFlowField(lua_State *L, int idx) {
+  auto *ud = static_cast<FlowFieldUD *>(luaL_checkudata(L, idx, FLOWFIELD_MT));
+  return *ud->field;
+}
+
+static int Lua_PathfindingFlowField(lua_State *L) {
+  Pathfinder *pathfinder = getCurrentPathfinder(L);
+  if (!pathfinder)
+    return 0;
+
+  luaL_checktype(L, 1, LUA_TTABLE);
+
+  Pathfinder::Point goal{0, 0};
+  lua_getfield(L, 1, "target");
+  if (lua_istable(L, -1)) {
+    lua_getfield(L, -1, "x");
+    goal.x = static_cast<int>(luaL_checkinteger(L, -1));
+    lua_pop(L, 1);
+
+    lua_getfield(L, -1, "y");
+    goal.y = static_cast<int>(luaL_checkinteger(L, -1));
+    lua_pop(L, 1);
+  } else {
+    luaL_error(L, "Pathfinding.flowField: 'target' must be a table with x "
+                  "and y");
+  }
+  lua_pop(L, 1);
+
+  std::string layer = "nav_ground";
+  lua_getfield(L, 1, "layer");
+  if (lua_isstring(L, -1)) {
+    layer = lua_tostring(L, -1);
+  }
+  lua_pop(L, 1);
+
+  bool diagonal = true;
+  lua_getfield(L, 1, "diagonal");
+  if (!lua_isnil(L, -1)) {
+    diagonal = lua_toboolean(L, -1);
+  }
+  lua_pop(L, 1);
+
+  void *memory = lua_newuserdata(L, sizeof(FlowFieldUD));
+  new (memory) FlowFieldUD{pathfinder->getFlowField(goal, layer, diagonal)};
+
+  luaL_getmetatable(L, FLOWFIELD_MT);
+  lua_setmetatable(L, -2);
+  return 1;
+}
+
+// field:direction(x, y) -> dx, dy (0, 0 at the target or if unreachable)
+static int Lua_FlowFieldDirection(lua_State *L) {
+  const Pathfinder::FlowField &field = checkFlowField(L, 1);
+  int x = static_cast<int>(luaL_checkinteger(L, 2));
+  int y = static_cast<int>(luaL_checkinteger(L, 3));
+
+  Pathfinder::Point step = field.direction(x, y);
+  lua_pushinteger(L, step.x);
+  lua_pushinteger(L, step.y);
+  return 2;
+}
+
+// field:distance(x, y) -> cost to the target, or nil if unreachable
+static int Lua_FlowFieldDistance(lua_State *L) {
+  const Pathfinder::FlowField &field = checkFlowField(L, 1);
+  int x = static_cast<int>(luaL_checkinteger(L, 2));
+  int y = static_cast<int>(luaL_checkinteger(L, 3));
+
+  float distance = field.distance(x, y);
+  if (distance < 0.0f) {
+    lua_pushnil(L);
+  } else {
+    lua_pushnumber(L, distance);
+  }
+  return 1;
+}
+
+// field:isStale() -> true once tiles changed under it
+static int Lua_FlowFieldIsStale(lua_State *L) {
+  lua_pushboolean(L, checkFlowField(L, 1).isStale());
+  return 1;
+}
+
+static int Lua_FlowFieldGC(lua_State *L) {
+  auto *ud = static_cast<FlowFieldUD *>(luaL_checkudata(L, 1, FLOWFIELD_MT));
+  ud->~FlowFieldUD();
+  return 0;
+}
+
+// ============================================================================
+// Pathfinding.getCacheStats() - Path cache counters
+// ============================================================================
+
+static int Lua_PathfindingGetCacheStats(lua_State *L) {
+  Pathfinder *pathfinder = getCurrentPathfinder(L);
+  if (!pathfinder)
+    return 0;
+
+  Pathfinder::PathCacheStats stats = pathfinder->getPathCacheStats();
+  lua_newtable(L);
+
+  lua_pushinteger(L, static_cast<lua_Integer>(stats.hits));
+  lua_setfield(L, -2, "hits");
+
+  lua_pushinteger(L, static_cast<lua_Integer>(stats.misses));
+  lua_setfield(L, -2, "misses");
+
+  lua_pushinteger(L, static_cast<lua_Integer>(stats.invalidated));
+  lua_setfield(L, -2, "invalidated");
+
+  lua_pushinteger(L, static_cast<lua_Integer>(stats.size));
+  lua_setfield(L, -2, "size");
+
+  lua_pushinteger(L, static_cast<lua_Integer>(stats.capacity));
+  lua_setfield(L, -2, "capacity");
 
   return 1;
 }
 
+// ============================================================================
+// Pathfinding.setCacheCapacity(n) - Maximum cached paths (0 disables)
+// ============================================================================
+
+static int Lua_PathfindingSetCacheCapacity(lua_State *L) {
+  Pathfinder *pathfinder = getCurrentPathfinder(L);
+  if (!pathfinder)
+    return 0;
+
+  lua_Integer capacity = luaL_checkinteger(L, 1);
+  pathfinder->setPathCacheCapacity(
+      capacity > 0 ? static_cast<size_t>(capacity) : 0);
+  return 0;
+}
+
 // ============================================================================
 // Pathfinding.isWalkable(x, y, layer) - Check if tile is walkable
 // ============================================================================
@@ -264,7 +592,7 @@ static int Lua_PathfindingGetCost(lua_State *L) {
 }
 
 // ============================================================================
-// Pathfinding.invalidateRegion(x, y, width, height) - Invalidate cache
+// Pathfinding.invalidateRegion(x, y, width, height) - Re-read tile costs
 // ============================================================================
 
 static int Lua_PathfindingInvalidateRegion(lua_State *L) {
@@ -292,18 +620,70 @@ void SetActivePathfinder(Pathfinder *pathfinder) {
 }
 
 // Create pathfinder for a tilemap (called internally)
-int CreatePathfinderForTileMap(const TileMap &tilemap) {
+int CreatePathfinderForTileMap(TileMap &tilemap) {
   int id = s_NextPathfinderId++;
   s_Pathfinders[id] = std::make_unique<Pathfinder>(tilemap);
   s_CurrentPathfinderId = id;
+  WatchTileChanges(id, tilemap);
   return id;
 }
 
+// Emit "pathfinding_complete" { ticket, found, partial } for each async
+// request that finished since the last frame (called once per frame from
+// the main loop). Handlers fetch the path with Pathfinding.poll(ticket).
+void DispatchPathfindingResults() {
+  if (s_AsyncTickets.empty()) {
+    return;
+  }
+
+  std::unordered_map<Pathfinder::Ticket, int> luaTickets;
+  for (const auto &[luaTicket, async] : s_AsyncTickets) {
+    luaTickets[async.ticket] = luaTicket;
+  }
+
+  std::vector<EventData> events;
+  for (auto &[id, pathfinder] : s_Pathfinders) {
+    for (Pathfinder::Ticket ticket : pathfinder->takeFinished()) {
+      auto it = luaTickets.find(ticket);
+      if (it != luaTickets.end()) {
+        events.push_back(EventData("pathfinding_complete")
+                             .SetInt("ticket", it->second)
+                             .SetInt("pathfinder", id));
+      }
+    }
+  }
+
+  // Emit after collecting: handlers may create pathfinders or poll
+  for (const EventData &event : events) {
+    EventSystem::Instance().Emit(event);
+  }
+}
+
 // ============================================================================
 // Registration
 // ============================================================================
 
 void RegisterPathfindingBindings(lua_State *L) {
+  // FlowField metatable
+  luaL_newmetatable(L, FLOWFIELD_MT);
+
+  lua_pushvalue(L, -1);
+  lua_setfield(L, -2, "__index");
+
+  lua_pushcfunction(L, Lua_FlowFieldGC);
+  lua_setfield(L, -2, "__gc");
+
+  lua_pushcfunction(L, Lua_FlowFieldDirection);
+  lua_setfield(L, -2, "direction");
+
+  lua_pushcfunction(L, Lua_FlowFieldDistance);
+  lua_setfield(L, -2, "distance");
+
+  lua_pushcfunction(L, Lua_FlowFieldIsStale);
+  lua_setfield(L, -2, "isStale");
+
+  lua_pop(L, 1);
+
   lua_newtable(L);
 
   lua_pushcfunction(L, Lua_PathfindingCreateForTileMap);
@@ -312,9 +692,24 @@ void RegisterPathfindingBindings(lua_State *L) {
   lua_pushcfunction(L, Lua_PathfindingSetActive);
   lua_setfield(L, -2, "setActive");
 
+  lua_pushcfunction(L, Lua_PathfindingDestroy);
+  lua_setfield(L, -2, "destroy");
+
   lua_pushcfunction(L, Lua_PathfindingFind);
   lua_setfield(L, -2, "find");
 
+  lua_pushcfunction(L, Lua_PathfindingRequestAsync);
+  lua_setfield(L, -2, "requestAsync");
+
+  lua_pushcfunction(L, Lua_PathfindingPoll);
+  lua_setfield(L, -2, "poll");
+
+  lua_pushcfunction(L, Lua_PathfindingCancel);
+  lua_setfield(L, -2, "cancel");
+
+  lua_pushcfunction(L, Lua_PathfindingFlowField);
+  lua_setfield(L, -2, "flowField");
+
   lua_pushcfunction(L, Lua_PathfindingIsWalkable);
   lua_setfield(L, -2, "isWalkable");
 
@@ -324,6 +719,12 @@ void RegisterPathfindingBindings(lua_State *L) {
   lua_pushcfunction(L, Lua_PathfindingInvalidateRegion);
   lua_setfield(L, -2, "invalidateRegion");
 
+  lua_pushcfunction(L, Lua_PathfindingGetCacheStats);
+  lua_setfield(L, -2, "getCacheStats");
+
+  lua_pushcfunction(L, Lua_PathfindingSetCacheCapacity);
+  lua_setfield(L, -2, "setCacheCapacity");
+
   lua_setglobal(L, "Pathfinding");
 
   LOG_INFO("Pathfinding bindings registered");
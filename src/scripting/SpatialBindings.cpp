@@ -2,21 +2,27 @@
 #include "core/Logger.h"
 #include "core/SpatialIndex.h"
 #include "scripting/LuaBindings.h"
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <unordered_map>
+#include <variant>
 
 // =============================================================================
-// Storage for Quadtrees
+// Storage for Spatial Indexes
 // =============================================================================
 
-static std::unordered_map<int, std::unique_ptr<Quadtree>> s_SpatialTrees;
+// Backends share an API, so every binding below goes through std::visit
+using SpatialIndex = std::variant<PooledQuadtree, SpatialHashGrid>;
+
+static std::unordered_map<int, std::unique_ptr<SpatialIndex>> s_SpatialTrees;
 static int s_NextSpatialHandle = 1;
 
 // =============================================================================
-// Helper: Get Quadtree by Handle
+// Helper: Get Spatial Index by Handle
 // =============================================================================
 
-static Quadtree *getSpatialTree(lua_State *L, int handle) {
+static SpatialIndex *getSpatialTree(lua_State *L, int handle) {
   auto it = s_SpatialTrees.find(handle);
   if (it == s_SpatialTrees.end()) {
     luaL_error(L, "Invalid spatial tree handle: %d", handle);
@@ -27,6 +33,8 @@ static Quadtree *getSpatialTree(lua_State *L, int handle) {
 
 // =============================================================================
 // spatial.create(x, y, w, h, maxObjects, maxLevels) -> handle
+// spatial.create(x, y, w, h, {backend, cellSize, maxObjects, maxLevels})
+//   backend: "quadtree" (default) or "grid" (uniform SpatialHashGrid)
 // =============================================================================
 
 static int Lua_SpatialCreate(lua_State *L) {
@@ -34,12 +42,44 @@ static int Lua_SpatialCreate(lua_State *L) {
   float y = static_cast<float>(luaL_checknumber(L, 2));
   float w = static_cast<float>(luaL_checknumber(L, 3));
   float h = static_cast<float>(luaL_checknumber(L, 4));
-  int maxObjects = static_cast<int>(luaL_optinteger(L, 5, 10));
-  int maxLevels = static_cast<int>(luaL_optinteger(L, 6, 5));
+  Rect bounds(x, y, w, h);
+
+  int maxObjects = 10;
+  int maxLevels = 5;
+  const char *backend = "quadtree";
+  float cellSize = 64.0f;
+  if (lua_istable(L, 5)) {
+    lua_getfield(L, 5, "backend");
+    backend = luaL_optstring(L, -1, backend);
+    lua_getfield(L, 5, "cellSize");
+    cellSize = static_cast<float>(luaL_optnumber(L, -1, cellSize));
+    lua_getfield(L, 5, "maxObjects");
+    maxObjects = static_cast<int>(luaL_optinteger(L, -1, maxObjects));
+    lua_getfield(L, 5, "maxLevels");
+    maxLevels = static_cast<int>(luaL_optinteger(L, -1, maxLevels));
+    lua_pop(L, 4);
+  } else {
+    maxObjects = static_cast<int>(luaL_optinteger(L, 5, maxObjects));
+    maxLevels = static_cast<int>(luaL_optinteger(L, 6, maxLevels));
+  }
+
+  std::unique_ptr<SpatialIndex> index;
+  if (strcmp(backend, "quadtree") == 0) {
+    index = std::make_unique<SpatialIndex>(std::in_place_type<PooledQuadtree>,
+                                           bounds, maxObjects, maxLevels);
+  } else if (strcmp(backend, "grid") == 0) {
+    try {
+      index = std::make_unique<SpatialIndex>(
+          std::in_place_type<SpatialHashGrid>, bounds, cellSize);
+    } catch (const std::invalid_argument &e) {
+      return luaL_error(L, "spatial.create: %s", e.what());
+    }
+  } else {
+    return luaL_error(L, "spatial.create: unknown backend '%s'", backend);
+  }
 
   int handle = s_NextSpatialHandle++;
-  s_SpatialTrees[handle] =
-      std::make_unique<Quadtree>(Rect(x, y, w, h), maxObjects, maxLevels);
+  s_SpatialTrees[handle] = std::move(index);
 
   lua_pushinteger(L, handle);
   return 1;
@@ -57,9 +97,10 @@ static int Lua_SpatialInsert(lua_State *L) {
   float w = static_cast<float>(luaL_checknumber(L, 5));
   float h = static_cast<float>(luaL_checknumber(L, 6));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (tree) {
-    tree->insert(id, Rect(x, y, w, h));
+    std::visit([&](auto &index) { index.insert(id, Rect(x, y, w, h)); },
+               *tree);
   }
 
   return 0;
@@ -75,9 +116,9 @@ static int Lua_SpatialInsertPoint(lua_State *L) {
   float x = static_cast<float>(luaL_checknumber(L, 3));
   float y = static_cast<float>(luaL_checknumber(L, 4));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (tree) {
-    tree->insertPoint(id, x, y);
+    std::visit([&](auto &index) { index.insertPoint(id, x, y); }, *tree);
   }
 
   return 0;
@@ -91,9 +132,9 @@ static int Lua_SpatialRemove(lua_State *L) {
   int handle = static_cast<int>(luaL_checkinteger(L, 1));
   int id = static_cast<int>(luaL_checkinteger(L, 2));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (tree) {
-    tree->remove(id);
+    std::visit([&](auto &index) { index.remove(id); }, *tree);
   }
 
   return 0;
@@ -111,9 +152,10 @@ static int Lua_SpatialUpdate(lua_State *L) {
   float w = static_cast<float>(luaL_checknumber(L, 5));
   float h = static_cast<float>(luaL_checknumber(L, 6));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (tree) {
-    tree->update(id, Rect(x, y, w, h));
+    std::visit([&](auto &index) { index.update(id, Rect(x, y, w, h)); },
+               *tree);
   }
 
   return 0;
@@ -130,14 +172,15 @@ static int Lua_SpatialQuery(lua_State *L) {
   float w = static_cast<float>(luaL_checknumber(L, 4));
   float h = static_cast<float>(luaL_checknumber(L, 5));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (!tree) {
     lua_newtable(L);
     return 1;
   }
 
   std::vector<int> results;
-  tree->query(Rect(x, y, w, h), results);
+  std::visit([&](auto &index) { index.query(Rect(x, y, w, h), results); },
+             *tree);
 
   // Create Lua table
   lua_createtable(L, static_cast<int>(results.size()), 0);
@@ -159,14 +202,15 @@ static int Lua_SpatialQueryRadius(lua_State *L) {
   float y = static_cast<float>(luaL_checknumber(L, 3));
   float radius = static_cast<float>(luaL_checknumber(L, 4));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (!tree) {
     lua_newtable(L);
     return 1;
   }
 
   std::vector<int> results;
-  tree->queryRadius(x, y, radius, results);
+  std::visit(
+      [&](auto &index) { index.queryRadius(x, y, radius, results); }, *tree);
 
   // Create Lua table
   lua_createtable(L, static_cast<int>(results.size()), 0);
@@ -188,17 +232,71 @@ static int Lua_SpatialQueryNearest(lua_State *L) {
   float y = static_cast<float>(luaL_checknumber(L, 3));
   float maxRadius = static_cast<float>(luaL_optnumber(L, 4, 1000.0f));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (!tree) {
     lua_pushinteger(L, -1);
     return 1;
   }
 
-  int nearestId = tree->queryNearest(x, y, maxRadius);
+  int nearestId = std::visit(
+      [&](auto &index) { return index.queryNearest(x, y, maxRadius); },
+      *tree);
   lua_pushinteger(L, nearestId);
   return 1;
 }
 
+// =============================================================================
+// spatial.rebuild(handle, xs, ys [, ids]) - Replace contents with points
+// =============================================================================
+
+static int Lua_SpatialRebuild(lua_State *L) {
+  int handle = static_cast<int>(luaL_checkinteger(L, 1));
+  luaL_checktype(L, 2, LUA_TTABLE);
+  luaL_checktype(L, 3, LUA_TTABLE);
+  bool hasIds = lua_istable(L, 4);
+
+  SpatialIndex *tree = getSpatialTree(L, handle);
+  if (!tree) {
+    return 0;
+  }
+
+  // Gather the Lua arrays into SoA form (ids default to 1..n)
+  static std::vector<float> xs, ys;
+  static std::vector<int> ids;
+  int count = static_cast<int>(lua_rawlen(L, 2));
+  xs.resize(count);
+  ys.resize(count);
+  ids.resize(count);
+  for (int i = 1; i <= count; ++i) {
+    lua_rawgeti(L, 2, i);
+    lua_rawgeti(L, 3, i);
+    xs[i - 1] = static_cast<float>(luaL_checknumber(L, -2));
+    ys[i - 1] = static_cast<float>(luaL_checknumber(L, -1));
+    lua_pop(L, 2);
+    if (hasIds) {
+      lua_rawgeti(L, 4, i);
+      ids[i - 1] = static_cast<int>(luaL_checkinteger(L, -1));
+      lua_pop(L, 1);
+    } else {
+      ids[i - 1] = i;
+    }
+  }
+
+  // Either way a repeated id ends up once, at its last position
+  if (auto *grid = std::get_if<SpatialHashGrid>(tree)) {
+    grid->rebuild(xs.size(), xs.data(), ys.data(), nullptr, nullptr,
+                  ids.data());
+  } else {
+    PooledQuadtree &quadtree = std::get<PooledQuadtree>(*tree);
+    quadtree.clear();
+    for (int i = 0; i < count; ++i) {
+      quadtree.insertPoint(ids[i], xs[i], ys[i]);
+    }
+  }
+
+  return 0;
+}
+
 // =============================================================================
 // spatial.clear(handle)
 // =============================================================================
@@ -206,9 +304,9 @@ static int Lua_SpatialQueryNearest(lua_State *L) {
 static int Lua_SpatialClear(lua_State *L) {
   int handle = static_cast<int>(luaL_checkinteger(L, 1));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (tree) {
-    tree->clear();
+    std::visit([&](auto &index) { index.clear(); }, *tree);
   }
 
   return 0;
@@ -236,13 +334,14 @@ static int Lua_SpatialDestroy(lua_State *L) {
 static int Lua_SpatialSize(lua_State *L) {
   int handle = static_cast<int>(luaL_checkinteger(L, 1));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (!tree) {
     lua_pushinteger(L, 0);
     return 1;
   }
 
-  lua_pushinteger(L, tree->size());
+  lua_pushinteger(L,
+                  std::visit([](auto &index) { return index.size(); }, *tree));
   return 1;
 }
 
@@ -250,18 +349,7 @@ static int Lua_SpatialSize(lua_State *L) {
 // spatial.stats(handle) -> table
 // =============================================================================
 
-static int Lua_SpatialStats(lua_State *L) {
-  int handle = static_cast<int>(luaL_checkinteger(L, 1));
-
-  Quadtree *tree = getSpatialTree(L, handle);
-  if (!tree) {
-    lua_newtable(L);
-    return 1;
-  }
-
-  Quadtree::Stats stats = tree->getStats();
-
-  // Create stats table
+static void PushStats(lua_State *L, const PooledQuadtree::Stats &stats) {
   lua_createtable(L, 0, 4);
 
   lua_pushinteger(L, stats.nodeCount);
@@ -280,7 +368,34 @@ static int Lua_SpatialStats(lua_State *L) {
     lua_rawseti(L, -2, i + 1);
   }
   lua_setfield(L, -2, "objectsPerLevel");
+}
+
+static void PushStats(lua_State *L, const SpatialHashGrid::Stats &stats) {
+  lua_createtable(L, 0, 4);
+
+  lua_pushinteger(L, stats.cellCount);
+  lua_setfield(L, -2, "cellCount");
+
+  lua_pushinteger(L, stats.occupiedCells);
+  lua_setfield(L, -2, "occupiedCells");
+
+  lua_pushinteger(L, stats.maxPerCell);
+  lua_setfield(L, -2, "maxPerCell");
+
+  lua_pushinteger(L, stats.totalObjects);
+  lua_setfield(L, -2, "totalObjects");
+}
+
+static int Lua_SpatialStats(lua_State *L) {
+  int handle = static_cast<int>(luaL_checkinteger(L, 1));
 
+  SpatialIndex *tree = getSpatialTree(L, handle);
+  if (!tree) {
+    lua_newtable(L);
+    return 1;
+  }
+
+  std::visit([&](auto &index) { PushStats(L, index.getStats()); }, *tree);
   return 1;
 }
 
@@ -291,7 +406,7 @@ static int Lua_SpatialStats(lua_State *L) {
 static int Lua_SpatialDrawDebug(lua_State *L) {
   int handle = static_cast<int>(luaL_checkinteger(L, 1));
 
-  Quadtree *tree = getSpatialTree(L, handle);
+  SpatialIndex *tree = getSpatialTree(L, handle);
   if (!tree) {
     return 0;
   }
@@ -337,6 +452,9 @@ void RegisterSpatialBindings(lua_State *L) {
   lua_pushcfunction(L, Lua_SpatialQueryNearest);
   lua_setfield(L, -2, "queryNearest");
 
+  lua_pushcfunction(L, Lua_SpatialRebuild);
+  lua_setfield(L, -2, "rebuild");
+
   lua_pushcfunction(L, Lua_SpatialClear);
   lua_setfield(L, -2, "clear");
 
@@ -0,0 +1,431 @@
+#include "CampaignSim.h"
+#include "core/Logger.h"
+#include "gameplay/blind/Blind.h"
+#include "gameplay/joker/JokerRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <stdexcept>
+
+namespace sim {
+
+using gameplay::BlindType;
+using gameplay::Card;
+
+namespace {
+
+// ===== GAME CONSTANTS (mirrors content/scripts/criblage) =====
+
+constexpr int kActs = 3;
+constexpr int kHandsPerBlind = 4;
+constexpr int kDiscardsPerBlind = 3;
+constexpr int kHandSize = 6;
+constexpr int kCribSize = 2;
+constexpr int kShopSlots = 3;
+
+/// BossManager:selectBossForAct candidates
+constexpr const char *kAct1Bosses[] = {"the_counter", "the_skunk",
+                                       "the_dealer", "the_drain",
+                                       "the_minimalist_boss"};
+constexpr const char *kLateBosses[] = {"the_purist",    "the_auditor",
+                                       "the_breaker",   "the_collapser",
+                                       "the_tyrant",    "the_wall",
+                                       "thirty_one"};
+
+/// Shop rarities, in Content::jokersByRarity order, with Shop:getJokerPrice
+constexpr const char *kRarities[] = {"common", "uncommon", "rare",
+                                     "legendary"};
+constexpr int kJokerPrices[] = {20, 50, 110, 200};
+
+/// Independent RNG streams derived from a run seed
+constexpr uint64_t kDeckStream = 0x6465636bULL;
+constexpr uint64_t kGameStream = 0x67616d65ULL;
+constexpr uint64_t kStrategyStream = 0x73747261ULL;
+
+/// Economy:calculateReward
+int BlindReward(BlindType type, int score, int required) {
+  int base = 20;
+  if (type == BlindType::BIG) {
+    base = 30;
+  } else if (type == BlindType::BOSS) {
+    base = 50;
+  }
+  return base + std::min((score - required) / 100, 20);
+}
+
+/// Shop:selectRarity (the shop uses the act as its ante)
+int RollRarity(std::mt19937_64 &rng, int ante) {
+  double roll = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+  if (ante <= 2) {
+    return roll < 0.70 ? 0 : roll < 0.95 ? 1 : 2;
+  }
+  return roll < 0.55 ? 0 : roll < 0.90 ? 1 : roll < 0.99 ? 2 : 3;
+}
+
+/// @brief The GameScene deck: all 52 cards, reshuffled for every hand
+/// Shuffled lazily: each draw swaps a uniformly chosen undealt card to the
+/// top (one Fisher-Yates step), so a hand costs one RNG call per card dealt
+/// rather than a full 52-card shuffle. Deals are distributed exactly as
+/// from a fully shuffled deck.
+class HandDeck {
+public:
+  explicit HandDeck(uint64_t seed) : m_rng(seed) {
+    int i = 0;
+    for (int suit = 0; suit < 4; ++suit) {
+      for (int rank = 1; rank <= 13; ++rank) {
+        m_cards[i++] = Card(static_cast<Card::Rank>(rank),
+                            static_cast<Card::Suit>(suit));
+      }
+    }
+  }
+
+  /// Return every card to the deck (the order left behind does not matter)
+  void reshuffle() { m_dealt = 0; }
+
+  Card draw() {
+    if (m_dealt == static_cast<int>(m_cards.size())) {
+      throw std::logic_error("HandDeck: deck is empty");
+    }
+    int pick = m_dealt + RandomIndex(m_rng, static_cast<int>(m_cards.size()) -
+                                                m_dealt);
+    std::swap(m_cards[m_dealt], m_cards[pick]);
+    return m_cards[m_dealt++];
+  }
+
+private:
+  std::array<Card, 52> m_cards;
+  int m_dealt = 0;
+  std::mt19937_64 m_rng;
+};
+
+/// Validate strategy picks: distinct, in range and exactly count of them
+void CheckPicks(const std::vector<int> &picks, size_t count, size_t handSize,
+                const char *what) {
+  bool valid = picks.size() == count;
+  for (size_t i = 0; valid && i < picks.size(); ++i) {
+    valid = picks[i] >= 0 && static_cast<size_t>(picks[i]) < handSize &&
+            std::count(picks.begin(), picks.end(), picks[i]) == 1;
+  }
+  if (!valid) {
+    throw std::logic_error(std::string("Strategy returned invalid ") + what);
+  }
+}
+
+/// Move the picked cards out of the hand (into out, if given)
+void TakeCards(std::vector<Card> &hand, std::vector<int> picks,
+               std::vector<Card> *out) {
+  std::sort(picks.begin(), picks.end());
+  if (out) {
+    for (int index : picks) {
+      out->push_back(hand[index]);
+    }
+  }
+  for (auto it = picks.rbegin(); it != picks.rend(); ++it) {
+    hand.erase(hand.begin() + *it);
+  }
+}
+
+} // namespace
+
+// ===== CONTENT =====
+
+CampaignSim::Content CampaignSim::Content::Load(const std::string &dataDir) {
+  Content content;
+
+  auto &registry = gameplay::JokerRegistry::getInstance();
+  registry.loadDirectory(dataDir + "/jokers");
+  for (int handle = 0; handle < registry.size(); ++handle) {
+    const std::string &rarity = registry.get(handle).rarity;
+    auto it = std::find(std::begin(kRarities), std::end(kRarities), rarity);
+    if (it == std::end(kRarities)) {
+      LOG_WARN("CampaignSim: joker %s has unknown rarity '%s'",
+               registry.get(handle).id.c_str(), rarity.c_str());
+      continue;
+    }
+    content.jokersByRarity[it - std::begin(kRarities)].push_back(handle);
+  }
+
+  auto loadBoss = [&](const char *id) {
+    std::string path = dataDir + "/bosses/" + id + ".json";
+    try {
+      content.bosses.emplace(id, gameplay::Boss::FromJSON(path));
+    } catch (const std::exception &e) {
+      LOG_WARN("CampaignSim: boss %s has no rules (%s)", id, e.what());
+    }
+  };
+  for (const char *id : kAct1Bosses) {
+    loadBoss(id);
+  }
+  for (const char *id : kLateBosses) {
+    loadBoss(id);
+  }
+
+  return content;
+}
+
+// ===== CAMPAIGN =====
+
+CampaignSim::CampaignSim(const Content &content, Config config)
+    : m_content(content), m_config(config) {}
+
+RunRecord CampaignSim::run(std::string_view strategyName,
+                           uint64_t seed) const {
+  auto startClock = std::chrono::steady_clock::now();
+  auto &registry = gameplay::JokerRegistry::getInstance();
+
+  auto strategy = Strategy::Create(strategyName,
+                                   MixSeed(seed, kStrategyStream));
+
+  RunRecord record;
+  record.seed = seed;
+  record.strategy = std::string(strategy->name());
+  record.startTime = static_cast<int64_t>(std::time(nullptr));
+  std::string reasoning = "Strategy: " + record.strategy;
+
+  HandDeck deck(MixSeed(seed, kDeckStream));
+  std::mt19937_64 rng(MixSeed(seed, kGameStream));
+
+  HandScorer scorer;
+  std::vector<OwnedJoker> jokers;
+  int gold = 0;
+
+  std::vector<Card> hand;
+  std::vector<Card> crib;
+  std::vector<int> picks;
+
+  auto finish = [&](const char *outcome) {
+    record.finalize(outcome);
+    record.endTime = static_cast<int64_t>(std::time(nullptr));
+    record.durationSeconds = std::chrono::duration<double>(
+                                 std::chrono::steady_clock::now() - startClock)
+                                 .count();
+  };
+
+  auto recordDecision = [&](const char *type, std::vector<int> selected) {
+    if (m_config.recordDecisions) {
+      for (int &index : selected) {
+        ++index; // 1-based, as the Lua QA bot writes them
+      }
+      record.decisions.push_back(
+          {type, hand, {}, std::move(selected), reasoning});
+    }
+  };
+
+  auto visitShop = [&](int act) {
+    std::array<ShopOffer, kShopSlots> offers;
+    for (auto &offer : offers) {
+      int rarity = RollRarity(rng, act);
+      while (rarity > 0 && m_content.jokersByRarity[rarity].empty()) {
+        --rarity;
+      }
+      const auto &pool = m_content.jokersByRarity[rarity];
+      if (pool.empty()) {
+        offer.available = false;
+        continue;
+      }
+      offer.handle = pool[RandomIndex(rng, static_cast<int>(pool.size()))];
+      offer.price = kJokerPrices[rarity];
+      record.jokerHandlesOffered.push_back(offer.handle);
+    }
+
+    for (int purchase = 0; purchase < kShopSlots; ++purchase) {
+      // JokerManager:addJoker rules: stack if stackable, else a free slot
+      for (auto &offer : offers) {
+        if (offer.handle < 0) {
+          continue;
+        }
+        auto owned = std::find_if(jokers.begin(), jokers.end(),
+                                  [&](const OwnedJoker &j) {
+                                    return j.handle == offer.handle;
+                                  });
+        offer.available =
+            offer.available &&
+            (owned != jokers.end()
+                 ? registry.get(offer.handle).stackable &&
+                       owned->stack < kMaxStack
+                 : static_cast<int>(jokers.size()) < kMaxJokers);
+      }
+
+      ShopContext ctx{offers, jokers, gold, act};
+      int choice = strategy->chooseShopItem(ctx);
+      if (choice < 0 || choice >= kShopSlots || !offers[choice].available ||
+          offers[choice].price > gold) {
+        if (m_config.recordDecisions) {
+          record.decisions.push_back({"shop_skip", {}, {}, {}, reasoning});
+        }
+        return;
+      }
+
+      ShopOffer &offer = offers[choice];
+      const std::string &id = registry.get(offer.handle).id;
+      gold -= offer.price;
+      record.goldSpent += offer.price;
+      record.jokersAcquired.push_back(id);
+      record.jokerHandlesPicked.push_back(offer.handle);
+      if (m_config.recordDecisions) {
+        std::vector<std::string> options;
+        for (const auto &o : offers) {
+          options.push_back(o.handle >= 0 ? registry.get(o.handle).id : "");
+        }
+        record.decisions.push_back(
+            {"shop_purchase", {}, std::move(options), {choice + 1},
+             reasoning});
+      }
+
+      auto owned = std::find_if(
+          jokers.begin(), jokers.end(),
+          [&](const OwnedJoker &j) { return j.handle == offer.handle; });
+      if (owned != jokers.end()) {
+        ++owned->stack;
+        record.jokersStacked[id] = owned->stack;
+        int &maxTier = record.jokersMaxTier[id];
+        maxTier = std::max(maxTier, owned->stack);
+      } else {
+        jokers.push_back({offer.handle, 1});
+      }
+      offer.available = false;
+    }
+  };
+
+  for (int act = 1; act <= kActs; ++act) {
+    for (int blindIndex = 0; blindIndex < 3; ++blindIndex) {
+      BlindType type = static_cast<BlindType>(blindIndex);
+      record.actReached = act;
+      record.blindReached = blindIndex + 1;
+
+      // Boss selection and rules
+      std::string bossId;
+      std::vector<std::string> rules;
+      if (type == BlindType::BOSS) {
+        if (act == 1) {
+          bossId = kAct1Bosses[RandomIndex(
+              rng, static_cast<int>(std::size(kAct1Bosses)))];
+        } else {
+          bossId = kLateBosses[RandomIndex(
+              rng, static_cast<int>(std::size(kLateBosses)))];
+        }
+        record.bossesEncountered.push_back({bossId, act});
+        record.bossesFaced.push_back(bossId);
+
+        auto it = m_content.bosses.find(bossId);
+        if (it != m_content.bosses.end()) {
+          rules = it->second.effects;
+        }
+      }
+
+      int handSize =
+          kHandSize - static_cast<int>(std::count(rules.begin(), rules.end(),
+                                                  "hand_size_reduced"));
+      scorer.setRules(std::move(rules));
+      scorer.setJokers(jokers);
+
+      int required = gameplay::Blind::Create(act, type, bossId)
+                         .GetRequiredScore(m_config.difficulty);
+      int blindScore = 0;
+      int handsRemaining = kHandsPerBlind;
+      int discardsRemaining = kDiscardsPerBlind;
+      crib.clear();
+
+      while (handsRemaining > 0 && blindScore < required) {
+        // GameScene:startNewHand reshuffles the whole deck every hand
+        deck.reshuffle();
+        hand.clear();
+        for (int i = 0; i < handSize; ++i) {
+          hand.push_back(deck.draw());
+        }
+        Card cut = deck.draw();
+
+        auto context = [&]() {
+          HandContext ctx;
+          ctx.hand = hand;
+          ctx.cut = cut;
+          ctx.crib = crib;
+          ctx.handsRemaining = handsRemaining;
+          ctx.discardsRemaining = discardsRemaining;
+          ctx.scoreNeeded = required - blindScore;
+          ctx.scorer = &scorer;
+          return ctx;
+        };
+
+        // Crib fill, with replacements dealt
+        if (crib.size() < kCribSize) {
+          size_t count = kCribSize - crib.size();
+          picks.clear();
+          strategy->chooseCrib(context(), static_cast<int>(count), picks);
+          CheckPicks(picks, count, hand.size(), "crib selection");
+          recordDecision("crib_selection", picks);
+          TakeCards(hand, picks, &crib);
+          for (size_t i = 0; i < count; ++i) {
+            hand.push_back(deck.draw());
+          }
+        }
+
+        // Discards redraw up to the hand size
+        while (discardsRemaining > 0) {
+          picks.clear();
+          strategy->chooseDiscard(context(), picks);
+          if (picks.empty()) {
+            break;
+          }
+          CheckPicks(picks, picks.size(), hand.size(), "discard");
+          recordDecision("discard", picks);
+          TakeCards(hand, picks, nullptr);
+          while (static_cast<int>(hand.size()) < handSize) {
+            hand.push_back(deck.draw());
+          }
+          --discardsRemaining;
+          ++record.discardsUsed;
+        }
+
+        std::array<int, 4> play = strategy->choosePlay(context());
+        picks.assign(play.begin(), play.end());
+        CheckPicks(picks, 4, hand.size(), "play");
+        recordDecision("card_selection", picks);
+
+        std::array<Card, 4> played = {hand[play[0]], hand[play[1]],
+                                      hand[play[2]], hand[play[3]]};
+        HandScorer::Score score = scorer.score(played, cut);
+        int total = score.total;
+
+        // Crib scores on the last hand, topped up with 2 random deck cards
+        if (handsRemaining == 1 && crib.size() == kCribSize) {
+          std::array<Card, 4> cribCards = {crib[0], crib[1], deck.draw(),
+                                           deck.draw()};
+          int cribScore = scorer.score(cribCards, cut).total;
+          total += cribScore;
+          record.cribScores.push_back({(act - 1) * 3 + blindIndex + 1,
+                                       cribScore});
+        }
+
+        record.recordHand({record.handsPlayed + 1, total, score.baseChips,
+                           score.jokerChips, score.mult});
+        blindScore += total;
+        --handsRemaining;
+      }
+
+      record.finalScore = blindScore;
+      if (blindScore < required) {
+        finish("loss");
+        return record;
+      }
+
+      int reward = BlindReward(type, blindScore, required);
+      gold += reward;
+      record.goldEarned += reward;
+      if (type == BlindType::BOSS) {
+        record.bossesDefeated.push_back(bossId);
+      }
+
+      bool lastBlind = act == kActs && type == BlindType::BOSS;
+      if (!lastBlind) {
+        // CampaignState:advanceBlind generates the shop for the next act
+        visitShop(type == BlindType::BOSS ? act + 1 : act);
+      }
+    }
+  }
+
+  finish("win");
+  return record;
+}
+
+} // namespace sim
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "RunRecord.h"
+#include "Strategy.h"
+#include "gameplay/boss/Boss.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sim {
+
+/// @brief Plays complete campaigns headlessly (no Lua, no renderer)
+/// Follows the campaign flow of CampaignState.lua / GameScene.lua: 3 acts of
+/// small, big and boss blinds; 4 hands and 3 discards per blind; a 6-card
+/// hand plus visible cut dealt from a freshly shuffled 52-card deck; 2 cards
+/// per blind go to the crib, which is scored with 2 random deck cards on the
+/// last hand; blind rewards as in Economy.lua; a 3-joker shop between
+/// blinds with Shop.lua prices and rarity odds.
+///
+/// Not simulated: imprints, augments (planets), warps, sculptors, rerolls
+/// and joker selling.
+class CampaignSim {
+public:
+  /// @brief Static game content shared (read-only) by every run
+  struct Content {
+    /// JokerRegistry handles by rarity: common, uncommon, rare, legendary
+    std::array<std::vector<int>, 4> jokersByRarity;
+
+    /// Boss definitions by id
+    std::unordered_map<std::string, gameplay::Boss> bosses;
+
+    /// @brief Load jokers (into JokerRegistry) and bosses from a data dir
+    /// Missing or broken files are skipped with a warning.
+    /// @param dataDir Directory containing jokers/ and bosses/
+    static Content Load(const std::string &dataDir);
+  };
+
+  /// @brief Run settings
+  struct Config {
+    /// Blind score multiplier (0.8=easy, 1.0=normal, 1.3=hard)
+    float difficulty = 1.0f;
+
+    /// Record every strategy decision (large records; slows runs down)
+    bool recordDecisions = false;
+  };
+
+  /// Joker slots, as JokerManager.maxSlots
+  static constexpr int kMaxJokers = 5;
+
+  /// Max stack per joker, as JokerManager:addJoker
+  static constexpr int kMaxStack = 5;
+
+  CampaignSim(const Content &content, Config config);
+
+  /// @brief Play one campaign from start to win or loss
+  /// The run is fully determined by (strategy name, seed, content, config).
+  /// @param strategyName Strategy passed to Strategy::Create
+  /// @param seed Seed for the deck, boss draws, shop and strategy
+  RunRecord run(std::string_view strategyName, uint64_t seed) const;
+
+private:
+  const Content &m_content;
+  Config m_config;
+};
+
+} // namespace sim
@@ -0,0 +1,59 @@
+#include "HandScorer.h"
+#include "gameplay/cribbage/ScoreTable.h"
+#include "gameplay/cribbage/ScoringEngine.h"
+#include "gameplay/joker/JokerRegistry.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace sim {
+
+using gameplay::Card;
+
+void HandScorer::setRules(std::vector<std::string> rules) {
+  m_rules = std::move(rules);
+  m_compiledRules = gameplay::CompiledRuleSet(m_rules);
+  m_jokersDisabled = std::find(m_rules.begin(), m_rules.end(),
+                               "jokers_disabled") != m_rules.end();
+}
+
+void HandScorer::setJokers(std::span<const OwnedJoker> jokers) {
+  auto &registry = gameplay::JokerRegistry::getInstance();
+  m_jokers.clear();
+  for (const OwnedJoker &owned : jokers) {
+    m_jokers.emplace_back(&registry.getCompiled(owned.handle), owned.stack);
+  }
+}
+
+HandScorer::Score HandScorer::score(std::span<const Card> hand,
+                                    const Card &cut) const {
+  static const uint32_t kOnScore =
+      gameplay::CompiledJoker::TriggerMask("on_score");
+
+  std::array<Card, 5> cards;
+  size_t count = std::min<size_t>(hand.size(), 4);
+  std::copy_n(hand.begin(), count, cards.begin());
+  cards[count] = cut;
+  std::span<const Card> all(cards.data(), count + 1);
+
+  auto counts = gameplay::ScoreTable::Lookup(hand.first(count), cut);
+  auto base = gameplay::ScoringEngine::CalculateScore(counts, all, 0.0f, 0.0f,
+                                                      m_compiledRules);
+
+  gameplay::JokerEffectSystem::EffectResult jokers;
+  if (!m_jokers.empty() && !m_jokersDisabled) {
+    jokers = gameplay::JokerEffectSystem::ApplyCompiled(
+        m_jokers, gameplay::HandFacts::From(counts, all), kOnScore);
+  }
+
+  Score result;
+  result.baseChips = base.baseChips;
+  result.jokerChips = jokers.addedChips;
+  result.mult = 1.0f + base.tempMultiplier + base.permMultiplier +
+                jokers.addedTempMult + jokers.addedPermMult;
+  result.total = static_cast<int>(
+      std::floor((result.baseChips + result.jokerChips) * result.mult));
+  return result;
+}
+
+} // namespace sim
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gameplay/card/Card.h"
+#include "gameplay/cribbage/CompiledRuleSet.h"
+#include "gameplay/joker/JokerProgram.h"
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sim {
+
+/// @brief A joker slot owned during a simulated run
+struct OwnedJoker {
+  /// JokerRegistry handle
+  int handle = -1;
+
+  /// Stack count (1-5)
+  int stack = 1;
+};
+
+/// @brief Scores played hands the way ScoringUtils.calculateScore does
+/// Base chips come from ScoringEngine (via ScoreTable, no combo lists);
+/// compiled jokers then add chips and multipliers on top:
+/// final = floor((baseChips + jokerChips) * (1 + temp + perm)).
+/// Imprints, augments and warps are not simulated.
+class HandScorer {
+public:
+  /// @brief Score breakdown for one hand
+  struct Score {
+    int total = 0;
+    int baseChips = 0;
+    int jokerChips = 0;
+    float mult = 1.0f;
+  };
+
+  /// @brief Set the active boss rules
+  /// "jokers_disabled" is handled here; everything else is compiled once
+  /// for ScoringEngine.
+  void setRules(std::vector<std::string> rules);
+
+  /// @brief Set the joker slots (handles must be valid registry handles)
+  void setJokers(std::span<const OwnedJoker> jokers);
+
+  /// @brief Score a hand against a cut
+  /// @param hand Played cards (up to 4)
+  /// @param cut The cut card
+  Score score(std::span<const gameplay::Card> hand,
+              const gameplay::Card &cut) const;
+
+  /// @brief Active boss rules
+  const std::vector<std::string> &rules() const { return m_rules; }
+
+private:
+  std::vector<std::string> m_rules;
+  gameplay::CompiledRuleSet m_compiledRules;
+  std::vector<std::pair<const gameplay::CompiledJoker *, int>> m_jokers;
+  bool m_jokersDisabled = false;
+};
+
+} // namespace sim
@@ -0,0 +1,132 @@
+#include "RunRecord.h"
+#include <algorithm>
+
+namespace sim {
+
+namespace {
+
+/// Lua-side card id / rank / suit strings ("7_H", "7", "H")
+nlohmann::json CardToJSON(const gameplay::Card &card) {
+  static const char *kRanks[] = {"",  "A", "2", "3",  "4", "5", "6",
+                                 "7", "8", "9", "10", "J", "Q", "K"};
+  static const char *kSuits[] = {"H", "D", "C", "S"};
+
+  std::string rank = kRanks[card.getRankValue()];
+  std::string suit = kSuits[card.getSuitValue()];
+  return {{"id", rank + "_" + suit},
+          {"rank", rank},
+          {"suit", suit},
+          {"imprints", nlohmann::json::array()}};
+}
+
+} // namespace
+
+void RunRecord::recordHand(const HandScoreRecord &hand) {
+  handScores.push_back(hand);
+  handsPlayed = static_cast<int>(handScores.size());
+
+  bestHandScore = std::max(bestHandScore, hand.score);
+  if (hand.score > 0 && hand.score < worstHandScore) {
+    worstHandScore = hand.score;
+  }
+}
+
+void RunRecord::finalize(const std::string &runOutcome) {
+  outcome = runOutcome;
+
+  if (!handScores.empty()) {
+    double total = 0.0;
+    for (const auto &hand : handScores) {
+      total += hand.score;
+    }
+    averageHandScore = total / static_cast<double>(handScores.size());
+  }
+}
+
+nlohmann::json RunRecord::toJSON() const {
+  using nlohmann::json;
+
+  json hands = json::array();
+  for (const auto &hand : handScores) {
+    hands.push_back({{"handNum", hand.handNum},
+                     {"score", hand.score},
+                     {"timestamp", startTime},
+                     {"breakdown",
+                      {{"baseChips", hand.baseChips},
+                       {"jokerChips", hand.jokerChips},
+                       {"mult", hand.mult}}}});
+  }
+
+  json cribs = json::array();
+  for (const auto &crib : cribScores) {
+    cribs.push_back({{"blindNum", crib.blindNum},
+                     {"score", crib.score},
+                     {"timestamp", startTime}});
+  }
+
+  json encountered = json::array();
+  for (const auto &boss : bossesEncountered) {
+    encountered.push_back(
+        {{"bossId", boss.bossId}, {"act", boss.act}, {"timestamp", startTime}});
+  }
+
+  json decisionList = json::array();
+  for (const auto &decision : decisions) {
+    json options = json::array();
+    for (const auto &card : decision.options) {
+      options.push_back(CardToJSON(card));
+    }
+    for (const auto &item : decision.shopOptions) {
+      options.push_back(item);
+    }
+    decisionList.push_back({{"type", decision.type},
+                            {"timestamp", startTime},
+                            {"options", options},
+                            {"selected", decision.selected},
+                            {"reasoning", decision.reasoning}});
+  }
+
+  return {
+      {"runId", runId},
+      {"startTime", startTime},
+      {"endTime", endTime},
+      {"durationSeconds", durationSeconds},
+      {"strategy", strategy},
+      {"seed", seed},
+      {"outcome", outcome},
+      {"actReached", actReached},
+      {"blindReached", blindReached},
+      {"finalScore", finalScore},
+      {"handsPlayed", handsPlayed},
+      {"discardsUsed", discardsUsed},
+      {"goldEarned", goldEarned},
+      {"goldSpent", goldSpent},
+      {"rerollsUsed", rerollsUsed},
+      {"jokersAcquired", jokersAcquired},
+      {"jokersStacked", jokersStacked},
+      {"jokersMaxTier", jokersMaxTier},
+      {"handScores", hands},
+      {"cribScores", cribs},
+      {"bestHandScore", bestHandScore},
+      {"worstHandScore", worstHandScore},
+      {"averageHandScore", averageHandScore},
+      {"bossesEncountered", encountered},
+      {"bossesFaced", bossesFaced},
+      {"bossesDefeated", bossesDefeated},
+      {"decisions", decisionList},
+      // Not simulated; kept so the schema matches qa_results/run_*.json
+      {"planetsAcquired", json::array()},
+      {"warpsActive", json::array()},
+      {"imprintsApplied", json::array()},
+      {"sculptorsUsed", json::array()},
+      {"achievementsUnlocked", json::array()},
+      {"errors", json::array()},
+      {"warnings", json::array()},
+      {"logicErrors", json::array()},
+      {"avgFrameTimeMs", 0.0},
+      {"maxFrameTimeMs", 0.0},
+      {"minFrameTimeMs", 0.0},
+  };
+}
+
+} // namespace sim
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "gameplay/card/Card.h"
+#include <cstdint>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+/// @brief One scored hand
+struct HandScoreRecord {
+  int handNum = 0;
+  int score = 0;
+  int baseChips = 0;
+  int jokerChips = 0;
+  float mult = 1.0f;
+};
+
+/// @brief One scored crib (last hand of a blind)
+struct CribScoreRecord {
+  /// Blind index across the campaign (1-9)
+  int blindNum = 0;
+  int score = 0;
+};
+
+/// @brief A boss blind that was started
+struct BossEncounter {
+  std::string bossId;
+  int act = 1;
+};
+
+/// @brief A strategy decision (only recorded when requested; costly)
+struct DecisionRecord {
+  /// "crib_selection", "card_selection", "discard", "shop_purchase",
+  /// "shop_skip"
+  std::string type;
+  std::vector<gameplay::Card> options;
+  std::vector<std::string> shopOptions;
+  std::vector<int> selected;
+  std::string reasoning;
+};
+
+/// @brief Statistics for one simulated campaign
+/// Field names match the QA bot's qa_results/run_*.json files
+/// (content/scripts/Systems/AutoPlayStats.lua) so the same tooling reads
+/// both.
+struct RunRecord {
+  std::string runId;
+  int64_t startTime = 0;
+  int64_t endTime = 0;
+  double durationSeconds = 0.0;
+  std::string strategy;
+  uint64_t seed = 0;
+
+  // Outcome
+  std::string outcome = "in_progress";
+  int actReached = 1;
+  int blindReached = 1;
+  int finalScore = 0;
+
+  // Basic stats
+  int handsPlayed = 0;
+  int discardsUsed = 0;
+  int goldEarned = 0;
+  int goldSpent = 0;
+  int rerollsUsed = 0;
+
+  // Collections
+  std::vector<std::string> jokersAcquired;
+  std::map<std::string, int> jokersStacked;
+  std::map<std::string, int> jokersMaxTier;
+
+  /// JokerRegistry handles shown in / bought from shops (sweep statistics;
+  /// not serialized)
+  std::vector<int> jokerHandlesOffered;
+  std::vector<int> jokerHandlesPicked;
+
+  // Hand scoring history
+  std::vector<HandScoreRecord> handScores;
+  std::vector<CribScoreRecord> cribScores;
+  int bestHandScore = 0;
+  int worstHandScore = 999999;
+  double averageHandScore = 0.0;
+
+  // Boss encounters
+  std::vector<BossEncounter> bossesEncountered;
+  std::vector<std::string> bossesFaced;
+  std::vector<std::string> bossesDefeated;
+
+  std::vector<DecisionRecord> decisions;
+
+  /// @brief Record a scored hand (updates best/worst like AutoPlayStats)
+  void recordHand(const HandScoreRecord &hand);
+
+  /// @brief Fill in derived fields once the run is over
+  void finalize(const std::string &runOutcome);
+
+  /// @brief Serialize with the qa_results/run_*.json field names
+  nlohmann::json toJSON() const;
+};
+
+} // namespace sim
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+namespace sim {
+
+/// @brief SplitMix64 finalizer: derives decorrelated seeds from one seed
+/// @param seed Base seed
+/// @param stream Stream id (e.g. run index, or a per-subsystem constant)
+inline uint64_t MixSeed(uint64_t seed, uint64_t stream) {
+  uint64_t z = seed + (stream + 1) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+/// @brief Uniform index in [0, n) from a 64-bit engine
+/// Plain modulo (not std::uniform_int_distribution) so results do not depend
+/// on the standard library implementation.
+inline int RandomIndex(std::mt19937_64 &rng, int n) {
+  return static_cast<int>(rng() % static_cast<uint64_t>(n));
+}
+
+} // namespace sim
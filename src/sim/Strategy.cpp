@@ -0,0 +1,234 @@
+#include "Strategy.h"
+#include "gameplay/joker/JokerRegistry.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace sim {
+
+using gameplay::Card;
+
+std::pair<std::array<int, 4>, int> BestPlay(const HandContext &ctx) {
+  int n = static_cast<int>(ctx.hand.size());
+  std::array<int, 4> best = {0, 1, 2, 3};
+  int bestScore = -1;
+
+  std::array<Card, 4> play;
+  for (int a = 0; a < n; ++a) {
+    for (int b = a + 1; b < n; ++b) {
+      for (int c = b + 1; c < n; ++c) {
+        for (int d = c + 1; d < n; ++d) {
+          play = {ctx.hand[a], ctx.hand[b], ctx.hand[c], ctx.hand[d]};
+          int score = ctx.scorer->score(play, ctx.cut).total;
+          if (score > bestScore) {
+            bestScore = score;
+            best = {a, b, c, d};
+          }
+        }
+      }
+    }
+  }
+  return {best, std::max(bestScore, 0)};
+}
+
+namespace {
+
+/// Cards not used by the best play first, then the rest in hand order
+void LeftoversFirst(const HandContext &ctx, int count, std::vector<int> &out) {
+  std::array<int, 4> play = BestPlay(ctx).first;
+  int n = static_cast<int>(ctx.hand.size());
+
+  for (int i = 0; i < n && static_cast<int>(out.size()) < count; ++i) {
+    if (std::find(play.begin(), play.end(), i) == play.end()) {
+      out.push_back(i);
+    }
+  }
+  for (int i = 0; i < n && static_cast<int>(out.size()) < count; ++i) {
+    if (std::find(out.begin(), out.end(), i) == out.end()) {
+      out.push_back(i);
+    }
+  }
+}
+
+// ===== RANDOM =====
+
+/// Baseline: random legal choices, random affordable purchases
+class RandomStrategy : public Strategy {
+public:
+  explicit RandomStrategy(uint64_t seed) : m_rng(seed) {}
+
+  std::string_view name() const override { return "Random"; }
+
+  void chooseCrib(const HandContext &ctx, int count,
+                  std::vector<int> &out) override {
+    pickDistinct(static_cast<int>(ctx.hand.size()), count, out);
+  }
+
+  void chooseDiscard(const HandContext &ctx, std::vector<int> &out) override {
+    // Discard 1-2 random cards a quarter of the time
+    if (RandomIndex(m_rng, 4) == 0) {
+      pickDistinct(static_cast<int>(ctx.hand.size()),
+                   1 + RandomIndex(m_rng, 2), out);
+    }
+  }
+
+  std::array<int, 4> choosePlay(const HandContext &ctx) override {
+    std::vector<int> picked;
+    pickDistinct(static_cast<int>(ctx.hand.size()), 4, picked);
+    return {picked[0], picked[1], picked[2], picked[3]};
+  }
+
+  int chooseShopItem(const ShopContext &ctx) override {
+    std::vector<int> affordable;
+    for (int i = 0; i < static_cast<int>(ctx.offers.size()); ++i) {
+      if (ctx.offers[i].available && ctx.offers[i].price <= ctx.gold) {
+        affordable.push_back(i);
+      }
+    }
+    if (affordable.empty() || RandomIndex(m_rng, 2) == 0) {
+      return -1;
+    }
+    return affordable[RandomIndex(m_rng, static_cast<int>(affordable.size()))];
+  }
+
+private:
+  void pickDistinct(int n, int count, std::vector<int> &out) {
+    std::array<int, 16> indices;
+    n = std::min(n, static_cast<int>(indices.size()));
+    for (int i = 0; i < n; ++i) {
+      indices[i] = i;
+    }
+    // Partial Fisher-Yates
+    for (int i = 0; i < count && i < n; ++i) {
+      int j = i + RandomIndex(m_rng, n - i);
+      std::swap(indices[i], indices[j]);
+      out.push_back(indices[i]);
+    }
+  }
+
+  std::mt19937_64 m_rng;
+};
+
+// ===== GREEDY =====
+
+/// Plays the best 4 cards for the visible cut; never discards; buys the
+/// first affordable joker.
+class GreedyStrategy : public Strategy {
+public:
+  std::string_view name() const override { return "Greedy"; }
+
+  void chooseCrib(const HandContext &ctx, int count,
+                  std::vector<int> &out) override {
+    LeftoversFirst(ctx, count, out);
+  }
+
+  void chooseDiscard(const HandContext &, std::vector<int> &) override {}
+
+  std::array<int, 4> choosePlay(const HandContext &ctx) override {
+    return BestPlay(ctx).first;
+  }
+
+  int chooseShopItem(const ShopContext &ctx) override {
+    for (int i = 0; i < static_cast<int>(ctx.offers.size()); ++i) {
+      if (ctx.offers[i].available && ctx.offers[i].price <= ctx.gold) {
+        return i;
+      }
+    }
+    return -1;
+  }
+};
+
+// ===== OPTIMAL =====
+
+/// Greedy play, plus: redraws the unused cards while behind the pace needed
+/// to clear the blind, and shops for stacks first, then the priciest joker.
+class OptimalStrategy : public GreedyStrategy {
+public:
+  std::string_view name() const override { return "Optimal"; }
+
+  void chooseDiscard(const HandContext &ctx, std::vector<int> &out) override {
+    if (ctx.handsRemaining <= 0 || ctx.hand.size() <= 4) {
+      return;
+    }
+
+    auto [play, score] = BestPlay(ctx);
+    int pace = (ctx.scoreNeeded + ctx.handsRemaining - 1) / ctx.handsRemaining;
+    if (score >= pace) {
+      // choosePlay follows with this same hand: keep the search result
+      m_keptHand.assign(ctx.hand.begin(), ctx.hand.end());
+      m_keptCut = ctx.cut;
+      m_keptScorer = ctx.scorer;
+      m_keptPlay = play;
+      return;
+    }
+
+    // Keeping the best play and redrawing the rest can only improve it
+    for (int i = 0; i < static_cast<int>(ctx.hand.size()); ++i) {
+      if (std::find(play.begin(), play.end(), i) == play.end()) {
+        out.push_back(i);
+      }
+    }
+  }
+
+  std::array<int, 4> choosePlay(const HandContext &ctx) override {
+    bool kept = m_keptScorer == ctx.scorer && m_keptCut == ctx.cut &&
+                std::equal(m_keptHand.begin(), m_keptHand.end(),
+                           ctx.hand.begin(), ctx.hand.end());
+    m_keptScorer = nullptr;
+    return kept ? m_keptPlay : GreedyStrategy::choosePlay(ctx);
+  }
+
+  int chooseShopItem(const ShopContext &ctx) override {
+    auto &registry = gameplay::JokerRegistry::getInstance();
+
+    int best = -1;
+    int bestRank = -1;
+    for (int i = 0; i < static_cast<int>(ctx.offers.size()); ++i) {
+      const ShopOffer &offer = ctx.offers[i];
+      if (!offer.available || offer.price > ctx.gold) {
+        continue;
+      }
+
+      // Stacking an owned joker upgrades its tier: prefer it over price
+      bool stacks = std::any_of(
+          ctx.owned.begin(), ctx.owned.end(),
+          [&](const OwnedJoker &owned) { return owned.handle == offer.handle; });
+      int rank = offer.price + (stacks && registry.get(offer.handle).stackable
+                                    ? 1000
+                                    : 0);
+      if (rank > bestRank) {
+        bestRank = rank;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+private:
+  /// Best play found by the last chooseDiscard that kept its hand
+  std::vector<Card> m_keptHand;
+  Card m_keptCut;
+  const HandScorer *m_keptScorer = nullptr;
+  std::array<int, 4> m_keptPlay{};
+};
+
+constexpr std::string_view kNames[] = {"Random", "Greedy", "Optimal"};
+
+} // namespace
+
+std::unique_ptr<Strategy> Strategy::Create(std::string_view name,
+                                           uint64_t seed) {
+  if (name == "Random") {
+    return std::make_unique<RandomStrategy>(seed);
+  }
+  if (name == "Greedy") {
+    return std::make_unique<GreedyStrategy>();
+  }
+  if (name == "Optimal") {
+    return std::make_unique<OptimalStrategy>();
+  }
+  throw std::invalid_argument("Unknown strategy: " + std::string(name));
+}
+
+std::span<const std::string_view> Strategy::Names() { return kNames; }
+
+} // namespace sim
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "HandScorer.h"
+#include "SimRandom.h"
+#include "gameplay/card/Card.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sim {
+
+/// @brief What a strategy can see when making card decisions
+struct HandContext {
+  /// Cards currently in hand (usually 6)
+  std::span<const gameplay::Card> hand;
+
+  /// The cut card (visible to the player, as in GameScene)
+  gameplay::Card cut;
+
+  /// Cards already in the crib this blind (0-2)
+  std::span<const gameplay::Card> crib;
+
+  int handsRemaining = 0;
+  int discardsRemaining = 0;
+
+  /// Score still needed to clear the blind
+  int scoreNeeded = 0;
+
+  /// Scorer with the current boss rules and jokers
+  const HandScorer *scorer = nullptr;
+};
+
+/// @brief One joker offered in the shop
+struct ShopOffer {
+  int handle = -1;
+  int price = 0;
+
+  /// False if the joker cannot be added (slots full or max stack)
+  bool available = true;
+};
+
+/// @brief What a strategy can see when shopping
+struct ShopContext {
+  std::span<const ShopOffer> offers;
+  std::span<const OwnedJoker> owned;
+  int gold = 0;
+  int act = 1;
+};
+
+/// @brief Pluggable decision-maker for simulated runs
+/// Mirrors the QA bot strategies in AutoPlayStrategies.lua. A strategy is
+/// created per run and may keep its own seeded RNG.
+class Strategy {
+public:
+  virtual ~Strategy() = default;
+
+  /// @brief Display name written to the run record ("Random", ...)
+  virtual std::string_view name() const = 0;
+
+  /// @brief Pick cards from the hand to put in the crib
+  /// @param count Number of cards to pick (1-2)
+  /// @param out Distinct hand indices (exactly count)
+  virtual void chooseCrib(const HandContext &ctx, int count,
+                          std::vector<int> &out) = 0;
+
+  /// @brief Pick cards to discard and redraw (leave out empty to skip)
+  /// Only called while discards remain.
+  virtual void chooseDiscard(const HandContext &ctx,
+                             std::vector<int> &out) = 0;
+
+  /// @brief Pick the 4 cards to play
+  virtual std::array<int, 4> choosePlay(const HandContext &ctx) = 0;
+
+  /// @brief Pick a shop offer to buy
+  /// @return Index into ctx.offers, or -1 to leave the shop
+  virtual int chooseShopItem(const ShopContext &ctx) = 0;
+
+  /// @brief Create a strategy by name
+  /// @param name "Random", "Greedy" or "Optimal" (case-sensitive)
+  /// @param seed Seed for the strategy's own RNG
+  /// @throws std::invalid_argument for unknown names
+  static std::unique_ptr<Strategy> Create(std::string_view name,
+                                          uint64_t seed);
+
+  /// @brief Names accepted by Create()
+  static std::span<const std::string_view> Names();
+};
+
+/// @brief Best 4-card play for the visible cut (exhaustive, 15 subsets of 6)
+/// @return Hand indices and the play's score
+std::pair<std::array<int, 4>, int> BestPlay(const HandContext &ctx);
+
+} // namespace sim
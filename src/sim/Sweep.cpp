@@ -0,0 +1,223 @@
+#include "Sweep.h"
+#include "SimRandom.h"
+#include "core/ParallelFor.h"
+#include "gameplay/joker/JokerRegistry.h"
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace sim {
+
+namespace {
+
+/// Per-worker accumulator, padded so workers never share a cache line
+struct alignas(64) Shard {
+  SweepStats stats;
+};
+
+void AddCounts(std::vector<uint64_t> &counts, const std::vector<int> &handles) {
+  for (int handle : handles) {
+    if (handle < 0) {
+      continue;
+    }
+    if (static_cast<size_t>(handle) >= counts.size()) {
+      counts.resize(handle + 1, 0);
+    }
+    ++counts[handle];
+  }
+}
+
+void MergeCounts(std::vector<uint64_t> &into,
+                 const std::vector<uint64_t> &from) {
+  if (into.size() < from.size()) {
+    into.resize(from.size(), 0);
+  }
+  for (size_t i = 0; i < from.size(); ++i) {
+    into[i] += from[i];
+  }
+}
+
+double Rate(uint64_t count, uint64_t total) {
+  return total > 0 ? static_cast<double>(count) / static_cast<double>(total)
+                   : 0.0;
+}
+
+nlohmann::json Histogram(const std::array<uint64_t, SweepStats::kScoreBuckets>
+                             &buckets) {
+  nlohmann::json out = nlohmann::json::array();
+  for (int b = 0; b < SweepStats::kScoreBuckets; ++b) {
+    if (buckets[b] == 0) {
+      continue;
+    }
+    int64_t min = b == 0 ? 0 : int64_t{1} << (b - 1);
+    int64_t max = b == 0 ? 0 : (int64_t{1} << b) - 1;
+    out.push_back({{"min", min}, {"max", max}, {"count", buckets[b]}});
+  }
+  return out;
+}
+
+} // namespace
+
+// ===== STATS =====
+
+int SweepStats::ScoreBucket(int score) {
+  if (score <= 0) {
+    return 0;
+  }
+  int bucket = std::bit_width(static_cast<uint32_t>(score));
+  return std::min(bucket, kScoreBuckets - 1);
+}
+
+void SweepStats::add(const RunRecord &run) {
+  ++runs;
+  bool won = run.outcome == "win";
+  wins += won;
+  handsPlayed += run.handsPlayed;
+  discardsUsed += run.discardsUsed;
+  goldEarned += run.goldEarned;
+  goldSpent += run.goldSpent;
+
+  for (int act = 1; act <= run.actReached && act < 4; ++act) {
+    ++actReached[act];
+    if (act < run.actReached || won) {
+      ++actCleared[act];
+    }
+  }
+
+  for (const auto &hand : run.handScores) {
+    handScoreTotal += hand.score;
+    ++handScores[ScoreBucket(hand.score)];
+  }
+  ++finalScores[ScoreBucket(run.finalScore)];
+
+  AddCounts(jokerOffered, run.jokerHandlesOffered);
+  AddCounts(jokerPicked, run.jokerHandlesPicked);
+
+  for (const auto &boss : run.bossesFaced) {
+    ++bossFaced[boss];
+  }
+  for (const auto &boss : run.bossesDefeated) {
+    ++bossDefeated[boss];
+  }
+}
+
+void SweepStats::merge(const SweepStats &other) {
+  runs += other.runs;
+  wins += other.wins;
+  handsPlayed += other.handsPlayed;
+  discardsUsed += other.discardsUsed;
+  goldEarned += other.goldEarned;
+  goldSpent += other.goldSpent;
+  handScoreTotal += other.handScoreTotal;
+
+  for (size_t i = 0; i < actReached.size(); ++i) {
+    actReached[i] += other.actReached[i];
+    actCleared[i] += other.actCleared[i];
+  }
+  for (int b = 0; b < kScoreBuckets; ++b) {
+    handScores[b] += other.handScores[b];
+    finalScores[b] += other.finalScores[b];
+  }
+
+  MergeCounts(jokerOffered, other.jokerOffered);
+  MergeCounts(jokerPicked, other.jokerPicked);
+
+  for (const auto &[boss, count] : other.bossFaced) {
+    bossFaced[boss] += count;
+  }
+  for (const auto &[boss, count] : other.bossDefeated) {
+    bossDefeated[boss] += count;
+  }
+}
+
+nlohmann::json SweepStats::toJSON() const {
+  using nlohmann::json;
+  auto &registry = gameplay::JokerRegistry::getInstance();
+
+  json acts = json::array();
+  for (int act = 1; act <= 3; ++act) {
+    acts.push_back({{"act", act},
+                    {"reached", actReached[act]},
+                    {"cleared", actCleared[act]},
+                    {"winRate", Rate(actCleared[act], actReached[act])}});
+  }
+
+  json jokers = json::object();
+  for (size_t h = 0; h < jokerOffered.size(); ++h) {
+    uint64_t picked = h < jokerPicked.size() ? jokerPicked[h] : 0;
+    if (jokerOffered[h] == 0) {
+      continue;
+    }
+    std::string id = registry.isValid(static_cast<int>(h))
+                         ? registry.get(static_cast<int>(h)).id
+                         : std::to_string(h);
+    jokers[id] = {{"offered", jokerOffered[h]},
+                  {"picked", picked},
+                  {"pickRate", Rate(picked, jokerOffered[h])}};
+  }
+
+  json bosses = json::object();
+  for (const auto &[boss, faced] : bossFaced) {
+    auto it = bossDefeated.find(boss);
+    uint64_t defeated = it != bossDefeated.end() ? it->second : 0;
+    bosses[boss] = {{"faced", faced},
+                    {"defeated", defeated},
+                    {"winRate", Rate(defeated, faced)}};
+  }
+
+  return {
+      {"runs", runs},
+      {"wins", wins},
+      {"winRate", Rate(wins, runs)},
+      {"handsPlayed", handsPlayed},
+      {"averageHandScore",
+       handsPlayed > 0 ? static_cast<double>(handScoreTotal) /
+                             static_cast<double>(handsPlayed)
+                       : 0.0},
+      {"discardsUsed", discardsUsed},
+      {"goldEarned", goldEarned},
+      {"goldSpent", goldSpent},
+      {"acts", acts},
+      {"handScoreHistogram", Histogram(handScores)},
+      {"finalScoreHistogram", Histogram(finalScores)},
+      {"jokers", jokers},
+      {"bosses", bosses},
+  };
+}
+
+// ===== SWEEP =====
+
+uint64_t Sweep::RunSeed(uint64_t masterSeed, size_t index) {
+  return MixSeed(masterSeed, index);
+}
+
+SweepStats Sweep::Run(const CampaignSim &simulator, const SweepConfig &config,
+                      const RunCallback &onRun) {
+  int threads = config.threads;
+  if (threads <= 0) {
+    threads = static_cast<int>(
+        std::max(1u, std::thread::hardware_concurrency()));
+  }
+
+  std::vector<Shard> shards(threads);
+  ParallelFor(config.runs, threads, config.grain,
+              [&](int worker, size_t begin, size_t end) {
+                SweepStats &stats = shards[worker].stats;
+                for (size_t i = begin; i < end; ++i) {
+                  RunRecord run = simulator.run(
+                      config.strategy, RunSeed(config.masterSeed, i));
+                  stats.add(run);
+                  if (onRun) {
+                    onRun(i, run);
+                  }
+                }
+              });
+
+  SweepStats total;
+  for (const Shard &shard : shards) {
+    total.merge(shard.stats);
+  }
+  return total;
+}
+
+} // namespace sim
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CampaignSim.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace sim {
+
+/// @brief Aggregate statistics over many runs
+/// Only integer counters, so merging is associative and commutative: a
+/// sweep's statistics are bit-identical whatever the thread count or the
+/// order in which workers finished.
+struct SweepStats {
+  /// Log2 score buckets: bucket 0 holds scores <= 0, bucket b holds
+  /// [2^(b-1), 2^b)
+  static constexpr int kScoreBuckets = 32;
+
+  uint64_t runs = 0;
+  uint64_t wins = 0;
+  uint64_t handsPlayed = 0;
+  uint64_t discardsUsed = 0;
+  uint64_t goldEarned = 0;
+  uint64_t goldSpent = 0;
+  int64_t handScoreTotal = 0;
+
+  /// Runs that started / cleared each act (index = act, 1-3)
+  std::array<uint64_t, 4> actReached{};
+  std::array<uint64_t, 4> actCleared{};
+
+  /// Distribution of per-hand scores and of final blind scores
+  std::array<uint64_t, kScoreBuckets> handScores{};
+  std::array<uint64_t, kScoreBuckets> finalScores{};
+
+  /// Shop offers and purchases by JokerRegistry handle
+  std::vector<uint64_t> jokerOffered;
+  std::vector<uint64_t> jokerPicked;
+
+  /// Boss blinds started / cleared by boss id
+  std::map<std::string, uint64_t> bossFaced;
+  std::map<std::string, uint64_t> bossDefeated;
+
+  /// @brief Fold one run into the totals
+  void add(const RunRecord &run);
+
+  /// @brief Fold another set of totals into this one
+  void merge(const SweepStats &other);
+
+  /// @brief Bucket index for a score
+  static int ScoreBucket(int score);
+
+  /// @brief Summary with derived rates (win rate per act, pick rates, ...)
+  nlohmann::json toJSON() const;
+};
+
+/// @brief Settings for a sweep
+struct SweepConfig {
+  std::string strategy = "Greedy";
+
+  /// Run i plays with seed RunSeed(masterSeed, i)
+  uint64_t masterSeed = 1;
+
+  size_t runs = 1000;
+
+  /// Worker threads (<= 0 = all cores)
+  int threads = 0;
+
+  /// Runs per work-stealing chunk
+  size_t grain = 16;
+};
+
+/// @brief Plays many campaigns across a work-stealing thread pool
+/// Every run's seed depends only on the master seed and the run index, and
+/// each worker accumulates into its own SweepStats shard (no locks or shared
+/// writes on the hot path). Shards are merged once at the end.
+class Sweep {
+public:
+  /// @brief Called on a worker thread after each run
+  using RunCallback = std::function<void(size_t index, RunRecord &run)>;
+
+  /// @brief Seed for run index of a sweep
+  static uint64_t RunSeed(uint64_t masterSeed, size_t index);
+
+  /// @brief Play config.runs campaigns and merge their statistics
+  /// @param simulator Shared, read-only simulator (content must not change
+  /// during the sweep)
+  /// @param config Sweep settings
+  /// @param onRun Optional per-run hook (e.g. to write run JSON); must be
+  /// thread-safe
+  /// @throws Whatever a run throws (e.g. std::invalid_argument for an
+  /// unknown strategy); remaining runs are abandoned
+  static SweepStats Run(const CampaignSim &simulator,
+                        const SweepConfig &config,
+                        const RunCallback &onRun);
+};
+
+} // namespace sim
@@ -0,0 +1,135 @@
+// Headless campaign simulator: plays full runs with C++ strategies and
+// writes qa_results-compatible JSON. No Lua, SDL or renderer involved.
+//
+// Usage:
+//   magic_hands_sim [--runs=N] [--seed=S] [--strategy=NAME] [--threads=N]
+//                   [--difficulty=F] [--data=DIR] [--out=DIR] [--decisions]
+//                   [--stats=FILE]
+
+#include "core/Logger.h"
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include "sim/Sweep.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+void PrintUsage() {
+  std::printf(
+      "Usage: magic_hands_sim [options]\n"
+      "  --runs=N          Campaigns to play (default 1000)\n"
+      "  --seed=S          Master seed (default 1)\n"
+      "  --strategy=NAME   Random, Greedy or Optimal (default Greedy)\n"
+      "  --threads=N       Worker threads (default: all cores)\n"
+      "  --difficulty=F    Blind score multiplier (default 1.0)\n"
+      "  --data=DIR        Content data directory (default content/data)\n"
+      "  --out=DIR         Write one run_*.json per run into DIR\n"
+      "  --decisions       Include every decision in the JSON output\n"
+      "  --stats=FILE      Write merged sweep statistics as JSON\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  sim::SweepConfig sweep;
+  std::string dataDir = "content/data";
+  std::string outDir;
+  std::string statsFile;
+  sim::CampaignSim::Config config;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--runs=", 7) == 0) {
+      sweep.runs = strtoull(argv[i] + 7, nullptr, 10);
+    } else if (strncmp(argv[i], "--seed=", 7) == 0) {
+      sweep.masterSeed = strtoull(argv[i] + 7, nullptr, 10);
+    } else if (strncmp(argv[i], "--strategy=", 11) == 0) {
+      sweep.strategy = argv[i] + 11;
+    } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+      sweep.threads = atoi(argv[i] + 10);
+    } else if (strncmp(argv[i], "--difficulty=", 13) == 0) {
+      config.difficulty = static_cast<float>(atof(argv[i] + 13));
+    } else if (strncmp(argv[i], "--data=", 7) == 0) {
+      dataDir = argv[i] + 7;
+    } else if (strncmp(argv[i], "--out=", 6) == 0) {
+      outDir = argv[i] + 6;
+    } else if (strncmp(argv[i], "--stats=", 8) == 0) {
+      statsFile = argv[i] + 8;
+    } else if (strcmp(argv[i], "--decisions") == 0) {
+      config.recordDecisions = true;
+    } else {
+      PrintUsage();
+      return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  Logger::Init(LogLevel::Warn);
+  gameplay::EffectFactory::registerBuiltInEffects();
+
+  sim::CampaignSim::Content content = sim::CampaignSim::Content::Load(dataDir);
+  sim::CampaignSim simulator(content, config);
+
+  if (!outDir.empty()) {
+    std::filesystem::create_directories(outDir);
+  }
+
+  // Same run id scheme as AutoPlay.lua: run_<date>_<time>_<index>
+  char stamp[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+
+  sim::Sweep::RunCallback writeRun;
+  if (!outDir.empty()) {
+    writeRun = [&](size_t index, sim::RunRecord &record) {
+      char runId[64];
+      std::snprintf(runId, sizeof(runId), "run_%s_%03zu", stamp, index + 1);
+      record.runId = runId;
+      std::ofstream file(outDir + "/" + record.runId + ".json");
+      file << record.toJSON().dump(2);
+    };
+  }
+
+  sim::SweepStats stats;
+  auto start = std::chrono::steady_clock::now();
+  try {
+    stats = sim::Sweep::Run(simulator, sweep, writeRun);
+  } catch (const std::exception &e) {
+    LOG_ERROR("Simulation failed: %s", e.what());
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  nlohmann::json summary = stats.toJSON();
+  if (!statsFile.empty()) {
+    nlohmann::json out = {{"strategy", sweep.strategy},
+                          {"masterSeed", sweep.masterSeed},
+                          {"difficulty", config.difficulty},
+                          {"stats", summary}};
+    std::ofstream(statsFile) << out.dump(2);
+  }
+
+  std::printf("Strategy:     %s\n", sweep.strategy.c_str());
+  std::printf("Runs:         %llu (master seed %llu)\n",
+              static_cast<unsigned long long>(stats.runs),
+              static_cast<unsigned long long>(sweep.masterSeed));
+  std::printf("Win rate:     %.2f%%\n",
+              100.0 * summary["winRate"].get<double>());
+  for (const auto &act : summary["acts"]) {
+    std::printf("  Act %d:      %.2f%% of %llu\n", act["act"].get<int>(),
+                100.0 * act["winRate"].get<double>(),
+                act["reached"].get<unsigned long long>());
+  }
+  std::printf("Hands:        %llu (avg score %.1f)\n",
+              static_cast<unsigned long long>(stats.handsPlayed),
+              summary["averageHandScore"].get<double>());
+  std::printf("Elapsed:      %.3f s (%.0f hands/s)\n", seconds,
+              seconds > 0 ? stats.handsPlayed / seconds : 0.0);
+  return 0;
+}
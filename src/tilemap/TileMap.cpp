@@ -248,9 +248,26 @@ void TileMap::setTileId(int x, int y, const std::string &layerName,
   int oldTile = layer->getTileId(x, y);
   layer->setTileId(x, y, tileId);
 
-  if (m_OnTileChanged && oldTile != tileId) {
+  if (oldTile == tileId) {
+    return;
+  }
+  if (m_OnTileChanged) {
     m_OnTileChanged(x, y, layerName, oldTile, tileId);
   }
+  for (const auto &[id, listener] : m_TileListeners) {
+    listener(x, y, layerName, oldTile, tileId);
+  }
+}
+
+int TileMap::addTileChangedListener(TileChangedCallback callback) {
+  int id = m_NextListenerId++;
+  m_TileListeners.emplace_back(id, std::move(callback));
+  return id;
+}
+
+void TileMap::removeTileChangedListener(int id) {
+  std::erase_if(m_TileListeners,
+                [id](const auto &listener) { return listener.first == id; });
 }
 
 std::string TileMap::getProperty(int x, int y,
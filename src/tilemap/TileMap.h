@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 class SpriteRenderer;
@@ -151,10 +152,24 @@ public:
   using TileChangedCallback = std::function<void(
       int x, int y, const std::string &layer, int oldTile, int newTile)>;
 
+  /**
+   * Set the map's own tile-changed callback, replacing the previous one.
+   * Listeners added with addTileChangedListener are unaffected.
+   */
   void setOnTileChanged(TileChangedCallback callback) {
     m_OnTileChanged = std::move(callback);
   }
 
+  /**
+   * Add a listener called after every tile edit, after the callback set
+   * with setOnTileChanged. Listeners must not add or remove listeners
+   * while being called.
+   * @return Id for removeTileChangedListener
+   */
+  int addTileChangedListener(TileChangedCallback callback);
+
+  void removeTileChangedListener(int id);
+
 private:
   friend class TiledParser;
 
@@ -179,4 +194,6 @@ private:
   Color m_GlobalTint = Color::White;
 
   TileChangedCallback m_OnTileChanged;
+  std::vector<std::pair<int, TileChangedCallback>> m_TileListeners;
+  int m_NextListenerId = 1;
 };
@@ -0,0 +1,57 @@
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include "sim/CampaignSim.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace sim;
+
+TEST_CASE("CampaignSim plays deterministic campaigns", "[sim]") {
+  gameplay::EffectFactory::registerBuiltInEffects();
+
+  // No jokers or bosses on disk: plain cribbage scoring only
+  CampaignSim::Content content;
+  CampaignSim simulator(content, {});
+
+  for (auto name : Strategy::Names()) {
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+      RunRecord a = simulator.run(name, seed);
+      RunRecord b = simulator.run(name, seed);
+
+      REQUIRE(a.strategy == name);
+      REQUIRE(a.outcome == b.outcome);
+      REQUIRE(a.handsPlayed == b.handsPlayed);
+      REQUIRE(a.finalScore == b.finalScore);
+      REQUIRE(a.bossesFaced == b.bossesFaced);
+
+      REQUIRE((a.outcome == "win" || a.outcome == "loss"));
+      REQUIRE(a.handsPlayed > 0);
+      REQUIRE(a.handsPlayed <= 9 * 4);
+      REQUIRE(a.discardsUsed <= 9 * 3);
+      REQUIRE(a.handScores.size() == static_cast<size_t>(a.handsPlayed));
+      REQUIRE(a.bestHandScore >= a.handScores.back().score);
+      REQUIRE(a.goldSpent == 0); // Empty shop
+    }
+  }
+}
+
+TEST_CASE("RunRecord JSON uses qa_results field names", "[sim]") {
+  CampaignSim::Content content;
+  CampaignSim simulator(content, {1.0f, true});
+  RunRecord record = simulator.run("Greedy", 7);
+  nlohmann::json json = record.toJSON();
+
+  for (const char *key :
+       {"runId", "strategy", "outcome", "actReached", "blindReached",
+        "finalScore", "handsPlayed", "handScores", "cribScores",
+        "bestHandScore", "worstHandScore", "averageHandScore",
+        "jokersAcquired", "bossesFaced", "decisions"}) {
+    REQUIRE(json.contains(key));
+  }
+  REQUIRE(json["handScores"].size() == record.handScores.size());
+  REQUIRE_FALSE(json["decisions"].empty());
+  REQUIRE(json["decisions"][0]["type"] == "crib_selection");
+}
+
+TEST_CASE("Strategy::Create rejects unknown names", "[sim]") {
+  REQUIRE(Strategy::Create("Greedy", 1) != nullptr);
+  REQUIRE_THROWS(Strategy::Create("NotAStrategy", 1));
+}
@@ -0,0 +1,92 @@
+#include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/CompiledRuleSet.h"
+#include "gameplay/cribbage/ScoreTable.h"
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+using namespace gameplay;
+
+TEST_CASE("CompiledRuleSet parsing", "[cribbage][scoring]") {
+  SECTION("Empty by default") {
+    CompiledRuleSet rules;
+    REQUIRE(rules.empty());
+    REQUIRE(rules.warps().empty());
+    REQUIRE_FALSE(rules.has(RuleType::FlushDisabled));
+  }
+
+  SECTION("only_pairs_runs implies the other disablers") {
+    std::vector<std::string> names = {"only_pairs_runs"};
+    CompiledRuleSet rules(names);
+    REQUIRE(rules.has(RuleType::OnlyPairsRuns));
+    REQUIRE(rules.has(RuleType::FifteensDisabled));
+    REQUIRE(rules.has(RuleType::FlushDisabled));
+    REQUIRE(rules.has(RuleType::NobsDisabled));
+    REQUIRE_FALSE(rules.has(RuleType::PairsDisabled));
+  }
+
+  SECTION("Unknown and duplicate rules are ignored") {
+    std::vector<std::string> names = {"warp_blaze", "not_a_rule",
+                                      "warp_blaze", "jokers_disabled"};
+    CompiledRuleSet rules(names);
+    REQUIRE(rules.has(RuleType::WarpBlaze));
+    REQUIRE_FALSE(rules.has(RuleType::Unknown));
+    REQUIRE(rules.warps().size() == 1);
+    REQUIRE(rules.warps()[0] ==
+            CompiledRuleSet::WarpFor(RuleType::WarpBlaze));
+  }
+
+  SECTION("Only warps get warp functions") {
+    REQUIRE(CompiledRuleSet::WarpFor(RuleType::FlushDisabled) == nullptr);
+    REQUIRE(CompiledRuleSet::WarpFor(RuleType::WarpMirror) != nullptr);
+  }
+}
+
+TEST_CASE("CompiledRuleSet scoring", "[cribbage][scoring]") {
+  EffectFactory::registerBuiltInEffects();
+  auto &factory = EffectFactory::getInstance();
+
+  // Warps run in listed order: Blaze then Inversion keeps the bonus,
+  // Inversion then Blaze recomputes base chips and drops it
+  const std::vector<std::vector<std::string>> ruleSets = {
+      {"warp_blaze", "warp_inversion"},
+      {"warp_inversion", "warp_blaze"},
+      {"pairs_disabled", "warp_mirror", "warp_wildfire"},
+      {"multipliers_disabled", "runs_disabled"}};
+
+  Deck deck(2024);
+  for (int i = 0; i < 300; ++i) {
+    deck.reset();
+    deck.shuffle();
+    std::vector<Card> cards = deck.drawMultiple(5);
+    std::span<const Card> hand(cards.data(), 4);
+    auto counts = ScoreTable::Lookup(hand, cards[4]);
+
+    for (const auto &names : ruleSets) {
+      CompiledRuleSet rules(names);
+      auto actual =
+          ScoringEngine::CalculateScore(counts, cards, 1.0f, 0.5f, rules);
+
+      // Reference: score without warps, then apply factory effects in order
+      std::vector<std::string> plain;
+      for (const auto &name : names) {
+        if (name.rfind("warp_", 0) != 0) {
+          plain.push_back(name);
+        }
+      }
+      auto expected =
+          ScoringEngine::CalculateScore(counts, cards, 1.0f, 0.5f, plain);
+      for (const auto &name : names) {
+        if (auto effect = factory.create(RuleRegistry::fromString(name))) {
+          effect->apply(expected, counts, cards);
+        }
+      }
+
+      REQUIRE(actual.baseChips == expected.baseChips);
+      REQUIRE(actual.fifteenChips == expected.fifteenChips);
+      REQUIRE(actual.pairChips == expected.pairChips);
+      REQUIRE(actual.runChips == expected.runChips);
+    }
+  }
+}
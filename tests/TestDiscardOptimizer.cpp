@@ -0,0 +1,70 @@
+#include "gameplay/cribbage/DiscardOptimizer.h"
+#include "gameplay/cribbage/HandEvaluator.h"
+#include "gameplay/cribbage/ScoringEngine.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace gameplay;
+
+TEST_CASE("DiscardOptimizer", "[cribbage][discard]") {
+  using R = Card::Rank;
+  using S = Card::Suit;
+
+  // 5-5-5-J kept with the two low spares discarded is the obvious play
+  std::vector<Card> hand = {Card(R::Two, S::Clubs),    Card(R::Five, S::Hearts),
+                            Card(R::Five, S::Diamonds), Card(R::Nine, S::Clubs),
+                            Card(R::Five, S::Clubs),    Card(R::Jack, S::Spades)};
+
+  SECTION("Evaluates all 15 discards over 46 cuts") {
+    DiscardOptimizer::Options options;
+    auto results = DiscardOptimizer::Evaluate(hand, options);
+
+    REQUIRE(results.size() == 15);
+    REQUIRE(results[0].discard == std::array<int, 2>{0, 1});
+    REQUIRE(results[14].discard == std::array<int, 2>{4, 5});
+
+    for (const auto &stats : results) {
+      REQUIRE(stats.minScore <= stats.expected);
+      REQUIRE(stats.expected <= stats.maxScore);
+    }
+  }
+
+  SECTION("Best discard keeps the three fives and the Jack") {
+    DiscardOptimizer::Options options;
+    auto best = DiscardOptimizer::Best(hand, options);
+    REQUIRE(best.discard == std::array<int, 2>{0, 3});
+  }
+
+  SECTION("Stats match brute force through HandEvaluator") {
+    DiscardOptimizer::Options options;
+    options.bossRules = {"flush_disabled"};
+    options.cutPool = {Card(R::Five, S::Spades), Card(R::King, S::Hearts),
+                       Card(R::Ace, S::Diamonds)};
+
+    auto results = DiscardOptimizer::Evaluate(hand, options);
+    const auto &stats = results[0]; // Discard 2♣ and 5♥
+
+    std::vector<Card> keep = {hand[2], hand[3], hand[4], hand[5]};
+    int total = 0;
+    int minScore = 1 << 30;
+    int maxScore = -1;
+    for (const Card &cut : options.cutPool) {
+      int score = ScoringEngine::CalculateScore(
+                      HandEvaluator::Evaluate(keep, cut), 0.0f, 0.0f,
+                      options.bossRules)
+                      .finalScore;
+      total += score;
+      minScore = std::min(minScore, score);
+      maxScore = std::max(maxScore, score);
+    }
+
+    REQUIRE(stats.expected == total / 3.0);
+    REQUIRE(stats.minScore == minScore);
+    REQUIRE(stats.maxScore == maxScore);
+  }
+
+  SECTION("Rejects hands that are not 6 cards") {
+    DiscardOptimizer::Options options;
+    std::vector<Card> five(hand.begin(), hand.begin() + 5);
+    REQUIRE_THROWS(DiscardOptimizer::Evaluate(five, options));
+  }
+}
@@ -0,0 +1,83 @@
+#include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/FastHandEvaluator.h"
+#include "gameplay/cribbage/HandEvaluator.h"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace gameplay;
+
+static Card C(Card::Rank rank, Card::Suit suit) { return Card(rank, suit); }
+
+TEST_CASE("FastHandEvaluator", "[cribbage][evaluator]") {
+  using R = Card::Rank;
+  using S = Card::Suit;
+
+  SECTION("Perfect 29 hand") {
+    std::vector<Card> hand = {C(R::Five, S::Hearts), C(R::Five, S::Diamonds),
+                              C(R::Five, S::Clubs), C(R::Jack, S::Spades)};
+    Card cut = C(R::Five, S::Spades);
+
+    auto result = FastHandEvaluator::Evaluate(hand, cut);
+    REQUIRE(result.fifteenCount == 8);
+    REQUIRE(result.pairCount == 6);
+    REQUIRE(result.runCount == 0);
+    REQUIRE(result.hasNobs);
+    REQUIRE(result.flushCount == 0);
+  }
+
+  SECTION("Double run with duplicates (3-3-4-5)") {
+    std::vector<Card> hand = {C(R::Three, S::Hearts), C(R::Three, S::Spades),
+                              C(R::Four, S::Clubs), C(R::Five, S::Hearts)};
+    Card cut = C(R::King, S::Diamonds);
+
+    auto result = FastHandEvaluator::Evaluate(hand, cut);
+    REQUIRE(result.runCount == 2);
+    REQUIRE(result.runLength == 3);
+    REQUIRE(result.CardsInRuns() == 6);
+    REQUIRE(result.pairCount == 1);
+  }
+
+  SECTION("Five-card run and flush") {
+    std::vector<Card> hand = {C(R::Nine, S::Clubs), C(R::Seven, S::Clubs),
+                              C(R::Eight, S::Clubs), C(R::Jack, S::Clubs)};
+    Card cut = C(R::Ten, S::Clubs);
+
+    auto result = FastHandEvaluator::Evaluate(hand, cut);
+    REQUIRE(result.runCount == 1);
+    REQUIRE(result.runLength == 5);
+    REQUIRE(result.flushCount == 5);
+    REQUIRE(result.hasNobs); // J♣ matches the cut suit
+  }
+
+  SECTION("Rejects hands of more than 4 cards") {
+    std::vector<Card> hand = {C(R::Two, S::Hearts), C(R::Three, S::Hearts),
+                              C(R::Four, S::Hearts), C(R::Five, S::Hearts),
+                              C(R::Six, S::Hearts)};
+    Card cut = C(R::Seven, S::Hearts);
+
+    REQUIRE_THROWS_AS(FastHandEvaluator::Evaluate(hand, cut),
+                      std::invalid_argument);
+    std::span<const Card> four(hand.data(), 4);
+    REQUIRE(FastHandEvaluator::Evaluate(four, cut).runLength == 4);
+  }
+
+  SECTION("Adapter matches HandEvaluator on seeded random hands") {
+    Deck deck(12345);
+    for (int i = 0; i < 2000; ++i) {
+      deck.reset();
+      deck.shuffle();
+      std::vector<Card> hand = deck.drawMultiple(4);
+      Card cut = deck.draw();
+
+      auto expected = HandEvaluator::Evaluate(hand, cut);
+      auto actual = FastHandEvaluator::Evaluate(hand, cut).ToHandResult();
+
+      REQUIRE(actual.fifteens == expected.fifteens);
+      REQUIRE(actual.pairs == expected.pairs);
+      REQUIRE(actual.runs == expected.runs);
+      REQUIRE(actual.flushCount == expected.flushCount);
+      REQUIRE(actual.hasNobs == expected.hasNobs);
+      REQUIRE(actual.cards == expected.cards);
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include "gameplay/card/Deck.h"
+#include "gameplay/joker/JokerProgram.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace gameplay;
+
+static Joker MakeJoker(const std::string &conditions,
+                       const std::string &effects,
+                       const std::string &extra = "") {
+  return Joker::FromJSONString(
+      R"({"id": "t", "name": "T", "rarity": "common",
+          "triggers": ["on_score"], "conditions": )" +
+      conditions + R"(, "effects": )" + effects + extra + "}");
+}
+
+TEST_CASE("CompiledJoker matches interpreted evaluation", "[joker][program]") {
+  std::vector<Joker> jokers = {
+      MakeJoker(R"(["count_15s > 0"])",
+                R"([{"type": "add_chips", "value": 7, "per": "each_15"}])"),
+      MakeJoker(R"(["count_pairs >= 2", "flush_count < 4"])",
+                R"([{"type": "add_multiplier", "value": 0.5,
+                     "per": "each_pair"}])"),
+      MakeJoker(R"(["unique_categories >= 2"])",
+                R"([{"type": "add_permanent_multiplier", "value": 0.25,
+                     "per": "cards_in_runs"}])",
+                R"(, "ignores_caps": true)"),
+      MakeJoker(R"(["contains_rank:A"])",
+                R"([{"type": "add_chips", "value": 3, "per": "each_A"},
+                    {"type": "add_chips", "value": 1.5, "per": "each_H"}])"),
+      MakeJoker(R"(["contains_suit:S", "count_runs != 0"])",
+                R"([{"type": "add_temp_mult", "value": 1,
+                     "per": "each_run"}])"),
+      MakeJoker(R"(["has_nobs"])",
+                R"([{"type": "add_chips", "value": 11}])"),
+      MakeJoker(R"(["hand_total_21"])",
+                R"([{"type": "add_multiplier", "value": 2,
+                     "per": "each_face"}])"),
+      MakeJoker(R"(["hand_total == 21"])",
+                R"([{"type": "add_chips", "value": 2, "per": "each_even"},
+                    {"type": "add_chips", "value": 2, "per": "each_odd"},
+                    {"type": "add_gold", "value": 5}])"),
+      MakeJoker(R"([])", R"([{"type": "add_chips", "value": 4,
+                               "per": "card_count"}])",
+                R"(, "tiers": [
+                      {"level": 1, "effects": [{"type": "add_chips",
+                                                "value": 10}]},
+                      {"level": 3, "effects": [{"type": "add_multiplier",
+                                                "value": 1,
+                                                "per": "each_15"}]}])"),
+  };
+
+  std::vector<CompiledJoker> compiled;
+  for (const auto &joker : jokers) {
+    compiled.push_back(CompiledJoker::Compile(joker));
+  }
+
+  Deck deck(1234);
+  for (int trial = 0; trial < 500; ++trial) {
+    deck.reset();
+    deck.shuffle();
+    std::vector<Card> hand = deck.drawMultiple(4);
+    Card cut = deck.draw();
+    auto handResult = HandEvaluator::Evaluate(hand, cut);
+    HandFacts facts = HandFacts::From(handResult);
+
+    for (size_t j = 0; j < jokers.size(); ++j) {
+      for (int stacks = 0; stacks <= 6; ++stacks) {
+        // ApplyJokersWithStacks interprets the definition string by string
+        auto expected = JokerEffectSystem::ApplyJokersWithStacks(
+            {{jokers[j], stacks}}, handResult, "on_score");
+        JokerEffectSystem::EffectResult actual;
+        compiled[j].apply(facts, stacks, actual);
+
+        REQUIRE(actual.addedChips == expected.addedChips);
+        REQUIRE(actual.addedTempMult == expected.addedTempMult);
+        REQUIRE(actual.addedPermMult == expected.addedPermMult);
+        REQUIRE(actual.ignoresCaps == expected.ignoresCaps);
+      }
+    }
+  }
+}
+
+TEST_CASE("CompiledJoker triggers", "[joker][program]") {
+  Joker joker = MakeJoker("[]", R"([{"type": "add_chips", "value": 5}])");
+  CompiledJoker compiled = CompiledJoker::Compile(joker);
+
+  REQUIRE(compiled.triggersOn(CompiledJoker::TriggerMask("on_score")));
+  REQUIRE_FALSE(compiled.triggersOn(CompiledJoker::TriggerMask("on_shop")));
+  REQUIRE(CompiledJoker::TriggerMask("not_a_trigger") == 0);
+
+  HandEvaluator::HandResult hand;
+  std::vector<std::pair<const CompiledJoker *, int>> program = {
+      {&compiled, 3}};
+  REQUIRE(JokerEffectSystem::ApplyCompiled(program, hand, "on_score")
+              .addedChips == 15);
+  REQUIRE(JokerEffectSystem::ApplyCompiled(program, hand, "on_discard")
+              .addedChips == 0);
+}
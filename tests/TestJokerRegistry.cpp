@@ -0,0 +1,102 @@
+#include "gameplay/joker/JokerEffectSystem.h"
+#include "gameplay/joker/JokerProgram.h"
+#include "gameplay/joker/JokerRegistry.h"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace gameplay;
+namespace fs = std::filesystem;
+
+static void WriteJoker(const fs::path &path, const std::string &id,
+                       int chips) {
+  std::ofstream out(path);
+  out << R"({"id": ")" << id << R"(", "name": "Test", "rarity": "common",)"
+      << R"("triggers": ["on_score"],)"
+      << R"("effects": [{"type": "add_chips", "value": )" << chips
+      << "}]}";
+}
+
+TEST_CASE("JokerRegistry", "[joker][registry]") {
+  fs::path dir = fs::temp_directory_path() / "magic_hands_joker_registry";
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  WriteJoker(dir / "alpha.json", "alpha", 10);
+  WriteJoker(dir / "beta.json", "beta", 20);
+  std::ofstream(dir / "broken.json") << "{ not json";
+
+  JokerRegistry &registry = JokerRegistry::getInstance();
+  registry.clear();
+
+  SECTION("Loads a directory once and interns by path and id") {
+    REQUIRE(registry.loadDirectory(dir.string()) == 2);
+    REQUIRE(registry.size() == 2);
+
+    int alpha = registry.find((dir / "alpha.json").string());
+    REQUIRE(registry.isValid(alpha));
+    REQUIRE(registry.get(alpha).id == "alpha");
+    REQUIRE(registry.findById("beta") != JokerRegistry::kInvalidHandle);
+
+    // Re-interning the same file (even via a non-normal path) is a lookup
+    REQUIRE(registry.intern((dir / "." / "alpha.json").string()) == alpha);
+    REQUIRE(registry.size() == 2);
+  }
+
+  SECTION("Unknown or invalid files are rejected") {
+    REQUIRE(registry.find("missing.json") == JokerRegistry::kInvalidHandle);
+    REQUIRE_THROWS(registry.intern((dir / "missing.json").string()));
+    REQUIRE_THROWS(registry.intern((dir / "broken.json").string()));
+    REQUIRE(registry.size() == 0);
+  }
+
+  SECTION("Reload keeps handles and picks up edits") {
+    int alpha = registry.intern((dir / "alpha.json").string());
+    WriteJoker(dir / "alpha.json", "alpha", 99);
+    REQUIRE(registry.get(alpha).effects[0].value == 10.0f);
+
+    REQUIRE(registry.reload() == 1);
+    REQUIRE(registry.find((dir / "alpha.json").string()) == alpha);
+    REQUIRE(registry.get(alpha).effects[0].value == 99.0f);
+
+    // A broken edit keeps the previous definition
+    std::ofstream(dir / "alpha.json") << "{ not json";
+    REQUIRE(registry.reload() == 0);
+    REQUIRE(registry.get(alpha).effects[0].value == 99.0f);
+  }
+
+  SECTION("Compiled registry jokers score like parsed jokers") {
+    int alpha = registry.intern((dir / "alpha.json").string());
+    int beta = registry.intern((dir / "beta.json").string());
+
+    HandEvaluator::HandResult hand;
+    std::vector<std::pair<const CompiledJoker *, int>> program = {
+        {&registry.getCompiled(alpha), 2}, {&registry.getCompiled(beta), 1}};
+    auto compiled = JokerEffectSystem::ApplyCompiled(program, hand, "on_score");
+    auto parsed = JokerEffectSystem::ApplyJokersWithStacks(
+        {{registry.get(alpha), 2}, {registry.get(beta), 1}}, hand, "on_score");
+
+    REQUIRE(compiled.addedChips == 40);
+    REQUIRE(parsed.addedChips == compiled.addedChips);
+  }
+
+  SECTION("Interning more jokers keeps earlier references valid") {
+    int alpha = registry.intern((dir / "alpha.json").string());
+    const Joker *joker = &registry.get(alpha);
+    const CompiledJoker *compiled = &registry.getCompiled(alpha);
+
+    // Far past any initial capacity of the entry storage
+    for (int i = 0; i < 200; ++i) {
+      std::string id = "extra" + std::to_string(i);
+      WriteJoker(dir / (id + ".json"), id, i);
+      registry.intern((dir / (id + ".json")).string());
+    }
+    REQUIRE(registry.size() == 201);
+    REQUIRE(&registry.get(alpha) == joker);
+    REQUIRE(&registry.getCompiled(alpha) == compiled);
+    REQUIRE(joker->id == "alpha");
+  }
+
+  registry.clear();
+  fs::remove_all(dir);
+}
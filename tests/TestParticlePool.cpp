@@ -0,0 +1,177 @@
+#include "core/ParallelFor.h"
+#include "graphics/ParticlePool.h"
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cmath>
+
+using Column = ParticlePool::Column;
+
+TEST_CASE("ParticlePool keeps live particles packed", "[graphics][particles]") {
+  EmitterConfig config;
+  config.minLife = 1.0f;
+  config.maxLife = 3.0f;
+  ParticleRng rng(5);
+
+  ParticlePool pool(100);
+  REQUIRE(pool.emit(config, 60, rng) == 60);
+  REQUIRE(pool.emit(config, 60, rng) == 40); // Pool full
+  REQUIRE(pool.size() == 100);
+
+  int expected = 0;
+  const float *life = pool.column(Column::Life);
+  for (int i = 0; i < pool.size(); ++i) {
+    expected += life[i] > 1.5f;
+  }
+
+  pool.update(config, 1.5f);
+  REQUIRE(pool.size() == expected);
+  life = pool.column(Column::Life);
+  for (int i = 0; i < pool.size(); ++i) {
+    REQUIRE(life[i] > 0.0f);
+  }
+
+  // Freed slots are reused
+  REQUIRE(pool.emit(config, 1000, rng) == 100 - expected);
+  pool.update(config, 10.0f);
+  REQUIRE(pool.empty());
+}
+
+TEST_CASE("ParticlePool integrates and interpolates over lifetime",
+          "[graphics][particles]") {
+  EmitterConfig config;
+  config.x = 10.0f;
+  config.y = 20.0f;
+  config.minSpeed = config.maxSpeed = 100.0f;
+  config.direction = 0.0f; // Right
+  config.spread = 0.0f;
+  config.gravityY = 50.0f;
+  config.minLife = config.maxLife = 2.0f;
+  config.startSize = 4.0f;
+  config.endSize = 12.0f;
+  config.a = 1.0f;
+  config.endA = 0.0f;
+  ParticleRng rng(5);
+
+  ParticlePool pool(16);
+  pool.emit(config, 3, rng);
+  pool.update(config, 0.5f);
+  REQUIRE(pool.size() == 3);
+
+  for (int i = 0; i < pool.size(); ++i) {
+    REQUIRE(pool.column(Column::VelY)[i] == Catch::Approx(25.0f));
+    REQUIRE(pool.column(Column::X)[i] == Catch::Approx(60.0f));
+    REQUIRE(pool.column(Column::Y)[i] == Catch::Approx(32.5f));
+    REQUIRE(pool.column(Column::Size)[i] == Catch::Approx(6.0f));
+    REQUIRE(pool.column(Column::A)[i] == Catch::Approx(0.75f));
+  }
+
+  // Without colour interpolation the start colour stays
+  config.colorInterpolation = false;
+  pool.update(config, 0.5f);
+  REQUIRE(pool.column(Column::Size)[0] == Catch::Approx(8.0f));
+  REQUIRE(pool.column(Column::A)[0] == Catch::Approx(0.75f));
+}
+
+TEST_CASE("ParticlePool advances disjoint chunks like one update",
+          "[graphics][particles]") {
+  EmitterConfig config;
+  config.spread = 360.0f;
+  config.gravityY = 100.0f;
+  config.minLife = 0.1f;
+  config.maxLife = 1.0f;
+  config.endSize = 10.0f;
+  config.sizeVariation = 2.0f;
+
+  ParticlePool serial(1000);
+  ParticleRng serialRng(9);
+  serial.emit(config, 997, serialRng);
+  ParticlePool chunked(1000);
+  ParticleRng chunkedRng(9);
+  chunked.emit(config, 997, chunkedRng);
+
+  constexpr int kChunk = 4 * ParticlePool::kBlock;
+  for (int frame = 0; frame < 20; ++frame) {
+    serial.update(config, 0.05f);
+
+    size_t chunks = (chunked.size() + kChunk - 1) / kChunk;
+    ParallelFor(chunks, 4, 1, [&](int, size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        int first = static_cast<int>(i) * kChunk;
+        chunked.advance(config, 0.05f, first,
+                        std::min(first + kChunk, chunked.size()));
+      }
+    });
+    chunked.removeExpired();
+
+    REQUIRE(chunked.size() == serial.size());
+    for (int c = 0; c < static_cast<int>(Column::Count); ++c) {
+      const float *expected = serial.column(static_cast<Column>(c));
+      const float *actual = chunked.column(static_cast<Column>(c));
+      REQUIRE(std::equal(expected, expected + serial.size(), actual));
+    }
+  }
+  REQUIRE(serial.empty());
+}
+
+TEST_CASE("ParticlePool bursts initialize the new block only",
+          "[graphics][particles]") {
+  EmitterConfig config;
+  config.x = 100.0f;
+  config.width = 40.0f;
+  config.minSpeed = 10.0f;
+  config.maxSpeed = 20.0f;
+  config.minLife = config.maxLife = 5.0f;
+  config.sizeVariation = 1.0f;
+  config.r = 0.25f;
+  config.endA = 0.5f;
+  ParticleRng rng(7, 3);
+
+  ParticlePool pool(1000);
+  REQUIRE(pool.emit(config, 10, rng) == 10);
+  const float firstX = pool.column(Column::X)[0];
+
+  // A large burst lands after the live range
+  REQUIRE(pool.emit(config, 990, rng) == 990);
+  REQUIRE(pool.column(Column::X)[0] == firstX);
+  for (int i = 0; i < pool.size(); ++i) {
+    float x = pool.column(Column::X)[i];
+    REQUIRE(x >= 80.0f);
+    REQUIRE(x < 120.0f);
+    REQUIRE(pool.column(Column::Y)[i] == 0.0f); // Zero height: no scatter
+    float vx = pool.column(Column::VelX)[i];
+    float vy = pool.column(Column::VelY)[i];
+    float speed = std::sqrt(vx * vx + vy * vy);
+    REQUIRE(speed >= 10.0f - 1e-3f);
+    REQUIRE(speed <= 20.0f + 1e-3f);
+    REQUIRE(pool.column(Column::InvMaxLife)[i] == Catch::Approx(0.2f));
+    float size = pool.column(Column::Size)[i];
+    REQUIRE(size >= 3.0f);
+    REQUIRE(size <= 5.0f);
+    REQUIRE(pool.column(Column::StartSize)[i] == size);
+    REQUIRE(pool.column(Column::R)[i] == 0.25f);
+    REQUIRE(pool.column(Column::StartR)[i] == 0.25f);
+    REQUIRE(pool.column(Column::EndA)[i] == 0.5f);
+  }
+}
+
+TEST_CASE("ParticleRng streams are uniform and independent",
+          "[graphics][particles]") {
+  ParticleRng a(42, 0);
+  ParticleRng b(42, 1);
+  ParticleRng same(42, 0);
+
+  int differing = 0;
+  double sum = 0.0;
+  constexpr int kDraws = 10000;
+  for (int i = 0; i < kDraws; ++i) {
+    float value = a.next01();
+    REQUIRE(value >= 0.0f);
+    REQUIRE(value < 1.0f);
+    REQUIRE(same.next01() == value);
+    differing += b.next01() != value;
+    sum += value;
+  }
+  REQUIRE(differing > kDraws * 9 / 10);
+  REQUIRE(sum / kDraws == Catch::Approx(0.5).margin(0.02));
+}
@@ -0,0 +1,745 @@
+#include "pathfinding/Pathfinder.h"
+#include "tilemap/TileMap.h"
+#include <algorithm>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Point = Pathfinder::Point;
+
+namespace {
+
+const std::string kLayer = "nav_ground";
+constexpr int kWall = 1; // Tile ids 2-9 cost their id, empty tiles cost 1
+
+void DefineTiles(TileMap &map) {
+  map.setTileProperty(kWall, "walkable", "false");
+  for (int id = 2; id <= 9; ++id) {
+    map.setTileProperty(id, "cost", std::to_string(id));
+  }
+}
+
+/// '#' wall, '.' empty, '2'-'9' weighted tile
+std::unique_ptr<TileMap> MapFromRows(const std::vector<std::string> &rows) {
+  auto map = std::make_unique<TileMap>(static_cast<int>(rows[0].size()),
+                                       static_cast<int>(rows.size()));
+  DefineTiles(*map);
+  for (int y = 0; y < map->getHeight(); ++y) {
+    for (int x = 0; x < map->getWidth(); ++x) {
+      char c = rows[y][x];
+      map->setTileId(x, y, kLayer, c == '#' ? kWall : c == '.' ? 0 : c - '0');
+    }
+  }
+  return map;
+}
+
+/// Seeded map with wallPercent walls; weighted maps also get costly tiles
+std::unique_ptr<TileMap> RandomMap(int width, int height, uint32_t seed,
+                                   int wallPercent, bool weighted) {
+  auto map = std::make_unique<TileMap>(width, height);
+  DefineTiles(*map);
+  std::mt19937 rng(seed);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int roll = static_cast<int>(rng() % 100);
+      int tile = 0;
+      if (roll < wallPercent) {
+        tile = kWall;
+      } else if (weighted && roll < wallPercent + 15) {
+        tile = 2 + static_cast<int>(rng() % 4);
+      }
+      map->setTileId(x, y, kLayer, tile);
+    }
+  }
+  return map;
+}
+
+float TileCost(const TileMap &map, int x, int y) {
+  if (x < 0 || y < 0 || x >= map.getWidth() || y >= map.getHeight()) {
+    return -1.0f;
+  }
+  int tile = map.getTileId(x, y, kLayer);
+  return tile == kWall ? -1.0f : tile == 0 ? 1.0f : static_cast<float>(tile);
+}
+
+float StepCost(const TileMap &map, const Point &from, const Point &to) {
+  bool diagonal = from.x != to.x && from.y != to.y;
+  return (diagonal ? 1.414f : 1.0f) * TileCost(map, to.x, to.y);
+}
+
+/// Cost of walking a path tile by tile, or -1 if a step is not a move to
+/// a walkable neighbor (diagonal steps only when allowed)
+float WalkCost(const TileMap &map, const Pathfinder::Path &path,
+               bool allowDiagonal) {
+  float cost = 0.0f;
+  for (size_t i = 1; i < path.size(); ++i) {
+    int dx = std::abs(path[i].x - path[i - 1].x);
+    int dy = std::abs(path[i].y - path[i - 1].y);
+    if (dx > 1 || dy > 1 || dx + dy == 0 ||
+        (!allowDiagonal && dx + dy != 1) ||
+        TileCost(map, path[i].x, path[i].y) < 0.0f) {
+      return -1.0f;
+    }
+    cost += StepCost(map, path[i - 1], path[i]);
+  }
+  return cost;
+}
+
+/// Plain Dijkstra over the tile ids with the pathfinder's step costs;
+/// -1 if the goal can't be reached
+float ReferenceCost(const TileMap &map, const Point &start, const Point &end,
+                    bool allowDiagonal) {
+  const int width = map.getWidth();
+  std::vector<float> best(static_cast<size_t>(width) * map.getHeight(),
+                          std::numeric_limits<float>::infinity());
+  using Entry = std::pair<float, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+  best[start.y * width + start.x] = 0.0f;
+  open.push({0.0f, start.y * width + start.x});
+
+  while (!open.empty()) {
+    auto [cost, index] = open.top();
+    open.pop();
+    Point at{index % width, index / width};
+    if (at == end) {
+      return cost;
+    }
+    if (cost > best[index]) {
+      continue;
+    }
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        if ((dx == 0 && dy == 0) || (!allowDiagonal && dx != 0 && dy != 0)) {
+          continue;
+        }
+        Point next{at.x + dx, at.y + dy};
+        if (TileCost(map, next.x, next.y) < 0.0f) {
+          continue;
+        }
+        float nextCost = cost + StepCost(map, at, next);
+        int nextIndex = next.y * width + next.x;
+        if (nextCost < best[nextIndex]) {
+          best[nextIndex] = nextCost;
+          open.push({nextCost, nextIndex});
+        }
+      }
+    }
+  }
+  return -1.0f;
+}
+
+/// Unlimited request (no step or time budget)
+Pathfinder::PathRequest Request(Point start, Point end, bool allowDiagonal,
+                                Pathfinder::Algorithm algorithm =
+                                    Pathfinder::Algorithm::AStar) {
+  Pathfinder::PathRequest request;
+  request.start = start;
+  request.end = end;
+  request.allowDiagonal = allowDiagonal;
+  request.algorithm = algorithm;
+  request.maxSteps = std::numeric_limits<int>::max();
+  request.maxTimeMs = std::numeric_limits<float>::max();
+  return request;
+}
+
+/// Random walkable tile
+Point RandomOpenTile(const TileMap &map, std::mt19937 &rng) {
+  for (;;) {
+    Point p{static_cast<int>(rng() % map.getWidth()),
+            static_cast<int>(rng() % map.getHeight())};
+    if (TileCost(map, p.x, p.y) >= 0.0f) {
+      return p;
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("A* finds least-cost paths on fixed maps", "[pathfinding]") {
+  auto map = MapFromRows({
+      "..........",
+      ".######...",
+      ".#....#.#.",
+      ".#.##.#.#.",
+      ".#..#...#.",
+      ".####9###.",
+      "....5555..",
+      ".########.",
+      "..........",
+  });
+  Pathfinder pathfinder(*map);
+
+  for (bool diagonal : {false, true}) {
+    for (auto [start, end] : {std::pair<Point, Point>{{2, 2}, {9, 8}},
+                              {{0, 0}, {5, 4}},
+                              {{0, 8}, {9, 0}},
+                              {{3, 4}, {7, 2}}}) {
+      auto result = pathfinder.findPath(Request(start, end, diagonal));
+      float expected = ReferenceCost(*map, start, end, diagonal);
+      INFO("diagonal " << diagonal << " from " << start.x << "," << start.y);
+      REQUIRE(result.found);
+      REQUIRE_FALSE(result.partial);
+      REQUIRE(result.path.front() == start);
+      REQUIRE(result.path.back() == end);
+      REQUIRE(WalkCost(*map, result.path, diagonal) ==
+              Catch::Approx(expected).epsilon(1e-4));
+    }
+  }
+
+  // Costly tiles are avoided when a detour is cheaper: five steps around
+  // instead of crossing two cost-9 tiles
+  auto corridor = MapFromRows({
+      ".99.",
+      "....",
+  });
+  Pathfinder corridorPathfinder(*corridor);
+  auto result = corridorPathfinder.findPath(Request({0, 0}, {3, 0}, false));
+  REQUIRE(result.found);
+  REQUIRE(WalkCost(*corridor, result.path, false) == Catch::Approx(5.0f));
+}
+
+TEST_CASE("A* matches Dijkstra on seeded random maps", "[pathfinding]") {
+  for (uint32_t seed = 1; seed <= 4; ++seed) {
+    auto map = RandomMap(48, 40, seed, 25, true);
+    Pathfinder pathfinder(*map);
+    std::mt19937 rng(seed * 31);
+    for (int query = 0; query < 25; ++query) {
+      Point start = RandomOpenTile(*map, rng);
+      Point end = RandomOpenTile(*map, rng);
+      bool diagonal = query % 2 == 1;
+      auto result = pathfinder.findPath(Request(start, end, diagonal));
+      float expected = ReferenceCost(*map, start, end, diagonal);
+
+      REQUIRE(result.found == (expected >= 0.0f));
+      if (result.found) {
+        REQUIRE(WalkCost(*map, result.path, diagonal) ==
+                Catch::Approx(expected).epsilon(1e-4));
+      }
+    }
+  }
+}
+
+TEST_CASE("A* reports unreachable and blocked endpoints", "[pathfinding]") {
+  auto map = MapFromRows({
+      ".....#...",
+      ".....#.#.",
+      ".....#...",
+  });
+  Pathfinder pathfinder(*map);
+
+  SECTION("Unreachable goal exhausts the search without a path") {
+    auto result = pathfinder.findPath(Request({0, 0}, {8, 2}, true));
+    REQUIRE_FALSE(result.found);
+    REQUIRE_FALSE(result.partial);
+    REQUIRE(result.path.empty());
+    REQUIRE(result.nodesExpanded == 15); // Every tile left of the wall
+  }
+
+  SECTION("Blocked start or goal fails before searching") {
+    auto blockedStart = pathfinder.findPath(Request({5, 1}, {0, 0}, false));
+    REQUIRE_FALSE(blockedStart.found);
+    REQUIRE(blockedStart.path.empty());
+    REQUIRE(blockedStart.nodesExpanded == 0);
+    REQUIRE(blockedStart.failure == Pathfinder::Failure::StartBlocked);
+
+    auto blockedGoal = pathfinder.findPath(Request({6, 0}, {7, 1}, true));
+    REQUIRE_FALSE(blockedGoal.found);
+    REQUIRE(blockedGoal.path.empty());
+    REQUIRE(blockedGoal.nodesExpanded == 0);
+    REQUIRE(blockedGoal.failure == Pathfinder::Failure::EndBlocked);
+
+    // Outside the map counts as blocked
+    auto outside = pathfinder.findPath(Request({0, 0}, {-1, 0}, false));
+    REQUIRE_FALSE(outside.found);
+    REQUIRE(outside.nodesExpanded == 0);
+    REQUIRE(outside.failure == Pathfinder::Failure::EndBlocked);
+
+    auto found = pathfinder.findPath(Request({0, 0}, {4, 2}, false));
+    REQUIRE(found.failure == Pathfinder::Failure::None);
+  }
+
+  SECTION("Async requests carry the failure back to pollAsync") {
+    auto ticket = pathfinder.requestAsync(Request({5, 1}, {0, 0}, false));
+    Pathfinder::PathResult result;
+    while (!pathfinder.pollAsync(ticket, result)) {
+      std::this_thread::yield();
+    }
+    REQUIRE_FALSE(result.found);
+    REQUIRE(result.failure == Pathfinder::Failure::StartBlocked);
+  }
+
+  SECTION("Start equal to goal is a one-tile path") {
+    auto result = pathfinder.findPath(Request({2, 1}, {2, 1}, false));
+    REQUIRE(result.found);
+    REQUIRE(result.path == Pathfinder::Path{{2, 1}});
+  }
+}
+
+TEST_CASE("A* returns a partial path when maxSteps runs out",
+          "[pathfinding]") {
+  auto map = RandomMap(64, 64, 7, 0, false);
+  Pathfinder pathfinder(*map);
+
+  auto request = Request({0, 0}, {63, 63}, false);
+  request.maxSteps = 40;
+  auto result = pathfinder.findPath(request);
+
+  REQUIRE_FALSE(result.found);
+  REQUIRE(result.partial);
+  REQUIRE(result.nodesExpanded == request.maxSteps + 1);
+  // Ends at the expanded tile closest to the goal, reached from the start
+  REQUIRE(result.path.size() > 1);
+  REQUIRE(result.path.front() == request.start);
+  REQUIRE(WalkCost(*map, result.path, false) > 0.0f);
+  int remaining = std::abs(63 - result.path.back().x) +
+                  std::abs(63 - result.path.back().y);
+  REQUIRE(remaining < 126);
+
+  // The same request with room to finish is not partial (and a partial
+  // result was not cached in its place)
+  request.maxSteps = std::numeric_limits<int>::max();
+  auto full = pathfinder.findPath(request);
+  REQUIRE(full.found);
+  REQUIRE_FALSE(full.cached);
+  REQUIRE(WalkCost(*map, full.path, false) == Catch::Approx(126.0f));
+}
+
+TEST_CASE("Baked cost grid follows tile edits", "[pathfinding][navgrid]") {
+  auto map = MapFromRows({
+      "....",
+      ".#5.",
+      "....",
+  });
+  Pathfinder pathfinder(*map);
+  map->addTileChangedListener(
+      [&](int x, int y, const std::string &, int, int) {
+        pathfinder.onTileChanged(x, y);
+      });
+
+  REQUIRE(pathfinder.getCost(2, 1, kLayer) == 5.0f);
+  REQUIRE_FALSE(pathfinder.isWalkable(1, 1, kLayer));
+  REQUIRE(pathfinder.getCost(-1, 0, kLayer) == -1.0f);
+
+  map->setTileId(1, 1, kLayer, 0);
+  map->setTileId(2, 1, kLayer, kWall);
+  REQUIRE(pathfinder.getCost(1, 1, kLayer) == 1.0f);
+  REQUIRE_FALSE(pathfinder.isWalkable(2, 1, kLayer));
+
+  SECTION("Listeners are kept alongside each other") {
+    int calls = 0;
+    int listener = map->addTileChangedListener(
+        [&](int, int, const std::string &, int, int) { ++calls; });
+    map->setOnTileChanged([&](int, int, const std::string &, int, int) {
+      ++calls;
+    });
+
+    map->setTileId(0, 0, kLayer, 3);
+    REQUIRE(calls == 2);
+    REQUIRE(pathfinder.getCost(0, 0, kLayer) == 3.0f);
+
+    map->removeTileChangedListener(listener);
+    map->setTileId(0, 0, kLayer, 4);
+    REQUIRE(calls == 3);
+    REQUIRE(pathfinder.getCost(0, 0, kLayer) == 4.0f);
+  }
+}
+
+TEST_CASE("Baked cost grid reuses palette entries", "[pathfinding][navgrid]") {
+  // Tile 100 + i costs 1 + i / 100: more distinct costs than the palette
+  // holds at once
+  auto map = std::make_unique<TileMap>(20, 20);
+  DefineTiles(*map);
+  auto costString = [](int i) { return std::to_string(1.0 + i / 100.0); };
+  auto costOf = [&](int i) { return std::stof(costString(i)); };
+  for (int i = 0; i < 400; ++i) {
+    map->setTileProperty(100 + i, "cost", costString(i));
+  }
+  Pathfinder pathfinder(*map);
+  map->addTileChangedListener(
+      [&](int x, int y, const std::string &, int, int) {
+        pathfinder.onTileChanged(x, y);
+      });
+
+  SECTION("Costs no tile holds any more are freed") {
+    for (int i = 1; i < 400; ++i) {
+      map->setTileId(0, 0, kLayer, 100 + i);
+      REQUIRE(pathfinder.getCost(0, 0, kLayer) == costOf(i));
+    }
+  }
+
+  SECTION("Costs beyond a full palette snap to the nearest") {
+    // Baked in row-major order: cost 1 plus the first 254 new costs fit
+    for (int i = 1; i < 400; ++i) {
+      map->setTileId(i % 20, i / 20, kLayer, 100 + i);
+    }
+    for (int i = 1; i < 400; ++i) {
+      float expected = costOf(std::min(i, 254));
+      REQUIRE(pathfinder.getCost(i % 20, i / 20, kLayer) == expected);
+    }
+  }
+}
+
+TEST_CASE("JPS matches A* on seeded random maps", "[pathfinding][jps]") {
+  using Algorithm = Pathfinder::Algorithm;
+
+  // Wider and taller than 64 tiles so scans cross bit-word boundaries
+  for (uint32_t seed = 1; seed <= 6; ++seed) {
+    auto map = RandomMap(seed % 2 ? 150 : 70, seed % 2 ? 90 : 130, seed,
+                         10 + static_cast<int>(seed) * 5, false);
+    Pathfinder pathfinder(*map);
+    std::mt19937 rng(seed * 17);
+    for (int query = 0; query < 30; ++query) {
+      Point start = RandomOpenTile(*map, rng);
+      Point end = RandomOpenTile(*map, rng);
+
+      for (bool diagonal : {true, false}) {
+        auto astar = pathfinder.findPath(Request(start, end, diagonal));
+        auto jps =
+            pathfinder.findPath(Request(start, end, diagonal, Algorithm::JPS));
+
+        // JPS needs diagonal moves; 4-way requests run as A*
+        REQUIRE(jps.algorithm ==
+                (diagonal ? Algorithm::JPS : Algorithm::AStar));
+        REQUIRE(jps.found == astar.found);
+        if (!jps.found) {
+          REQUIRE(ReferenceCost(*map, start, end, diagonal) < 0.0f);
+          continue;
+        }
+        REQUIRE(jps.path.front() == start);
+        REQUIRE(jps.path.back() == end);
+        REQUIRE(WalkCost(*map, jps.path, diagonal) ==
+                Catch::Approx(WalkCost(*map, astar.path, diagonal))
+                    .epsilon(1e-4));
+      }
+    }
+  }
+}
+
+TEST_CASE("JPS runs only on uniform-cost layers", "[pathfinding][jps]") {
+  using Algorithm = Pathfinder::Algorithm;
+
+  SECTION("Uniform cost other than 1") {
+    auto map = MapFromRows({
+        "3333333333",
+        "33#####333",
+        "3333#33333",
+        "33#3#3#333",
+        "3333333333",
+    });
+    Pathfinder pathfinder(*map);
+    auto jps =
+        pathfinder.findPath(Request({0, 2}, {9, 1}, true, Algorithm::JPS));
+    REQUIRE(jps.algorithm == Algorithm::JPS);
+    REQUIRE(WalkCost(*map, jps.path, true) ==
+            Catch::Approx(ReferenceCost(*map, {0, 2}, {9, 1}, true))
+                .epsilon(1e-4));
+  }
+
+  SECTION("Weighted layer falls back to A*") {
+    auto map = RandomMap(40, 40, 99, 20, true);
+    Pathfinder pathfinder(*map);
+    std::mt19937 rng(5);
+    Point start = RandomOpenTile(*map, rng);
+    Point end = RandomOpenTile(*map, rng);
+    auto result =
+        pathfinder.findPath(Request(start, end, true, Algorithm::JPS));
+    REQUIRE(result.algorithm == Algorithm::AStar);
+    REQUIRE(result.found == (ReferenceCost(*map, start, end, true) >= 0.0f));
+  }
+}
+
+TEST_CASE("HPA paths are walkable and near A* cost", "[pathfinding][hpa]") {
+  using Algorithm = Pathfinder::Algorithm;
+
+  // Stated bound: no HPA path costs more than 1.5x the A* path, and on
+  // average they cost at most 10% more (measured: 1.31x worst, 3% mean)
+  constexpr float kMaxRatio = 1.5f;
+  constexpr float kMaxMeanRatio = 1.1f;
+
+  float ratioSum = 0.0f;
+  int compared = 0;
+  for (uint32_t seed = 1; seed <= 8; ++seed) {
+    auto map = RandomMap(96, 80, seed, 10 + static_cast<int>(seed % 4) * 5,
+                         seed % 2 == 0);
+    Pathfinder pathfinder(*map);
+    std::mt19937 rng(seed * 7);
+    for (int query = 0; query < 30; ++query) {
+      Point start = RandomOpenTile(*map, rng);
+      Point end = RandomOpenTile(*map, rng);
+      for (bool diagonal : {false, true}) {
+        auto astar = pathfinder.findPath(Request(start, end, diagonal));
+        auto hpa =
+            pathfinder.findPath(Request(start, end, diagonal, Algorithm::HPA));
+
+        REQUIRE(hpa.found == astar.found);
+        if (!hpa.found) {
+          continue;
+        }
+        REQUIRE(hpa.path.front() == start);
+        REQUIRE(hpa.path.back() == end);
+        float hpaCost = WalkCost(*map, hpa.path, diagonal);
+        REQUIRE(hpaCost >= 0.0f);
+        if (hpa.algorithm != Algorithm::HPA) {
+          continue; // Short query, answered by A*
+        }
+
+        float ratio = hpaCost / WalkCost(*map, astar.path, diagonal);
+        REQUIRE(ratio >= 1.0f - 1e-4f);
+        REQUIRE(ratio <= kMaxRatio);
+        ratioSum += ratio;
+        compared++;
+      }
+    }
+  }
+  REQUIRE(compared > 100);
+  REQUIRE(ratioSum / compared <= kMaxMeanRatio);
+}
+
+TEST_CASE("HPA cluster graph updated after edits matches a fresh one",
+          "[pathfinding][hpa]") {
+  using Algorithm = Pathfinder::Algorithm;
+
+  auto map = RandomMap(80, 72, 21, 20, true);
+  Pathfinder incremental(*map);
+  incremental.setPathCacheCapacity(0); // Compare searches, not the cache
+  map->addTileChangedListener(
+      [&](int x, int y, const std::string &, int, int) {
+        incremental.onTileChanged(x, y);
+      });
+
+  std::mt19937 rng(77);
+  const Point corner{0, 0};
+  const Point farCorner{79, 71};
+  auto query = [&](Pathfinder &pathfinder, Point start, Point end,
+                   bool diagonal) {
+    return pathfinder.findPath(Request(start, end, diagonal, Algorithm::HPA));
+  };
+
+  for (int round = 0; round < 6; ++round) {
+    // Build or update the graphs, then edit: walls, openings and costs,
+    // many of them on cluster borders
+    map->setTileId(corner.x, corner.y, kLayer, 0);
+    map->setTileId(farCorner.x, farCorner.y, kLayer, 0);
+    for (bool diagonal : {false, true}) {
+      query(incremental, corner, farCorner, diagonal);
+    }
+    for (int edit = 0; edit < 60; ++edit) {
+      int x = static_cast<int>(rng() % 80);
+      int y = static_cast<int>(rng() % 72);
+      if (edit % 2 == 0) {
+        (rng() % 2 ? x : y) = Pathfinder::kClusterSize *
+                                  (1 + static_cast<int>(rng() % 4)) -
+                              static_cast<int>(rng() % 2);
+      }
+      int tiles[] = {0, kWall, 3, 7};
+      map->setTileId(x, y, kLayer, tiles[rng() % 4]);
+    }
+
+    Pathfinder fresh(*map);
+    for (int i = 0; i < 20; ++i) {
+      Point start = RandomOpenTile(*map, rng);
+      Point end = RandomOpenTile(*map, rng);
+      bool diagonal = i % 2 == 1;
+      auto updated = query(incremental, start, end, diagonal);
+      auto rebuilt = query(fresh, start, end, diagonal);
+      REQUIRE(updated.found == rebuilt.found);
+      REQUIRE(updated.algorithm == rebuilt.algorithm);
+      REQUIRE(updated.path == rebuilt.path);
+      if (updated.found) {
+        REQUIRE(WalkCost(*map, updated.path, diagonal) >= 0.0f);
+      }
+    }
+  }
+}
+
+TEST_CASE("Flow field distances match A* costs", "[pathfinding][flowfield]") {
+  for (uint32_t seed = 1; seed <= 4; ++seed) {
+    auto map = RandomMap(60, 45, seed, 15 + static_cast<int>(seed) * 5,
+                         seed % 2 == 1);
+    Pathfinder pathfinder(*map);
+    std::mt19937 rng(seed * 13);
+    for (bool diagonal : {true, false}) {
+      Point goal = RandomOpenTile(*map, rng);
+      auto field = pathfinder.getFlowField(goal, kLayer, diagonal);
+      REQUIRE(field->getGoal() == goal);
+      REQUIRE(field->distance(goal.x, goal.y) == 0.0f);
+      REQUIRE(field->direction(goal.x, goal.y) == Point{0, 0});
+
+      for (int sample = 0; sample < 40; ++sample) {
+        Point from = RandomOpenTile(*map, rng);
+        auto astar = pathfinder.findPath(Request(from, goal, diagonal));
+        REQUIRE(field->reachable(from.x, from.y) == astar.found);
+        if (!astar.found) {
+          REQUIRE(field->direction(from.x, from.y) == Point{0, 0});
+          continue;
+        }
+        float cost = WalkCost(*map, astar.path, diagonal);
+        REQUIRE(field->distance(from.x, from.y) ==
+                Catch::Approx(cost).epsilon(1e-4));
+
+        // Following the directions walks a least-cost path to the goal
+        Pathfinder::Path walk{from};
+        while (walk.back() != goal && walk.size() <= astar.path.size() * 2) {
+          Point step = field->direction(walk.back().x, walk.back().y);
+          walk.push_back({walk.back().x + step.x, walk.back().y + step.y});
+        }
+        REQUIRE(walk.back() == goal);
+        REQUIRE(WalkCost(*map, walk, diagonal) ==
+                Catch::Approx(cost).epsilon(1e-4));
+      }
+
+      // Walls and tiles off the map can't reach anything
+      REQUIRE(field->distance(-1, 0) == -1.0f);
+      REQUIRE_FALSE(field->reachable(map->getWidth(), 0));
+    }
+  }
+}
+
+TEST_CASE("Flow fields go stale when an edit can change them",
+          "[pathfinding][flowfield]") {
+  auto map = MapFromRows({
+      "....#...",
+      "....#...",
+      "....#...",
+  });
+  Pathfinder pathfinder(*map);
+  map->addTileChangedListener(
+      [&](int x, int y, const std::string &, int, int) {
+        pathfinder.onTileChanged(x, y);
+      });
+
+  auto field = pathfinder.getFlowField({0, 0}, kLayer, true);
+  REQUIRE(pathfinder.getFlowField({0, 0}, kLayer, true) == field);
+  REQUIRE_FALSE(field->reachable(6, 1));
+
+  SECTION("Edits beyond the field's reach keep it cached") {
+    map->setTileId(7, 1, kLayer, 5);
+    REQUIRE_FALSE(field->isStale());
+    REQUIRE(pathfinder.getFlowField({0, 0}, kLayer, true) == field);
+  }
+
+  SECTION("A cost change inside the field makes it stale") {
+    map->setTileId(2, 1, kLayer, 5);
+    REQUIRE(field->isStale());
+    auto rebuilt = pathfinder.getFlowField({0, 0}, kLayer, true);
+    REQUIRE(rebuilt != field);
+    REQUIRE_FALSE(rebuilt->isStale());
+    for (int x = 0; x < 4; ++x) {
+      REQUIRE(rebuilt->distance(x, 2) ==
+              Catch::Approx(ReferenceCost(*map, {x, 2}, {0, 0}, true))
+                  .epsilon(1e-4));
+    }
+  }
+
+  SECTION("Opening a wall next to the field makes it stale") {
+    map->setTileId(4, 1, kLayer, 0);
+    REQUIRE(field->isStale());
+    auto rebuilt = pathfinder.getFlowField({0, 0}, kLayer, true);
+    REQUIRE(rebuilt->reachable(6, 1));
+  }
+
+  SECTION("Fields for other goals are dropped independently") {
+    auto other = pathfinder.getFlowField({6, 1}, kLayer, true);
+    map->setTileId(3, 2, kLayer, kWall);
+    REQUIRE(field->isStale());
+    REQUIRE_FALSE(other->isStale());
+    REQUIRE(pathfinder.getFlowField({6, 1}, kLayer, true) == other);
+  }
+}
+
+TEST_CASE("Path cache hits, evicts and invalidates", "[pathfinding][cache]") {
+  auto map = MapFromRows({
+      "..........",
+      "..........",
+      "..........",
+      "..........",
+  });
+  Pathfinder pathfinder(*map);
+  map->addTileChangedListener(
+      [&](int x, int y, const std::string &, int, int) {
+        pathfinder.onTileChanged(x, y);
+      });
+  auto stats = [&] { return pathfinder.getPathCacheStats(); };
+
+  SECTION("Repeated requests hit; any key field misses") {
+    auto request = Request({0, 0}, {9, 0}, false);
+    auto first = pathfinder.findPath(request);
+    REQUIRE_FALSE(first.cached);
+    auto second = pathfinder.findPath(request);
+    REQUIRE(second.cached);
+    REQUIRE(second.nodesExpanded == 0);
+    REQUIRE(second.path == first.path);
+    REQUIRE(stats().hits == 1);
+    REQUIRE(stats().misses == 1);
+    REQUIRE(stats().size == 1);
+
+    // Diagonal, smoothing and a tighter step budget are separate entries
+    pathfinder.findPath(Request({0, 0}, {9, 0}, true));
+    auto smooth = request;
+    smooth.smoothPath = true;
+    pathfinder.findPath(smooth);
+    auto limited = request;
+    limited.maxSteps = 3;
+    auto tight = pathfinder.findPath(limited);
+    REQUIRE_FALSE(tight.cached);
+    REQUIRE_FALSE(tight.found); // Not the cached unlimited path
+    REQUIRE(stats().misses == 4);
+    REQUIRE(stats().size == 3); // Partial results are not cached
+
+    pathfinder.resetPathCacheStats();
+    REQUIRE(stats().hits == 0);
+    REQUIRE(stats().size == 3);
+  }
+
+  SECTION("Least recently used paths are evicted first") {
+    pathfinder.setPathCacheCapacity(2);
+    auto a = Request({0, 0}, {9, 0}, false);
+    auto b = Request({0, 1}, {9, 1}, false);
+    auto c = Request({0, 2}, {9, 2}, false);
+    pathfinder.findPath(a);
+    pathfinder.findPath(b);
+    pathfinder.findPath(a); // b is now least recently used
+    pathfinder.findPath(c);
+    REQUIRE(stats().size == 2);
+    REQUIRE(stats().capacity == 2);
+    REQUIRE(pathfinder.findPath(a).cached);
+    REQUIRE(pathfinder.findPath(c).cached);
+    REQUIRE_FALSE(pathfinder.findPath(b).cached);
+
+    pathfinder.setPathCacheCapacity(1);
+    REQUIRE(stats().size == 1);
+    REQUIRE(pathfinder.findPath(b).cached);
+  }
+
+  SECTION("A tile change drops only the paths that touch it") {
+    auto top = Request({0, 0}, {9, 0}, false);
+    auto bottom = Request({0, 3}, {9, 3}, false);
+    pathfinder.findPath(top);
+    pathfinder.findPath(bottom);
+
+    map->setTileId(5, 0, kLayer, kWall);
+    REQUIRE(stats().invalidated == 1);
+    REQUIRE(stats().size == 1);
+    REQUIRE(pathfinder.findPath(bottom).cached);
+    auto detour = pathfinder.findPath(top);
+    REQUIRE_FALSE(detour.cached);
+    REQUIRE(detour.found);
+    REQUIRE(WalkCost(*map, detour.path, false) == Catch::Approx(11.0f));
+
+    // Walling and reopening a tile drops its path once; the detour,
+    // which keeps off that tile, stays cached
+    map->setTileId(2, 3, kLayer, kWall);
+    map->setTileId(2, 3, kLayer, 0);
+    REQUIRE(stats().invalidated == 2);
+    REQUIRE(stats().size == 1);
+    REQUIRE(pathfinder.findPath(top).cached);
+  }
+}
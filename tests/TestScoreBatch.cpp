@@ -0,0 +1,61 @@
+#include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/ScoringEngine.h"
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace gameplay;
+
+TEST_CASE("Card byte packing", "[card]") {
+  for (int suit = 0; suit < 4; ++suit) {
+    for (int rank = 1; rank <= 13; ++rank) {
+      Card card(static_cast<Card::Rank>(rank), static_cast<Card::Suit>(suit));
+      REQUIRE(card.toByte() == rank + 16 * suit);
+      REQUIRE(Card::fromByte(card.toByte()) == card);
+    }
+  }
+
+  REQUIRE_THROWS(Card::fromByte(0));    // Rank 0
+  REQUIRE_THROWS(Card::fromByte(14));   // Rank 14
+  REQUIRE_THROWS(Card::fromByte(0x41)); // Suit 4
+}
+
+TEST_CASE("ScoringEngine::ScoreBatch", "[cribbage][scoring]") {
+  EffectFactory::registerBuiltInEffects();
+
+  // 200 random hands, 5 cards each (4 hand + cut)
+  Deck deck(42);
+  std::vector<Card> cards;
+  for (int i = 0; i < 200; ++i) {
+    deck.reset();
+    deck.shuffle();
+    for (const Card &card : deck.drawMultiple(5)) {
+      cards.push_back(card);
+    }
+  }
+
+  std::vector<std::string> rules = {"flush_disabled", "warp_mirror"};
+  std::vector<ScoringEngine::ScoreResult> results(cards.size() / 5);
+
+  SECTION("Matches per-hand CalculateScore") {
+    ScoringEngine::ScoreBatch(cards, 1.5f, 0.5f, rules, results);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      std::span<const Card> hand(cards.data() + i * 5, 4);
+      auto expected =
+          ScoringEngine::CalculateScore(hand, cards[i * 5 + 4], 1.5f, 0.5f,
+                                        rules);
+      REQUIRE(results[i].baseChips == expected.baseChips);
+      REQUIRE(results[i].finalScore == expected.finalScore);
+    }
+  }
+
+  SECTION("Rejects partial hands and short output") {
+    std::span<const Card> partial(cards.data(), 7);
+    REQUIRE_THROWS(
+        ScoringEngine::ScoreBatch(partial, 0.0f, 0.0f, rules, results));
+
+    std::span<ScoringEngine::ScoreResult> shortOut(results.data(), 10);
+    REQUIRE_THROWS(
+        ScoringEngine::ScoreBatch(cards, 0.0f, 0.0f, rules, shortOut));
+  }
+}
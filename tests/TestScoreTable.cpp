@@ -0,0 +1,114 @@
+#include "gameplay/card/Deck.h"
+#include "gameplay/cribbage/HandEvaluator.h"
+#include "gameplay/cribbage/ScoreTable.h"
+#include "gameplay/cribbage/ScoringEngine.h"
+#include "gameplay/cribbage/effects/EffectFactory.h"
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+
+using namespace gameplay;
+
+static bool SameCounts(const HandEvaluator::HandCounts &a,
+                       const HandEvaluator::HandCounts &b) {
+  return a.fifteens == b.fifteens && a.pairs == b.pairs && a.runs == b.runs &&
+         a.runLength == b.runLength && a.flushCount == b.flushCount &&
+         a.hasNobs == b.hasNobs;
+}
+
+TEST_CASE("ScoreTable matches HandEvaluator", "[cribbage][scoretable]") {
+  SECTION("Every entry verified across suit patterns") {
+    // Suit patterns for (hand0..hand3, cut): flush 5, flush 4, mixed with
+    // each possible cut suit (covers nobs for any Jack position)
+    const int patterns[][5] = {{0, 0, 0, 0, 0}, {0, 0, 0, 0, 3},
+                               {0, 1, 2, 3, 0}, {0, 1, 2, 3, 1},
+                               {0, 1, 2, 3, 2}, {0, 1, 2, 3, 3}};
+
+    std::set<int> seenIndices;
+    for (int a = 1; a <= 13; ++a)
+      for (int b = a; b <= 13; ++b)
+        for (int c = b; c <= 13; ++c)
+          for (int d = c; d <= 13; ++d)
+            for (int e = d; e <= 13; ++e) {
+              std::array<uint8_t, 5> ranks = {
+                  static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                  static_cast<uint8_t>(c), static_cast<uint8_t>(d),
+                  static_cast<uint8_t>(e)};
+              int index = ScoreTable::Index(ranks);
+              REQUIRE(index >= 0);
+              REQUIRE(index < ScoreTable::kEntryCount);
+              seenIndices.insert(index);
+
+              for (const auto &suits : patterns) {
+                std::vector<Card> hand;
+                for (int i = 0; i < 4; ++i) {
+                  hand.emplace_back(static_cast<Card::Rank>(ranks[i]),
+                                    static_cast<Card::Suit>(suits[i]));
+                }
+                Card cut(static_cast<Card::Rank>(ranks[4]),
+                         static_cast<Card::Suit>(suits[4]));
+
+                auto expected =
+                    HandEvaluator::Count(HandEvaluator::Evaluate(hand, cut));
+                REQUIRE(SameCounts(ScoreTable::Lookup(hand, cut), expected));
+
+                // Cut position must not matter for rank-only counts
+                std::swap(hand[0], cut);
+                auto swapped = ScoreTable::Lookup(hand, cut);
+                REQUIRE(swapped.fifteens == expected.fifteens);
+                REQUIRE(swapped.pairs == expected.pairs);
+                REQUIRE(swapped.runs == expected.runs);
+                REQUIRE(swapped.runLength == expected.runLength);
+              }
+            }
+
+    REQUIRE(seenIndices.size() == ScoreTable::kEntryCount);
+  }
+
+  SECTION("Table-backed scoring matches HandResult scoring") {
+    EffectFactory::registerBuiltInEffects();
+
+    const std::vector<std::vector<std::string>> ruleSets = {
+        {},
+        {"fifteens_disabled"},
+        {"only_pairs_runs"},
+        {"multipliers_disabled"},
+        {"warp_blaze"},
+        {"warp_mirror"},
+        {"warp_inversion"},
+        {"warp_wildfire"}};
+
+    Deck deck(777);
+    for (int i = 0; i < 500; ++i) {
+      deck.reset();
+      deck.shuffle();
+      std::vector<Card> hand = deck.drawMultiple(4);
+      Card cut = deck.draw();
+      auto handResult = HandEvaluator::Evaluate(hand, cut);
+
+      for (const auto &rules : ruleSets) {
+        auto expected =
+            ScoringEngine::CalculateScore(handResult, 1.5f, 0.5f, rules);
+        auto actual =
+            ScoringEngine::CalculateScore(hand, cut, 1.5f, 0.5f, rules);
+        REQUIRE(actual.baseChips == expected.baseChips);
+        REQUIRE(actual.finalScore == expected.finalScore);
+      }
+    }
+  }
+
+  SECTION("Hands over 4 cards score through HandEvaluator") {
+    Deck deck(4242);
+    for (int i = 0; i < 200; ++i) {
+      deck.reset();
+      deck.shuffle();
+      std::vector<Card> hand = deck.drawMultiple(5);
+      Card cut = deck.draw();
+
+      auto expected =
+          ScoringEngine::CalculateScore(HandEvaluator::Evaluate(hand, cut));
+      auto actual = ScoringEngine::CalculateScore(hand, cut);
+      REQUIRE(actual.baseChips == expected.baseChips);
+      REQUIRE(actual.finalScore == expected.finalScore);
+    }
+  }
+}
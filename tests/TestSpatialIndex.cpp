@@ -0,0 +1,387 @@
+#include "core/SpatialIndex.h"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+Rect RandomBounds(std::mt19937 &rng) {
+  std::uniform_real_distribution<float> pos(-50.0f, 1050.0f);
+  std::uniform_real_distribution<float> size(0.0f, 40.0f);
+  // Every fourth object is a point
+  bool point = rng() % 4 == 0;
+  return Rect(pos(rng), pos(rng), point ? 0.0f : size(rng),
+              point ? 0.0f : size(rng));
+}
+
+} // namespace
+
+TEST_CASE("PooledQuadtree matches Quadtree", "[core][spatial]") {
+  const Rect world(0, 0, 1000, 1000);
+  Quadtree reference(world, 4, 6);
+  PooledQuadtree pooled(world, 4, 6);
+  std::mt19937 rng(42);
+
+  const int objectCount = 2000;
+  std::unordered_map<int, Rect> initial;
+  for (int id = 0; id < objectCount; ++id) {
+    Rect bounds = RandomBounds(rng);
+    reference.insert(id, bounds);
+    pooled.insert(id, bounds);
+    initial[id] = bounds;
+  }
+
+  std::unordered_map<int, Rect> live = initial;
+
+  // Move (small steps and jumps), remove and re-insert a share of the
+  // objects
+  for (int step = 0; step < 3000; ++step) {
+    int id = static_cast<int>(rng() % objectCount);
+    Rect bounds = RandomBounds(rng);
+    if (step % 2 == 0 && live.count(id)) {
+      bounds = live[id];
+      bounds.x += static_cast<float>(rng() % 9) - 4.0f;
+      bounds.y += static_cast<float>(rng() % 9) - 4.0f;
+    }
+    if (step % 5 == 0) {
+      reference.remove(id);
+      pooled.remove(id);
+      live.erase(id);
+    } else {
+      reference.update(id, bounds);
+      pooled.update(id, bounds);
+      live[id] = bounds;
+    }
+  }
+  REQUIRE(pooled.size() == reference.size());
+  REQUIRE(pooled.size() == static_cast<int>(live.size()));
+
+  std::vector<int> expected;
+  std::vector<int> actual;
+  for (int i = 0; i < 200; ++i) {
+    Rect area = RandomBounds(rng);
+    area.w *= 5.0f;
+    area.h *= 5.0f;
+    reference.query(area, expected);
+    pooled.query(area, actual);
+    REQUIRE(actual == expected);
+
+    // Same set as a brute-force scan (objects outside the root are only
+    // found by queries that touch the root)
+    std::vector<int> brute;
+    for (const auto &[id, bounds] : live) {
+      if (bounds.intersects(area) && area.intersects(world)) {
+        brute.push_back(id);
+      }
+    }
+    std::sort(brute.begin(), brute.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(expected == brute);
+
+    float radius = area.w + 1.0f;
+    reference.queryRadius(area.x, area.y, radius, expected);
+    pooled.queryRadius(area.x, area.y, radius, actual);
+    REQUIRE(actual == expected);
+
+    REQUIRE(pooled.queryNearest(area.x, area.y, radius) ==
+            reference.queryNearest(area.x, area.y, radius));
+  }
+
+  Quadtree::Stats referenceStats = reference.getStats();
+  Quadtree::Stats pooledStats = pooled.getStats();
+  REQUIRE(pooledStats.nodeCount == referenceStats.nodeCount);
+  REQUIRE(pooledStats.maxDepth == referenceStats.maxDepth);
+  REQUIRE(pooledStats.objectsPerLevel == referenceStats.objectsPerLevel);
+}
+
+TEST_CASE("PooledQuadtree insert of an existing id moves it",
+          "[core][spatial]") {
+  PooledQuadtree tree(Rect(0, 0, 100, 100), 2, 4);
+  tree.insertPoint(7, 10, 10);
+  tree.insertPoint(7, 90, 90);
+  REQUIRE(tree.size() == 1);
+
+  std::vector<int> results;
+  tree.query(Rect(0, 0, 50, 50), results);
+  REQUIRE(results.empty());
+  tree.query(Rect(50, 50, 50, 50), results);
+  REQUIRE(results == std::vector<int>{7});
+
+  tree.clear();
+  REQUIRE(tree.size() == 0);
+  REQUIRE(tree.getStats().nodeCount == 1);
+  REQUIRE(tree.queryNearest(90, 90) == -1);
+}
+
+TEST_CASE("Quadtree collapses emptied subtrees lazily", "[core][spatial]") {
+  Quadtree tree(Rect(0, 0, 100, 100), 2, 4);
+  PooledQuadtree pooled(Rect(0, 0, 100, 100), 2, 4);
+  std::vector<int> ids;
+  std::vector<Rect> corner;
+  std::vector<Rect> centered;
+  for (int id = 0; id < 8; ++id) {
+    ids.push_back(id);
+    corner.emplace_back(1.0f + id, 1.0f + id, 0.0f, 0.0f);
+    centered.emplace_back(40.0f + id, 40.0f + id, 15.0f, 15.0f);
+  }
+
+  tree.updateBatch(ids, corner);
+  pooled.updateBatch(ids, corner);
+  int deep = tree.getStats().nodeCount;
+  REQUIRE(deep > 5);
+  REQUIRE(pooled.getStats().nodeCount == deep);
+
+  // Small moves inside the same leaf keep the structure
+  std::vector<Rect> nudged = corner;
+  for (Rect &bounds : nudged) {
+    bounds.x += 0.25f;
+  }
+  tree.updateBatch(ids, nudged);
+  REQUIRE(tree.getStats().nodeCount == deep);
+
+  // Growing across the center moves everything to the root; the emptied
+  // subtrees collapse all the way up
+  tree.updateBatch(ids, centered);
+  pooled.updateBatch(ids, centered);
+  REQUIRE(tree.getStats().nodeCount == 1);
+  REQUIRE(pooled.getStats().nodeCount == 1);
+
+  std::vector<int> results;
+  tree.query(Rect(0, 0, 100, 100), results);
+  REQUIRE(results.size() == ids.size());
+  pooled.query(Rect(0, 0, 12, 12), results);
+  REQUIRE(results.empty());
+
+  REQUIRE_THROWS_AS(tree.updateBatch(ids, {}), std::invalid_argument);
+  REQUIRE_THROWS_AS(pooled.updateBatch({1}, {}), std::invalid_argument);
+}
+
+TEST_CASE("Quadtree shrinks back to its root when emptied",
+          "[core][spatial]") {
+  Quadtree tree(Rect(0, 0, 1000, 1000), 4, 5);
+  PooledQuadtree pooled(Rect(0, 0, 1000, 1000), 4, 5);
+  std::vector<int> results;
+
+  SECTION("Inner node whose objects all straddle its center") {
+    // The root splits, but every object stays on it: four empty children
+    for (int id = 0; id < 5; ++id) {
+      Rect bounds(450.0f + id, 450.0f, 100.0f, 100.0f);
+      tree.insert(id, bounds);
+      pooled.insert(id, bounds);
+    }
+    REQUIRE(tree.getStats().nodeCount == 5);
+    REQUIRE(pooled.getStats().nodeCount == 5);
+    for (int id = 0; id < 5; ++id) {
+      tree.remove(id);
+      pooled.remove(id);
+    }
+  }
+
+  SECTION("Random objects, removed in random order") {
+    std::mt19937 rng(11);
+    std::vector<int> ids;
+    for (int id = 0; id < 300; ++id) {
+      Rect bounds = RandomBounds(rng);
+      tree.insert(id, bounds);
+      pooled.insert(id, bounds);
+      ids.push_back(id);
+    }
+    REQUIRE(pooled.getStats().nodeCount > 1);
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (int id : ids) {
+      tree.remove(id);
+      pooled.remove(id);
+    }
+  }
+
+  // Collapsed lazily, by the next query
+  tree.query(Rect(0, 0, 1000, 1000), results);
+  REQUIRE(results.empty());
+  pooled.query(Rect(0, 0, 1000, 1000), results);
+  REQUIRE(results.empty());
+  REQUIRE(tree.getStats().nodeCount == 1);
+  REQUIRE(pooled.getStats().nodeCount == 1);
+}
+
+namespace {
+
+float DistanceSq(const Rect &bounds, float x, float y) {
+  float dx = x - std::max(bounds.x, std::min(x, bounds.x + bounds.w));
+  float dy = y - std::max(bounds.y, std::min(y, bounds.y + bounds.h));
+  return dx * dx + dy * dy;
+}
+
+// Compare a grid against a brute-force scan of the live objects
+void CheckGrid(const SpatialHashGrid &grid,
+               const std::unordered_map<int, Rect> &live, std::mt19937 &rng) {
+  REQUIRE(grid.size() == static_cast<int>(live.size()));
+  std::vector<int> actual;
+  for (int i = 0; i < 200; ++i) {
+    Rect area = RandomBounds(rng);
+    area.w *= 5.0f;
+    area.h *= 5.0f;
+    float radius = area.w + 1.0f;
+
+    std::vector<int> inArea;
+    std::vector<int> inRadius;
+    float nearestSq = radius * radius;
+    for (const auto &[id, bounds] : live) {
+      if (bounds.intersects(area)) {
+        inArea.push_back(id);
+      }
+      float distSq = DistanceSq(bounds, area.x, area.y);
+      if (distSq <= radius * radius) {
+        inRadius.push_back(id);
+      }
+      nearestSq = std::min(nearestSq, distSq);
+    }
+    std::sort(inArea.begin(), inArea.end());
+    std::sort(inRadius.begin(), inRadius.end());
+
+    grid.query(area, actual);
+    std::sort(actual.begin(), actual.end());
+    REQUIRE(actual == inArea);
+
+    grid.queryRadius(area.x, area.y, radius, actual);
+    std::sort(actual.begin(), actual.end());
+    REQUIRE(actual == inRadius);
+
+    // Ties may resolve to a different object, so compare distances
+    int nearest = grid.queryNearest(area.x, area.y, radius);
+    if (nearestSq < radius * radius) {
+      REQUIRE(nearest != -1);
+      REQUIRE(DistanceSq(live.at(nearest), area.x, area.y) == nearestSq);
+    } else {
+      REQUIRE(nearest == -1);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("SpatialHashGrid matches a brute-force scan", "[core][spatial]") {
+  SpatialHashGrid grid(Rect(0, 0, 1000, 1000), 32.0f);
+  std::mt19937 rng(7);
+
+  const int objectCount = 2000;
+  std::unordered_map<int, Rect> live;
+  for (int id = 0; id < objectCount; ++id) {
+    live[id] = RandomBounds(rng);
+    grid.insert(id, live[id]);
+  }
+  CheckGrid(grid, live, rng);
+
+  for (int step = 0; step < 3000; ++step) {
+    int id = static_cast<int>(rng() % objectCount);
+    Rect bounds = RandomBounds(rng);
+    if (step % 2 == 0 && live.count(id)) {
+      bounds = live[id];
+      bounds.x += static_cast<float>(rng() % 9) - 4.0f;
+      bounds.y += static_cast<float>(rng() % 9) - 4.0f;
+    }
+    if (step % 5 == 0) {
+      grid.remove(id);
+      live.erase(id);
+    } else {
+      grid.update(id, bounds);
+      live[id] = bounds;
+    }
+  }
+  CheckGrid(grid, live, rng);
+
+  SpatialHashGrid::Stats stats = grid.getStats();
+  REQUIRE(stats.cellCount == 32 * 32);
+  REQUIRE(stats.totalObjects == static_cast<int>(live.size()));
+  REQUIRE(stats.occupiedCells > 0);
+}
+
+TEST_CASE("SpatialHashGrid rebuilds from position arrays",
+          "[core][spatial]") {
+  SpatialHashGrid grid(Rect(0, 0, 1000, 1000), 50.0f);
+  std::mt19937 rng(11);
+  grid.insertPoint(99999, 5, 5); // Replaced by the rebuild
+
+  std::vector<float> xs, ys, ws, hs;
+  std::vector<int> ids;
+  std::unordered_map<int, Rect> live;
+  for (int i = 0; i < 1000; ++i) {
+    Rect bounds = RandomBounds(rng);
+    xs.push_back(bounds.x);
+    ys.push_back(bounds.y);
+    ws.push_back(bounds.w);
+    hs.push_back(bounds.h);
+    ids.push_back(i * 3);
+    live[i * 3] = bounds;
+  }
+  grid.rebuild(ids.size(), xs.data(), ys.data(), ws.data(), hs.data(),
+               ids.data());
+  CheckGrid(grid, live, rng);
+
+  // Per-object edits after a rebuild
+  for (int id = 0; id < 300; id += 3) {
+    grid.remove(id);
+    live.erase(id);
+  }
+  grid.update(3000, Rect(500, 500, 60, 60));
+  live[3000] = Rect(500, 500, 60, 60);
+  grid.insertPoint(3003, 10, 990);
+  live[3003] = Rect(10, 990, 0, 0);
+  CheckGrid(grid, live, rng);
+
+  // Points with implicit ids
+  grid.rebuild(xs.size(), xs.data(), ys.data());
+  live.clear();
+  for (size_t i = 0; i < xs.size(); ++i) {
+    live[static_cast<int>(i)] = Rect(xs[i], ys[i], 0, 0);
+  }
+  CheckGrid(grid, live, rng);
+
+  grid.clear();
+  REQUIRE(grid.size() == 0);
+  REQUIRE(grid.queryNearest(500, 500) == -1);
+
+  REQUIRE_THROWS_AS(SpatialHashGrid(Rect(0, 0, 10, 10), 0.0f),
+                    std::invalid_argument);
+  REQUIRE_THROWS_AS(grid.updateBatch({1, 2}, {}), std::invalid_argument);
+}
+
+TEST_CASE("Rebuilding with repeated ids keeps each id's last position",
+          "[core][spatial]") {
+  // spatial.rebuild's two backends: a grid rebuild, or point inserts
+  SpatialHashGrid grid(Rect(0, 0, 1000, 1000), 50.0f);
+  PooledQuadtree pooled(Rect(0, 0, 1000, 1000), 4, 5);
+  std::vector<float> xs = {10, 500, 900, 20, 510, 300};
+  std::vector<float> ys = {10, 500, 900, 20, 510, 300};
+  std::vector<int> ids = {1, 2, 3, 1, 2, 1};
+  grid.rebuild(ids.size(), xs.data(), ys.data(), nullptr, nullptr,
+               ids.data());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    pooled.insertPoint(ids[i], xs[i], ys[i]);
+  }
+
+  std::vector<int> results;
+  REQUIRE(grid.size() == 3);
+  REQUIRE(pooled.size() == 3);
+  grid.query(Rect(0, 0, 1000, 1000), results);
+  std::sort(results.begin(), results.end());
+  REQUIRE(results == std::vector<int>{1, 2, 3});
+  grid.query(Rect(0, 0, 100, 100), results);
+  REQUIRE(results.empty()); // 1 moved on to (300, 300)
+  pooled.query(Rect(0, 0, 100, 100), results);
+  REQUIRE(results.empty());
+  REQUIRE(grid.queryNearest(505, 505, 20) == 2);
+  REQUIRE(pooled.queryNearest(505, 505, 20) == 2);
+
+  // One remove clears an id completely
+  grid.remove(1);
+  pooled.remove(1);
+  grid.query(Rect(0, 0, 1000, 1000), results);
+  REQUIRE(results.size() == 2);
+  pooled.query(Rect(0, 0, 1000, 1000), results);
+  REQUIRE(results.size() == 2);
+  REQUIRE(grid.queryNearest(300, 300, 50) == -1);
+  REQUIRE(pooled.queryNearest(300, 300, 50) == -1);
+}
@@ -0,0 +1,140 @@
+#include "graphics/SpriteBatch.h"
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+namespace {
+
+/// Records how the batch maps the buffer
+class RecordingBuffer : public SpriteBatch::UploadBuffer {
+public:
+  explicit RecordingBuffer(int capacity) : memory(capacity) {}
+
+  Vertex *map(bool cycle) override {
+    REQUIRE_FALSE(mapped);
+    mapped = true;
+    cycles.push_back(cycle);
+    return memory.data();
+  }
+  void unmap() override {
+    REQUIRE(mapped);
+    mapped = false;
+  }
+
+  std::vector<Vertex> memory;
+  std::vector<bool> cycles;
+  bool mapped = false;
+};
+
+SpriteCommand Sprite(int textureId, float x, float y, bool screenSpace) {
+  SpriteCommand cmd{};
+  cmd.textureId = textureId;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.w = 10.0f;
+  cmd.h = 20.0f;
+  cmd.sw = cmd.sh = 1.0f;
+  cmd.screenSpace = screenSpace;
+  cmd.tint = Color(0.5f, 0.25f, 1.0f, 1.0f);
+  return cmd;
+}
+
+} // namespace
+
+TEST_CASE("SpriteBatch writes quads and texture batches",
+          "[graphics][sprites]") {
+  RecordingBuffer buffer(40);
+  SpriteBatch batch(buffer, 40);
+
+  SpriteBatch::View view;
+  view.cameraX = 100.0f;
+  view.zoom = 2.0f;
+  batch.beginFrame();
+  batch.beginSegment(3, view);
+  batch.add(Sprite(1, 110.0f, 5.0f, false));
+  batch.add(Sprite(1, 0.0f, 0.0f, true));
+  batch.add(Sprite(2, 0.0f, 0.0f, true));
+  batch.endSegment();
+
+  REQUIRE(batch.segmentStart() == 0);
+  REQUIRE(batch.segmentSize() == 12);
+  REQUIRE(batch.batches().size() == 2);
+  REQUIRE(batch.batches()[0].vertexCount == 8);
+  REQUIRE(batch.batches()[0].indexCount() == 12);
+  REQUIRE(batch.batches()[1].textureId == 2);
+  REQUIRE(batch.batches()[1].startVertex == 8);
+
+  // World sprite: camera offset, then zoom. First vertex is bottom-left.
+  const Vertex &bottomLeft = buffer.memory[0];
+  REQUIRE(bottomLeft.x == Catch::Approx(20.0f));
+  REQUIRE(bottomLeft.y == Catch::Approx(50.0f));
+  REQUIRE(bottomLeft.u == 0);
+  REQUIRE(bottomLeft.v == 65535);
+  REQUIRE(bottomLeft.r == 128);
+  REQUIRE(bottomLeft.g == 64);
+  REQUIRE(bottomLeft.a == 255);
+  // Screen-space sprite ignores the view
+  const Vertex &topRight = buffer.memory[6];
+  REQUIRE(topRight.x == Catch::Approx(10.0f));
+  REQUIRE(topRight.y == Catch::Approx(0.0f));
+}
+
+TEST_CASE("SpriteBatch appends segments and wraps when full",
+          "[graphics][sprites]") {
+  RecordingBuffer buffer(40); // 10 sprites
+  SpriteBatch batch(buffer, 40);
+  SpriteBatch::View view;
+
+  auto segment = [&](int sprites) {
+    batch.beginSegment(sprites, view);
+    for (int i = 0; i < sprites; ++i) {
+      batch.add(Sprite(1, 0.0f, 0.0f, false));
+    }
+    batch.endSegment();
+  };
+
+  batch.beginFrame();
+  segment(4);
+  REQUIRE(batch.segmentCycled());
+  segment(5); // Appended: the first segment is left for the GPU
+  REQUIRE(batch.segmentStart() == 16);
+  REQUIRE_FALSE(batch.segmentCycled());
+  REQUIRE(batch.batches()[0].startVertex == 16);
+  segment(3); // Does not fit after: wraps and cycles
+  REQUIRE(batch.segmentStart() == 0);
+  REQUIRE(batch.segmentSize() == 12);
+  REQUIRE(buffer.cycles == std::vector<bool>{true, false, true});
+
+  // Empty segments do not map; oversized ones are cut at the capacity
+  segment(0);
+  REQUIRE(buffer.cycles.size() == 3);
+  batch.beginFrame();
+  segment(12);
+  REQUIRE(batch.segmentSize() == 40);
+  REQUIRE(buffer.cycles.back());
+}
+
+TEST_CASE("SpriteBatch keeps batches within 16-bit indices",
+          "[graphics][sprites]") {
+  std::vector<uint16_t> indices(SpriteBatch::kMaxBatchSprites *
+                                SpriteBatch::kIndicesPerSprite);
+  SpriteBatch::FillQuadIndices(indices.data());
+  REQUIRE(indices[6] == 4);
+  REQUIRE(indices[11] == 7);
+  REQUIRE(indices.back() == 65535);
+
+  constexpr int kSprites = SpriteBatch::kMaxBatchSprites + 1;
+  RecordingBuffer buffer(kSprites * SpriteBatch::kVerticesPerSprite);
+  SpriteBatch batch(buffer, kSprites * SpriteBatch::kVerticesPerSprite);
+  batch.beginSegment(kSprites, SpriteBatch::View());
+  for (int i = 0; i < kSprites; ++i) {
+    batch.add(Sprite(1, 0.0f, 0.0f, true));
+  }
+  batch.endSegment();
+
+  // One texture, but the last sprite needs a second draw
+  REQUIRE(batch.batches().size() == 2);
+  REQUIRE(batch.batches()[0].indexCount() == static_cast<int>(indices.size()));
+  REQUIRE(batch.batches()[1].startVertex == 65536);
+  REQUIRE(batch.batches()[1].vertexCount == 4);
+}
@@ -0,0 +1,35 @@
+#include "core/WorkerPool.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("WorkerPool runs every queued job", "[core][parallel]") {
+  for (int threads : {1, 3}) {
+    WorkerPool pool(threads);
+    REQUIRE(pool.size() == threads);
+
+    // Catch2 assertions are not thread-safe: only count inside jobs
+    std::vector<std::atomic<int>> runs(500);
+    for (auto &count : runs) {
+      pool.submit([&count] { count.fetch_add(1); });
+    }
+    pool.wait();
+    for (const auto &count : runs) {
+      REQUIRE(count.load() == 1);
+    }
+  }
+}
+
+TEST_CASE("WorkerPool survives throwing jobs", "[core][parallel]") {
+  WorkerPool pool(2);
+  std::atomic<int> after{0};
+  pool.submit([] { throw std::runtime_error("job failed"); });
+  pool.submit([&after] { after.fetch_add(1); });
+  pool.wait();
+  REQUIRE(after.load() == 1);
+
+  // Default size leaves a core for the caller but is never zero
+  WorkerPool automatic;
+  REQUIRE(automatic.size() >= 1);
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * In-memory stand-in for src/tilemap/TileMap.h, found first on the test
+ * target's include path. The real TileMap links the renderer, physics and
+ * (through TileSet) the engine; Pathfinder only reads tile ids and tile
+ * properties, which this keeps in plain tables with the same lookup rules.
+ */
+class TileMap {
+public:
+  TileMap(int width, int height) : m_Width(width), m_Height(height) {}
+
+  TileMap(const TileMap &) = delete;
+  TileMap &operator=(const TileMap &) = delete;
+
+  int getWidth() const { return m_Width; }
+  int getHeight() const { return m_Height; }
+
+  /**
+   * Get tile ID at position on a layer (0 = empty or no such layer)
+   */
+  int getTileId(int x, int y, const std::string &layerName) const {
+    auto it = m_Layers.find(layerName);
+    if (it == m_Layers.end() || !inBounds(x, y)) {
+      return 0;
+    }
+    return it->second[static_cast<size_t>(y) * m_Width + x];
+  }
+
+  /**
+   * Set tile ID at position, creating the layer on first use
+   */
+  void setTileId(int x, int y, const std::string &layerName, int tileId) {
+    if (!inBounds(x, y)) {
+      return;
+    }
+    auto &tiles = m_Layers[layerName];
+    tiles.resize(static_cast<size_t>(m_Width) * m_Height, 0);
+    int &tile = tiles[static_cast<size_t>(y) * m_Width + x];
+    int oldTile = tile;
+    tile = tileId;
+
+    if (oldTile == tileId) {
+      return;
+    }
+    if (m_OnTileChanged) {
+      m_OnTileChanged(x, y, layerName, oldTile, tileId);
+    }
+    for (const auto &[id, listener] : m_TileListeners) {
+      listener(x, y, layerName, oldTile, tileId);
+    }
+  }
+
+  /**
+   * Property of the first non-empty tile at a position that defines it,
+   * searching every layer (as the tileset lookup does)
+   */
+  std::string getProperty(int x, int y,
+                          const std::string &propertyName) const {
+    for (const auto &[name, tiles] : m_Layers) {
+      int tileId = getTileId(x, y, name);
+      if (tileId == 0) {
+        continue;
+      }
+      auto tile = m_TileProperties.find(tileId);
+      if (tile == m_TileProperties.end()) {
+        continue;
+      }
+      auto property = tile->second.find(propertyName);
+      if (property != tile->second.end()) {
+        return property->second;
+      }
+    }
+    return "";
+  }
+
+  /**
+   * Define a property for every tile with this ID (the tileset's job)
+   */
+  void setTileProperty(int tileId, const std::string &propertyName,
+                       const std::string &value) {
+    m_TileProperties[tileId][propertyName] = value;
+  }
+
+  using TileChangedCallback = std::function<void(
+      int x, int y, const std::string &layer, int oldTile, int newTile)>;
+
+  void setOnTileChanged(TileChangedCallback callback) {
+    m_OnTileChanged = std::move(callback);
+  }
+
+  int addTileChangedListener(TileChangedCallback callback) {
+    int id = m_NextListenerId++;
+    m_TileListeners.emplace_back(id, std::move(callback));
+    return id;
+  }
+
+  void removeTileChangedListener(int id) {
+    std::erase_if(m_TileListeners,
+                  [id](const auto &listener) { return listener.first == id; });
+  }
+
+private:
+  bool inBounds(int x, int y) const {
+    return x >= 0 && y >= 0 && x < m_Width && y < m_Height;
+  }
+
+  int m_Width;
+  int m_Height;
+  std::unordered_map<std::string, std::vector<int>> m_Layers;
+  std::unordered_map<int, std::unordered_map<std::string, std::string>>
+      m_TileProperties;
+  TileChangedCallback m_OnTileChanged;
+  std::vector<std::pair<int, TileChangedCallback>> m_TileListeners;
+  int m_NextListenerId = 1;
+};
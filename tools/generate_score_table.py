@@ -0,0 +1,79 @@
+"""Generate src/gameplay/cribbage/ScoreTableData.inc.
+
+Precomputes fifteen / pair / run counts for every 5-card rank multiset
+(C(17, 5) = 6188 entries), indexed by the combinatorial number system used
+in ScoreTable::Index. Re-run after changing cribbage pattern rules; the
+Catch2 test in tests/TestScoreTable.cpp verifies every entry against
+HandEvaluator.
+
+Usage: python3 tools/generate_score_table.py
+"""
+import os
+from itertools import combinations_with_replacement
+from math import comb
+
+OUTPUT = os.path.join(os.path.dirname(__file__), "..", "src", "gameplay",
+                      "cribbage", "ScoreTableData.inc")
+ENTRY_COUNT = comb(17, 5)
+PER_LINE = 6
+
+
+def table_index(sorted_ranks):
+    # c_i = rank_i - 1 + i is strictly increasing in [0, 17)
+    return sum(comb(rank - 1 + i, i + 1) for i, rank in enumerate(sorted_ranks))
+
+
+def evaluate(ranks):
+    values = [min(rank, 10) for rank in ranks]
+
+    fifteens = 0
+    for mask in range(1, 32):
+        if sum(v for i, v in enumerate(values) if mask & (1 << i)) == 15:
+            fifteens += 1
+
+    counts = [0] * 14
+    for rank in ranks:
+        counts[rank] += 1
+    pairs = sum(c * (c - 1) // 2 for c in counts)
+
+    best_start, best_length, length = 0, 0, 0
+    for rank in range(1, 14):
+        if counts[rank]:
+            length += 1
+            if length > best_length:
+                best_length, best_start = length, rank - length + 1
+        else:
+            length = 0
+
+    runs, run_length = 0, 0
+    if best_length >= 3:
+        runs = 1
+        for rank in range(best_start, best_start + best_length):
+            runs *= counts[rank]
+        run_length = best_length
+
+    return fifteens, pairs, runs, run_length
+
+
+def main():
+    table = [None] * ENTRY_COUNT
+    for ranks in combinations_with_replacement(range(1, 14), 5):
+        table[table_index(ranks)] = evaluate(ranks)
+    assert all(entry is not None for entry in table)
+
+    lines = [
+        "// Generated by tools/generate_score_table.py - do not edit.",
+        "// {fifteens, pairs, runs, runLength} per 5-card rank multiset,",
+        "// indexed by ScoreTable::Index.",
+    ]
+    for start in range(0, ENTRY_COUNT, PER_LINE):
+        chunk = table[start:start + PER_LINE]
+        lines.append(" ".join("{%d, %d, %d, %d}," % e for e in chunk))
+
+    with open(OUTPUT, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("Wrote %d entries to %s" % (ENTRY_COUNT, os.path.normpath(OUTPUT)))
+
+
+if __name__ == "__main__":
+    main()